@@ -0,0 +1,646 @@
+/**
+ * @file aleatorio.c
+ * @brief Implementation file for the counter-based random number generator (Philox4x32-10) and its batch fills.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/// including the files where the structures are contained
+#include "aleatorio.h"
+#include "paralelo.h"
+#include "teste.h"
+
+/*
+ * Philox4x32-10 constants (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", SC 2011):
+ * the two multipliers of the S-box and the Weyl increments of the key schedule.
+ */
+#define ALEATORIO_M0 0xD2511F53u
+#define ALEATORIO_M1 0xCD9E8D57u
+#define ALEATORIO_W0 0x9E3779B9u
+#define ALEATORIO_W1 0xBB67AE85u
+#define ALEATORIO_RODADAS 10
+
+//! Philox blocks per group, one per AVX lane
+#define ALEATORIO_LANES (ALEATORIO_GRUPO / 4)
+
+//! Weight of the 24 high bits of a word turned into a float in [0, 1)
+#define ALEATORIO_ESCALA (1.0f / 16777216.0f)
+
+#define ALEATORIO_DOIS_PI 6.28318530717958647692f
+
+/*!
+* @brief What a fill writes.
+*/
+typedef enum
+{
+    ALEATORIO_PALAVRAS,
+    ALEATORIO_UNIFORME,
+    ALEATORIO_GAUSSIANO
+} aleatorioTipo;
+
+/*!
+* @brief Arguments of a fill, shared by the ranges of groups run by the thread pool.
+*/
+typedef struct
+{
+    const aleatorioGerador *gerador;
+    uint64_t primeiro;   //!< First group of the fill
+    void *destino;       //!< n words or floats
+    long n;
+    aleatorioTipo tipo;
+    float a, b;          //!< minimo and maximo - minimo (uniform), desvio (Gaussian)
+} aleatorioContexto;
+
+/************************************* PHILOX ***************************************/
+
+#if defined(__AVX2__)
+
+/**
+ * @brief 32 x 32 -> 64-bit products of the 8 lanes of a by m: returns the high halves and writes the low ones.
+ */
+static inline __m256i aleatorioMulHiLo(__m256i a, __m256i m, __m256i *lo)
+{
+    const __m256i par = _mm256_mul_epu32(a, m);
+    const __m256i impar = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), m);
+
+    *lo = _mm256_blend_epi32(par, _mm256_slli_epi64(impar, 32), 0xAA);
+    return _mm256_blend_epi32(_mm256_srli_epi64(par, 32), impar, 0xAA);
+}
+
+/**
+ * @brief Writes the 32 words of a group: word i of lane l goes to palavras[i * 8 + l].
+ */
+static void aleatorioGrupoPalavras(const aleatorioGerador *gerador, uint64_t grupo, uint32_t *palavras)
+{
+    const uint64_t contador = grupo * ALEATORIO_LANES;
+    const __m256i m0 = _mm256_set1_epi32((int)ALEATORIO_M0);
+    const __m256i m1 = _mm256_set1_epi32((int)ALEATORIO_M1);
+
+    __m256i x0 = _mm256_add_epi32(_mm256_set1_epi32((int)(uint32_t)contador), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    __m256i x1 = _mm256_set1_epi32((int)(uint32_t)(contador >> 32));
+    __m256i x2 = _mm256_set1_epi32((int)gerador->fluxo);
+    __m256i x3 = _mm256_set1_epi32((int)gerador->quadro);
+    uint32_t k0 = gerador->chave[0], k1 = gerador->chave[1];
+
+    for (int r = 0; r < ALEATORIO_RODADAS; r++)
+    {
+        __m256i lo0, lo1;
+        const __m256i hi0 = aleatorioMulHiLo(x0, m0, &lo0);
+        const __m256i hi1 = aleatorioMulHiLo(x2, m1, &lo1);
+
+        x0 = _mm256_xor_si256(_mm256_xor_si256(hi1, x1), _mm256_set1_epi32((int)k0));
+        x1 = lo1;
+        x2 = _mm256_xor_si256(_mm256_xor_si256(hi0, x3), _mm256_set1_epi32((int)k1));
+        x3 = lo0;
+
+        k0 += ALEATORIO_W0;
+        k1 += ALEATORIO_W1;
+    }
+
+    _mm256_storeu_si256((__m256i *)(palavras + 0 * ALEATORIO_LANES), x0);
+    _mm256_storeu_si256((__m256i *)(palavras + 1 * ALEATORIO_LANES), x1);
+    _mm256_storeu_si256((__m256i *)(palavras + 2 * ALEATORIO_LANES), x2);
+    _mm256_storeu_si256((__m256i *)(palavras + 3 * ALEATORIO_LANES), x3);
+}
+
+#else
+
+/**
+ * @brief Writes the 32 words of a group: word i of lane l goes to palavras[i * 8 + l].
+ */
+static void aleatorioGrupoPalavras(const aleatorioGerador *gerador, uint64_t grupo, uint32_t *palavras)
+{
+    const uint64_t contador = grupo * ALEATORIO_LANES;
+
+    for (int l = 0; l < ALEATORIO_LANES; l++)
+    {
+        uint32_t x0 = (uint32_t)contador + (uint32_t)l, x1 = (uint32_t)(contador >> 32);
+        uint32_t x2 = gerador->fluxo, x3 = gerador->quadro;
+        uint32_t k0 = gerador->chave[0], k1 = gerador->chave[1];
+
+        for (int r = 0; r < ALEATORIO_RODADAS; r++)
+        {
+            const uint64_t p0 = (uint64_t)ALEATORIO_M0 * x0;
+            const uint64_t p1 = (uint64_t)ALEATORIO_M1 * x2;
+
+            x0 = (uint32_t)(p1 >> 32) ^ x1 ^ k0;
+            x1 = (uint32_t)p1;
+            x2 = (uint32_t)(p0 >> 32) ^ x3 ^ k1;
+            x3 = (uint32_t)p0;
+
+            k0 += ALEATORIO_W0;
+            k1 += ALEATORIO_W1;
+        }
+
+        palavras[0 * ALEATORIO_LANES + l] = x0;
+        palavras[1 * ALEATORIO_LANES + l] = x1;
+        palavras[2 * ALEATORIO_LANES + l] = x2;
+        palavras[3 * ALEATORIO_LANES + l] = x3;
+    }
+}
+
+#endif
+
+/************************************* TRANSFORMS ***************************************/
+
+#if defined(__AVX2__) && defined(__FMA__)
+
+/**
+ * @brief Natural logarithm of 8 floats in (0, 1] (Cephes logf polynomial, about 1 ulp).
+ */
+static inline __m256 aleatorioLog8(__m256 x)
+{
+    const __m256 um = _mm256_set1_ps(1.0f);
+    const __m256i bits = _mm256_castps_si256(x);
+
+    //! x = m * 2^e with m in [0.5, 1), then m moved to [sqrt(1/2) - 1, sqrt(2) - 1)
+    __m256 e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(126)));
+    __m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F000000)));
+    const __m256 menor = _mm256_cmp_ps(m, _mm256_set1_ps(0.707106781186547524f), _CMP_LT_OQ);
+
+    e = _mm256_sub_ps(e, _mm256_and_ps(menor, um));
+    m = _mm256_add_ps(_mm256_sub_ps(m, um), _mm256_and_ps(menor, m));
+
+    const __m256 z = _mm256_mul_ps(m, m);
+    __m256 y = _mm256_set1_ps(7.0376836292e-2f);
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(-1.1514610310e-1f));
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(1.1676998740e-1f));
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(-1.2420140846e-1f));
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(1.4249322787e-1f));
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(-1.6668057665e-1f));
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(2.0000714765e-1f));
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(-2.4999993993e-1f));
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(3.3333331174e-1f));
+    y = _mm256_mul_ps(_mm256_mul_ps(y, m), z);
+
+    y = _mm256_fmadd_ps(e, _mm256_set1_ps(-2.12194440e-4f), y);
+    y = _mm256_fnmadd_ps(z, _mm256_set1_ps(0.5f), y);
+
+    return _mm256_fmadd_ps(e, _mm256_set1_ps(0.693359375f), _mm256_add_ps(m, y));
+}
+
+/**
+ * @brief Cosine and sine of 2 pi u for 8 floats u in [0, 1).
+ *
+ * u = q / 4 + f with |f| <= 1/8 is split exactly, the Cephes polynomials run on 2 pi f in [-pi/4, pi/4]
+ * and the quadrant q swaps and negates the results.
+ */
+static inline void aleatorioSinCos8(__m256 u, __m256 *cosseno, __m256 *seno)
+{
+    const __m256 q = _mm256_round_ps(_mm256_mul_ps(u, _mm256_set1_ps(4.0f)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    const __m256 r = _mm256_mul_ps(_mm256_fnmadd_ps(q, _mm256_set1_ps(0.25f), u), _mm256_set1_ps(ALEATORIO_DOIS_PI));
+    const __m256 z = _mm256_mul_ps(r, r);
+
+    __m256 s = _mm256_set1_ps(-1.9515295891e-4f);
+    s = _mm256_fmadd_ps(s, z, _mm256_set1_ps(8.3321608736e-3f));
+    s = _mm256_fmadd_ps(s, z, _mm256_set1_ps(-1.6666654611e-1f));
+    s = _mm256_fmadd_ps(_mm256_mul_ps(s, z), r, r);
+
+    __m256 c = _mm256_set1_ps(2.443315711809948e-5f);
+    c = _mm256_fmadd_ps(c, z, _mm256_set1_ps(-1.388731625493765e-3f));
+    c = _mm256_fmadd_ps(c, z, _mm256_set1_ps(4.166664568298827e-2f));
+    c = _mm256_fmadd_ps(_mm256_mul_ps(c, z), z, _mm256_fnmadd_ps(z, _mm256_set1_ps(0.5f), _mm256_set1_ps(1.0f)));
+
+    //! Quadrant 1 and 3 swap cosine and sine; the cosine is negative in 1 and 2, the sine in 2 and 3
+    const __m256i quadrante = _mm256_cvtps_epi32(q);
+    const __m256 troca = _mm256_castsi256_ps(_mm256_slli_epi32(quadrante, 31));
+    const __m256 sinalCos = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(quadrante, _mm256_set1_epi32(1)), 30));
+    const __m256 sinalSen = _mm256_castsi256_ps(_mm256_slli_epi32(quadrante, 30));
+    const __m256 bitSinal = _mm256_set1_ps(-0.0f);
+
+    *cosseno = _mm256_xor_ps(_mm256_blendv_ps(c, s, troca), _mm256_and_ps(sinalCos, bitSinal));
+    *seno = _mm256_xor_ps(_mm256_blendv_ps(s, c, troca), _mm256_and_ps(sinalSen, bitSinal));
+}
+
+/**
+ * @brief Turns the 32 words of a group into floats minimo + amplitude * u, u in [0, 1).
+ */
+static void aleatorioUniformeGrupo(const uint32_t *palavras, float *saida, float minimo, float amplitude)
+{
+    const __m256 escala = _mm256_set1_ps(amplitude * ALEATORIO_ESCALA);
+    const __m256 base = _mm256_set1_ps(minimo);
+
+    for (int i = 0; i < ALEATORIO_GRUPO; i += ALEATORIO_LANES)
+    {
+        const __m256i w = _mm256_loadu_si256((const __m256i *)(palavras + i));
+        const __m256 u = _mm256_cvtepi32_ps(_mm256_srli_epi32(w, 8));
+
+        _mm256_storeu_ps(saida + i, _mm256_fmadd_ps(u, escala, base));
+    }
+}
+
+/**
+ * @brief Turns the 32 words of a group into 32 Gaussian floats of standard deviation 'desvio' (Box-Muller).
+ */
+static void aleatorioGaussianoGrupo(const uint32_t *palavras, float *saida, float desvio)
+{
+    const __m256 escala = _mm256_set1_ps(ALEATORIO_ESCALA);
+
+    for (int i = 0; i < ALEATORIO_GRUPO; i += 2 * ALEATORIO_LANES)
+    {
+        const __m256i w1 = _mm256_loadu_si256((const __m256i *)(palavras + i));
+        const __m256i w2 = _mm256_loadu_si256((const __m256i *)(palavras + i + ALEATORIO_LANES));
+
+        //! u1 in (0, 1] keeps the logarithm finite, u2 in [0, 1) is the angle
+        const __m256 u1 = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_srli_epi32(w1, 8), _mm256_set1_epi32(1))), escala);
+        const __m256 u2 = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(w2, 8)), escala);
+        const __m256 raio = _mm256_mul_ps(_mm256_sqrt_ps(_mm256_mul_ps(aleatorioLog8(u1), _mm256_set1_ps(-2.0f))), _mm256_set1_ps(desvio));
+
+        __m256 cosseno, seno;
+        aleatorioSinCos8(u2, &cosseno, &seno);
+
+        _mm256_storeu_ps(saida + i, _mm256_mul_ps(raio, cosseno));
+        _mm256_storeu_ps(saida + i + ALEATORIO_LANES, _mm256_mul_ps(raio, seno));
+    }
+}
+
+#else
+
+/*
+ * The scalar path evaluates the same polynomials as aleatorioLog8 and aleatorioSinCos8, with fmaf where
+ * they fuse, in the same order, so every build writes bit-identical values for the same counter.
+ */
+
+/**
+ * @brief Natural logarithm of a float in (0, 1], operation by operation as in aleatorioLog8.
+ */
+static inline float aleatorioLog(float x)
+{
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+
+    float e = (float)((int32_t)(bits >> 23) - 126);
+    const uint32_t mantissa = (bits & 0x007FFFFFu) | 0x3F000000u;
+    float m;
+    memcpy(&m, &mantissa, sizeof(m));
+
+    const int menor = m < 0.707106781186547524f;
+
+    e = e - (menor ? 1.0f : 0.0f);
+    m = (m - 1.0f) + (menor ? m : 0.0f);
+
+    const float z = m * m;
+    float y = 7.0376836292e-2f;
+    y = fmaf(y, m, -1.1514610310e-1f);
+    y = fmaf(y, m, 1.1676998740e-1f);
+    y = fmaf(y, m, -1.2420140846e-1f);
+    y = fmaf(y, m, 1.4249322787e-1f);
+    y = fmaf(y, m, -1.6668057665e-1f);
+    y = fmaf(y, m, 2.0000714765e-1f);
+    y = fmaf(y, m, -2.4999993993e-1f);
+    y = fmaf(y, m, 3.3333331174e-1f);
+    y = (y * m) * z;
+
+    y = fmaf(e, -2.12194440e-4f, y);
+    y = fmaf(-z, 0.5f, y);
+
+    return fmaf(e, 0.693359375f, m + y);
+}
+
+/**
+ * @brief Cosine and sine of 2 pi u for a float u in [0, 1), operation by operation as in aleatorioSinCos8.
+ */
+static inline void aleatorioSinCos(float u, float *cosseno, float *seno)
+{
+    const float q = rintf(u * 4.0f);
+    const float r = fmaf(-q, 0.25f, u) * ALEATORIO_DOIS_PI;
+    const float z = r * r;
+
+    float s = -1.9515295891e-4f;
+    s = fmaf(s, z, 8.3321608736e-3f);
+    s = fmaf(s, z, -1.6666654611e-1f);
+    s = fmaf(s * z, r, r);
+
+    float c = 2.443315711809948e-5f;
+    c = fmaf(c, z, -1.388731625493765e-3f);
+    c = fmaf(c, z, 4.166664568298827e-2f);
+    c = fmaf(c * z, z, fmaf(-z, 0.5f, 1.0f));
+
+    const int quadrante = (int)q;
+    const float cos0 = (quadrante & 1) ? s : c;
+    const float sen0 = (quadrante & 1) ? c : s;
+
+    *cosseno = ((quadrante + 1) & 2) ? -cos0 : cos0;
+    *seno = (quadrante & 2) ? -sen0 : sen0;
+}
+
+/**
+ * @brief Turns the 32 words of a group into floats minimo + amplitude * u, u in [0, 1).
+ */
+static void aleatorioUniformeGrupo(const uint32_t *palavras, float *saida, float minimo, float amplitude)
+{
+    const float escala = amplitude * ALEATORIO_ESCALA;
+
+    for (int i = 0; i < ALEATORIO_GRUPO; i++)
+    {
+        saida[i] = fmaf((float)(palavras[i] >> 8), escala, minimo);
+    }
+}
+
+/**
+ * @brief Turns the 32 words of a group into 32 Gaussian floats of standard deviation 'desvio' (Box-Muller).
+ */
+static void aleatorioGaussianoGrupo(const uint32_t *palavras, float *saida, float desvio)
+{
+    for (int i = 0; i < ALEATORIO_GRUPO; i += 2 * ALEATORIO_LANES)
+    {
+        for (int l = 0; l < ALEATORIO_LANES; l++)
+        {
+            const float u1 = (float)((palavras[i + l] >> 8) + 1) * ALEATORIO_ESCALA;
+            const float u2 = (float)(palavras[i + ALEATORIO_LANES + l] >> 8) * ALEATORIO_ESCALA;
+            const float raio = sqrtf(aleatorioLog(u1) * -2.0f) * desvio;
+            float cosseno, seno;
+
+            aleatorioSinCos(u2, &cosseno, &seno);
+
+            saida[i + l] = raio * cosseno;
+            saida[i + ALEATORIO_LANES + l] = raio * seno;
+        }
+    }
+}
+
+#endif
+
+/************************************* FILLS ***************************************/
+
+/**
+ * @brief Runs the groups [inicio, fim) of a fill (paraleloFuncao).
+ *
+ * Each group writes its 32 outputs straight into destino; only the last, incomplete group of the
+ * fill goes through a temporary buffer.
+ */
+static void aleatorioFaixa(void *contexto, long inicio, long fim)
+{
+    const aleatorioContexto *c = (const aleatorioContexto *)contexto;
+    uint32_t palavras[ALEATORIO_GRUPO];
+    uint32_t temporario[ALEATORIO_GRUPO];
+
+    for (long k = inicio; k < fim; k++)
+    {
+        const long resto = c->n - k * ALEATORIO_GRUPO;
+        uint32_t *saida = (uint32_t *)c->destino + k * ALEATORIO_GRUPO;
+        uint32_t *alvo = (resto >= ALEATORIO_GRUPO) ? saida : temporario;
+
+        if (c->tipo == ALEATORIO_PALAVRAS)
+        {
+            aleatorioGrupoPalavras(c->gerador, c->primeiro + (uint64_t)k, alvo);
+        }
+        else
+        {
+            aleatorioGrupoPalavras(c->gerador, c->primeiro + (uint64_t)k, palavras);
+
+            if (c->tipo == ALEATORIO_UNIFORME)
+            {
+                aleatorioUniformeGrupo(palavras, (float *)alvo, c->a, c->b);
+            }
+            else
+            {
+                aleatorioGaussianoGrupo(palavras, (float *)alvo, c->a);
+            }
+        }
+
+        if (alvo == temporario)
+        {
+            memcpy(saida, temporario, (size_t)resto * sizeof(uint32_t));
+        }
+    }
+}
+
+/**
+ * @brief Runs a fill serially or on the thread pool and moves the generator past the groups it used.
+ */
+static void aleatorioPreenche(aleatorioGerador *gerador, aleatorioContexto contexto, int paralelo, long custoPorGrupo)
+{
+    if (contexto.n <= 0)
+    {
+        return;
+    }
+
+    const long grupos = (contexto.n + ALEATORIO_GRUPO - 1) / ALEATORIO_GRUPO;
+
+    contexto.gerador = gerador;
+    contexto.primeiro = gerador->grupo;
+
+    if (paralelo)
+    {
+        paraleloPara(grupos, custoPorGrupo, aleatorioFaixa, &contexto);
+    }
+    else
+    {
+        aleatorioFaixa(&contexto, 0, grupos);
+    }
+
+    gerador->grupo += (uint64_t)grupos;
+    gerador->usadas = ALEATORIO_GRUPO;
+}
+
+/************************************* SUBSTREAMS ***************************************/
+
+/**
+ * @param[out] gerador The generator
+ * @param[in] semente The seed shared by all substreams of a run
+ * @param[in] fluxo First index of the substream
+ * @param[in] quadro Second index of the substream
+ *
+ * @brief Starts the substream (fluxo, quadro) of the seed at its first group.
+ */
+void aleatorioInit(aleatorioGerador *gerador, uint64_t semente, uint32_t fluxo, uint32_t quadro)
+{
+    gerador->chave[0] = (uint32_t)semente;
+    gerador->chave[1] = (uint32_t)(semente >> 32);
+    gerador->fluxo = fluxo;
+    gerador->quadro = quadro;
+    gerador->grupo = 0;
+    gerador->usadas = ALEATORIO_GRUPO;
+}
+
+/**
+ * @brief Jumps 'grupos' groups ahead; the counter makes it an addition.
+ */
+void aleatorioAvanca(aleatorioGerador *gerador, uint64_t grupos)
+{
+    gerador->grupo += grupos;
+    gerador->usadas = ALEATORIO_GRUPO;
+}
+
+/************************************* SINGLE VALUES ***************************************/
+
+/**
+ * @brief Returns the next word of the reserve, encrypting a new group when it is used up.
+ */
+uint32_t aleatorioPalavra(aleatorioGerador *gerador)
+{
+    if (gerador->usadas == ALEATORIO_GRUPO)
+    {
+        aleatorioGrupoPalavras(gerador, gerador->grupo++, gerador->reserva);
+        gerador->usadas = 0;
+    }
+
+    return gerador->reserva[gerador->usadas++];
+}
+
+/**
+ * @brief Returns a uniform float in [0, 1) made of the 24 high bits of the next word.
+ */
+float aleatorioUniforme(aleatorioGerador *gerador)
+{
+    return (float)(aleatorioPalavra(gerador) >> 8) * ALEATORIO_ESCALA;
+}
+
+/************************************* BATCH FILLS ***************************************/
+
+/**
+ * @brief Writes n random words into destino.
+ */
+void aleatorioPalavrasEm(aleatorioGerador *gerador, uint32_t *destino, long n)
+{
+    aleatorioContexto contexto = {NULL, 0, destino, n, ALEATORIO_PALAVRAS, 0.0f, 0.0f};
+
+    aleatorioPreenche(gerador, contexto, 0, 0);
+}
+
+/**
+ * @brief Writes n floats uniform between minimo and maximo into destino.
+ */
+void aleatorioUniformeEm(aleatorioGerador *gerador, float *destino, long n, float minimo, float maximo)
+{
+    aleatorioContexto contexto = {NULL, 0, destino, n, ALEATORIO_UNIFORME, minimo, maximo - minimo};
+
+    aleatorioPreenche(gerador, contexto, 0, 0);
+}
+
+/**
+ * @brief Writes n Gaussian floats of mean 0 and standard deviation 'desvio' into destino.
+ */
+void aleatorioGaussianoEm(aleatorioGerador *gerador, float *destino, long n, float desvio)
+{
+    aleatorioContexto contexto = {NULL, 0, destino, n, ALEATORIO_GAUSSIANO, desvio, 0.0f};
+
+    aleatorioPreenche(gerador, contexto, 0, 0);
+}
+
+/**
+ * @brief Parallel aleatorioUniformeEm: every group depends only on its counter, so the split does not change the values.
+ */
+void aleatorioUniformeParaleloEm(aleatorioGerador *gerador, float *destino, long n, float minimo, float maximo)
+{
+    aleatorioContexto contexto = {NULL, 0, destino, n, ALEATORIO_UNIFORME, minimo, maximo - minimo};
+
+    aleatorioPreenche(gerador, contexto, 1, 16 * ALEATORIO_GRUPO);
+}
+
+/**
+ * @brief Parallel aleatorioGaussianoEm: every group depends only on its counter, so the split does not change the values.
+ */
+void aleatorioGaussianoParaleloEm(aleatorioGerador *gerador, float *destino, long n, float desvio)
+{
+    aleatorioContexto contexto = {NULL, 0, destino, n, ALEATORIO_GAUSSIANO, desvio, 0.0f};
+
+    aleatorioPreenche(gerador, contexto, 1, 64 * ALEATORIO_GRUPO);
+}
+
+/************************************* TESTS ***************************************/
+
+/**
+ * @brief Compares lane 0 of the first group of a substream with a Philox4x32-10 known-answer vector.
+ *
+ * The counter of lane 0 is (8 * grupo, fluxo, quadro), so the vector's counter fixes the substream
+ * and the group, and its key is the seed. Both the batch fill and the single-word path are checked.
+ */
+static int testeAleatorioKAT(const char *nome, uint64_t semente, uint64_t contador, uint32_t fluxo, uint32_t quadro, const uint32_t esperado[4])
+{
+    aleatorioGerador gerador;
+    uint32_t palavras[ALEATORIO_GRUPO];
+    int ok = 1;
+
+    aleatorioInit(&gerador, semente, fluxo, quadro);
+    aleatorioAvanca(&gerador, contador / ALEATORIO_LANES);
+    aleatorioPalavrasEm(&gerador, palavras, ALEATORIO_GRUPO);
+
+    for (int i = 0; i < 4; i++)
+    {
+        ok &= (palavras[i * ALEATORIO_LANES] == esperado[i]);
+    }
+
+    aleatorioInit(&gerador, semente, fluxo, quadro);
+    aleatorioAvanca(&gerador, contador / ALEATORIO_LANES);
+
+    for (int i = 0; i < ALEATORIO_GRUPO; i++)
+    {
+        ok &= (aleatorioPalavra(&gerador) == palavras[i]);
+    }
+
+    return testeConfere(nome, ok, NULL);
+}
+
+/**
+ * @brief Checks the generator against the Random123 known-answer vectors and the parallel fills against the serial ones.
+ *
+ * @return The number of failed checks.
+ */
+int teste_aleatorio(void)
+{
+    //! Random123 kat_vectors: philox4x32 10, counter 0 / key 0 and the digits of pi
+    const uint32_t katZero[4] = {0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u};
+    const uint32_t katPi[4] = {0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u};
+    //! First values of substream (12345, 3, 7), bit for bit: the SIMD and the scalar builds must both give them
+    const uint32_t gaussianoConhecido[8] = {0x3ecc9b81u, 0xbe11d16du, 0x3f069811u, 0x3f13aba2u, 0xbe1cb7ffu, 0xbf795e86u, 0xbfd2e808u, 0xbf6bbcaau};
+    const uint32_t uniformeConhecido[4] = {0x3fd8637eu, 0xbeeee908u, 0x3ea54be0u, 0x40119aaau};
+    const long n = (1L << 20) + 13;
+    int falhas = 0;
+
+    printf("\n  ============ Teste do gerador aleatorio (Philox4x32-10) ============ \n\n");
+
+    falhas += testeAleatorioKAT("KAT contador 0, chave 0", 0, 0, 0, 0, katZero);
+    falhas += testeAleatorioKAT("KAT digitos de pi", 0x299f31d0a4093822ULL, 0x85a308d3243f6a88ULL, 0x13198a2eu, 0x03707344u, katPi);
+
+    float *serial = (float *)malloc((size_t)n * sizeof(float));
+    float *paralelo = (float *)malloc((size_t)n * sizeof(float));
+
+    if (serial == NULL || paralelo == NULL)
+    {
+        printf("Falha na alocacao de memoria\n");
+        exit(1);
+    }
+
+    paraleloFree();
+    paraleloInit(4);
+
+    aleatorioGerador gerador;
+
+    aleatorioInit(&gerador, 12345, 3, 7);
+    aleatorioGaussianoEm(&gerador, serial, n, 1.0f);
+    aleatorioInit(&gerador, 12345, 3, 7);
+    aleatorioGaussianoParaleloEm(&gerador, paralelo, n, 1.0f);
+    falhas += testeConfere("aleatorioGaussianoParaleloEm = serial", memcmp(serial, paralelo, (size_t)n * sizeof(float)) == 0, NULL);
+    falhas += testeConfere("aleatorioGaussianoEm  valores conhecidos", memcmp(serial, gaussianoConhecido, sizeof(gaussianoConhecido)) == 0, NULL);
+
+    aleatorioInit(&gerador, 12345, 3, 7);
+    aleatorioUniformeEm(&gerador, serial, n, -1.0f, 1.0f);
+    aleatorioInit(&gerador, 12345, 3, 7);
+    aleatorioUniformeParaleloEm(&gerador, paralelo, n, -1.0f, 1.0f);
+    falhas += testeConfere("aleatorioUniformeParaleloEm = serial", memcmp(serial, paralelo, (size_t)n * sizeof(float)) == 0, NULL);
+
+    aleatorioInit(&gerador, 12345, 3, 7);
+    aleatorioUniformeEm(&gerador, paralelo, 4, -1.0f, 3.0f);
+    falhas += testeConfere("aleatorioUniformeEm  valores conhecidos", memcmp(paralelo, uniformeConhecido, sizeof(uniformeConhecido)) == 0, NULL);
+
+    //! Jumping ahead lands on the same values as drawing through
+    aleatorioInit(&gerador, 12345, 3, 7);
+    aleatorioAvanca(&gerador, 1000);
+    aleatorioUniformeEm(&gerador, paralelo, 64, -1.0f, 1.0f);
+    falhas += testeConfere("aleatorioAvanca = fill continuo", memcmp(serial + 1000 * ALEATORIO_GRUPO, paralelo, 64 * sizeof(float)) == 0, NULL);
+
+    paraleloFree();
+    free(serial);
+    free(paralelo);
+
+    return falhas;
+}
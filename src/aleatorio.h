@@ -0,0 +1,115 @@
+/**
+ * @file aleatorio.h
+ * @brief Header file for the counter-based random number generator (Philox4x32-10) and its batch fills.
+ */
+
+#ifndef ALEATORIO_H
+#define ALEATORIO_H
+#include <stdint.h>
+
+/*!
+* @brief Number of 32-bit words produced by one group of the generator (8 Philox blocks of 4 words).
+*
+* A group is the unit of work of the generator: 8 consecutive counters are encrypted together, one per
+* AVX lane, and every fill consumes whole groups. The word i of lane l of a group goes to position
+* i * 8 + l of its output, in the SIMD and in the scalar builds alike.
+*/
+#define ALEATORIO_GRUPO 32
+
+/*!
+* @brief State of one substream of the generator.
+*
+* A word depends only on (semente, fluxo, quadro, position in the substream): there is no hidden state
+* to share between threads, any substream can be started anywhere, and jumping ahead is an addition
+* to the counter. Give each thread, user or frame of a simulation its own (fluxo, quadro) and the
+* results are the same whatever the number of threads or the order in which they run.
+*/
+typedef struct
+{
+    uint32_t chave[2];                  /*!< Philox key, taken from the seed */
+    uint32_t fluxo, quadro;             /*!< Substream: high words of the counter */
+    uint64_t grupo;                     /*!< Next group of the substream */
+    uint32_t reserva[ALEATORIO_GRUPO];  /*!< Group being consumed by the single-value functions */
+    int usadas;                         /*!< Words of reserva already used */
+} aleatorioGerador;
+
+///****************************************** SUBSTREAMS ****************************************************/
+
+/**
+ * @brief Starts the substream (fluxo, quadro) of the seed 'semente' at its first group.
+ *
+ * @param gerador The generator.
+ * @param semente The seed shared by all substreams of a run.
+ * @param fluxo First index of the substream (for example a user, antenna or thread).
+ * @param quadro Second index of the substream (for example a frame or a Monte Carlo trial).
+ */
+void aleatorioInit(aleatorioGerador *gerador, uint64_t semente, uint32_t fluxo, uint32_t quadro);
+
+/**
+ * @brief Jumps 'grupos' groups (ALEATORIO_GRUPO words each) ahead in the substream, in O(1).
+ *
+ * The words left in the reserve of the single-value functions are discarded.
+ */
+void aleatorioAvanca(aleatorioGerador *gerador, uint64_t grupos);
+
+///****************************************** SINGLE VALUES ****************************************************/
+
+/**
+ * @brief Returns the next 32-bit word of the substream.
+ */
+uint32_t aleatorioPalavra(aleatorioGerador *gerador);
+
+/**
+ * @brief Returns the next uniform float of the substream, in [0, 1) with 24 random bits.
+ */
+float aleatorioUniforme(aleatorioGerador *gerador);
+
+///****************************************** BATCH FILLS ****************************************************/
+///
+///-----> Each fill starts at the next whole group (the reserve of the single-value functions is skipped) and
+///-----> consumes ceil(n / ALEATORIO_GRUPO) groups, so the output of a fill depends only on the substream,
+///-----> the group it starts at and n. The parallel versions give the same values as the serial ones.
+///
+
+/**
+ * @brief Writes n random 32-bit words into destino.
+ */
+void aleatorioPalavrasEm(aleatorioGerador *gerador, uint32_t *destino, long n);
+
+/**
+ * @brief Writes n floats uniform between minimo and maximo into destino (24 random bits each).
+ */
+void aleatorioUniformeEm(aleatorioGerador *gerador, float *destino, long n, float minimo, float maximo);
+
+/**
+ * @brief Writes n Gaussian floats of mean 0 and standard deviation 'desvio' into destino (Box-Muller).
+ *
+ * Each pair of words (lanes of words 0 and 1, then of words 2 and 3) gives two independent values:
+ * the 8 cosine outputs of the lanes, followed by their 8 sine outputs. The SIMD and the scalar builds
+ * evaluate the same logarithm and sine/cosine polynomials, so the values are bit-identical in both.
+ */
+void aleatorioGaussianoEm(aleatorioGerador *gerador, float *destino, long n, float desvio);
+
+/**
+ * @brief Parallel aleatorioUniformeEm: the groups are split over the thread pool of paralelo.h.
+ */
+void aleatorioUniformeParaleloEm(aleatorioGerador *gerador, float *destino, long n, float minimo, float maximo);
+
+/**
+ * @brief Parallel aleatorioGaussianoEm: the groups are split over the thread pool of paralelo.h.
+ */
+void aleatorioGaussianoParaleloEm(aleatorioGerador *gerador, float *destino, long n, float desvio);
+
+///****************************************** TESTS ****************************************************/
+
+/**
+ * @brief Checks the Philox rounds against the Random123 known-answer vectors (counter 0 / key 0 and the
+ * digits of pi) and the parallel fills against the serial ones with memcmp.
+ *
+ * Prints one OK/FALHOU line per check.
+ *
+ * @return The number of failed checks.
+ */
+int teste_aleatorio(void);
+
+#endif
@@ -5,605 +5,2133 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <pthread.h>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
 
 /// including the files where the structure is contained
 #include "matrizes.h"
+#include "memoria.h"
+#include "matrizes_lote.h"
+#include "matrizes_fixas.h"
+#include "matrizes_expr.h"
+#include "paralelo.h"
+#include "matrizes_fatoracao.h"
+#include "aleatorio.h"
+#include "ponto_fixo.h"
 
 /// including the GSL library
 #include <gsl/gsl_linalg.h>
 
 /************************************* FUNCTIONS FOR ALLOCATION OF MEMORY ***************************************/
+
+/**
+ * @brief Allocates a 64-byte aligned block of memory.
+ *
+ * The size is rounded up to a multiple of the alignment, as required by aligned_alloc.
+ *
+ * @param [in] bytes Number of bytes requested
+ * @return Pointer to the block, or NULL if the allocation failed.
+ */
+void *matrixAlignedAlloc(size_t bytes)
+{
+    //! Rounding the size up to a whole number of cache lines (and never asking for 0 bytes)
+    size_t tamanho = (bytes + MATRIX_ALINHAMENTO - 1) / MATRIX_ALINHAMENTO * MATRIX_ALINHAMENTO;
+    if (tamanho == 0)
+    {
+        tamanho = MATRIX_ALINHAMENTO;
+    }
+
+#ifdef _WIN32
+    return _aligned_malloc(tamanho, MATRIX_ALINHAMENTO);
+#else
+    return aligned_alloc(MATRIX_ALINHAMENTO, tamanho);
+#endif
+}
+
+/**
+ * @brief Releases a block returned by matrixAlignedAlloc.
+ *
+ * @param [in] ptr The block to be released
+ */
+void matrixAlignedFree(void *ptr)
+{
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+/**
+ * @brief Number of bytes of the block that holds a complex matrix (row pointers + elements).
+ *
+ * @param [in] linhas Number of rows
+ * @param [in] colunas Number of columns
+ * @return Size of the block, a multiple of MATRIX_ALINHAMENTO.
+ */
+size_t matrixTamanhoBloco(int linhas, int colunas)
+{
+    //! Size of the row pointer array, rounded up so that the elements start on a cache line
+    size_t bytesLinhas = ((size_t)linhas * sizeof(complex *) + MATRIX_ALINHAMENTO - 1) / MATRIX_ALINHAMENTO * MATRIX_ALINHAMENTO;
+    size_t bytesDados = (size_t)linhas * (size_t)colunas * sizeof(complex);
+    size_t total = (bytesLinhas + bytesDados + MATRIX_ALINHAMENTO - 1) / MATRIX_ALINHAMENTO * MATRIX_ALINHAMENTO;
+
+    return (total == 0) ? MATRIX_ALINHAMENTO : total;
+}
+
+/**
+ * @brief Lays a complex matrix out over a block of matrixTamanhoBloco(linhas, colunas) bytes.
+ *
+ * The block starts with the row pointer array, padded to a whole cache line, followed by the
+ * elements stored row after row (ld == colunas). The returned matrix owns the block.
+ *
+ * @param [in] bloco 64-byte aligned block of memory
+ * @param [in] linhas Number of rows
+ * @param [in] colunas Number of columns
+ * @return The complexMatrix laid over the block.
+ */
+complexMatrix matrixSobreBloco(void *bloco, int linhas, int colunas)
+{
+    complexMatrix matrix;
+    size_t bytesLinhas = ((size_t)linhas * sizeof(complex *) + MATRIX_ALINHAMENTO - 1) / MATRIX_ALINHAMENTO * MATRIX_ALINHAMENTO;
+
+    matrix.linhas = linhas;
+    matrix.colunas = colunas;
+    matrix.ld = colunas;
+    matrix.bloco = bloco;
+    matrix.mtx = (complex **)bloco;
+    matrix.dados = (complex *)((char *)bloco + bytesLinhas);
+
+    /**
+ * @brief Points each row to its place inside the contiguous block.
+ *
+ * Rows are never allocated separately; 'mtx[i]' is just a shortcut to 'dados + i * ld'.
+ */
+    for (int i = 0; i < linhas; i++)
+    {
+        matrix.mtx[i] = matrix.dados + (size_t)i * matrix.ld;
+    }
+
+    return matrix;
+}
+
+/**
+ *
+ * @param [in] linhas
+ * @param [in] colunas
+ * @param [out] matrix
+ *
+ * @brief Allocates the complex matrix in a single aligned block.
+ *
+ * Only one allocation is made, whatever the number of rows (see matrixSobreBloco for the layout).
+ */
+
+//! Creating a function whose purpose is to dynamically allocate memory for the complex matrix
+complexMatrix allocateComplexMatrix(int linhas, int colunas) {
+
+    //! Allocating the row pointers and the elements at once
+    void *bloco = matrixAlignedAlloc(matrixTamanhoBloco(linhas, colunas));
+
+   /**
+ * @brief Handles possible errors when trying to allocate memory to the matrix.
+ *
+ * This code checks if the memory allocation for the matrix was successful. If the allocation failed, it prints an error message and terminates the program with an exit code of 1.
+ */
+if (bloco == NULL)
+{
+    printf("Falha na alocacao de memoria\n");
+    exit(1);
+}
+
+    //! Returning matrix
+    return matrixSobreBloco(bloco, linhas, colunas);
+}
+
+/**
+ * @brief Creates a view over a rectangular block of an existing matrix.
+ *
+ * @param [in] matrix The matrix that owns the elements
+ * @param [in] linha0 First row of the block
+ * @param [in] coluna0 First column of the block
+ * @param [in] linhas Number of rows of the block
+ * @param [in] colunas Number of columns of the block
+ * @return The view, which shares the storage and the leading dimension of 'matrix'.
+ */
+complexMatrix matrixView(complexMatrix matrix, int linha0, int coluna0, int linhas, int colunas)
+{
+    return matrixViewBuffer(matrixLinha(matrix, linha0) + coluna0, linhas, colunas, matrix.ld);
+}
+
+/**
+ * @brief Creates a view over an external buffer of complex numbers.
+ *
+ * @param [in] dados Pointer to the first element
+ * @param [in] linhas Number of rows
+ * @param [in] colunas Number of columns
+ * @param [in] ld Leading dimension of the buffer
+ * @return The view. It owns nothing, so freeComplexMatrix ignores it.
+ */
+complexMatrix matrixViewBuffer(complex *dados, int linhas, int colunas, int ld)
+{
+    complexMatrix view;
+
+    view.linhas = linhas;
+    view.colunas = colunas;
+    view.ld = ld;
+    view.dados = dados;
+    view.mtx = NULL;
+    view.bloco = NULL;
+
+    return view;
+}
+
+/**
+ * @brief Reports how many rows and columns must be walked to visit every element of the matrices.
+ *
+ * When all the matrices are stored without gaps (ld == colunas), the whole matrix is walked as a
+ * single long row, so the element-wise operations stream through memory in one linear pass.
+ *
+ * @param [in] a, b, c The matrices involved in the operation (the same matrix may be repeated)
+ * @param [out] linhas Number of rows to walk
+ * @param [out] colunas Number of columns to walk (size_t: the single long row can exceed INT_MAX elements)
+ */
+static void matrixPercurso(complexMatrix a, complexMatrix b, complexMatrix c, int *linhas, size_t *colunas)
+{
+    if (a.ld == a.colunas && b.ld == b.colunas && c.ld == c.colunas)
+    {
+        *linhas = 1;
+        *colunas = (size_t)a.linhas * (size_t)a.colunas;
+    }
+    else
+    {
+        *linhas = a.linhas;
+        *colunas = (size_t)a.colunas;
+    }
+}
+
+/************************ SVD CALCULATION FUNCTIONS **************************/
+
+/*
+ * One-sided (Hestenes) Jacobi SVD in single-precision complex arithmetic.
+ *
+ * The rows of a working matrix X are made mutually orthogonal by 2x2 unitary rotations applied from
+ * the left, X <- J X, and the same rotations are accumulated in Q (which starts as the identity), so
+ * X = Q M holds throughout. Once the rows are orthogonal, row i of X is sigma_i times a unit row and
+ * M = Q^H diag(sigma) (X normalized). Working on rows keeps every inner loop on contiguous memory.
+ */
+#define SVD_MAX_VARREDURAS 60
+
+/**
+ * @brief Computes alpha = |p|^2, beta = |q|^2 and gama = sum p[k] conj(q[k]) for two rows of length n.
+ */
+static void svdProdutosLinhas(const complex *p, const complex *q, int n, float *alpha, float *beta, complex *gama)
+{
+    float aa = 0.0f, bb = 0.0f, gRe = 0.0f, gIm = 0.0f;
+    int k = 0;
+
+#if defined(__AVX2__) && defined(__FMA__)
+    __m256 va = _mm256_setzero_ps(), vb = _mm256_setzero_ps();
+    __m256 vr = _mm256_setzero_ps(), vi = _mm256_setzero_ps();
+
+    for (; k + 4 <= n; k += 4)
+    {
+        const __m256 x = _mm256_loadu_ps((const float *)(p + k));
+        const __m256 y = _mm256_loadu_ps((const float *)(q + k));
+
+        va = _mm256_fmadd_ps(x, x, va);
+        vb = _mm256_fmadd_ps(y, y, vb);
+        vr = _mm256_fmadd_ps(x, y, vr);                                   //!< pr*qr | pi*qi
+        vi = _mm256_fmadd_ps(x, _mm256_permute_ps(y, 0xB1), vi);          //!< pr*qi | pi*qr
+    }
+
+    float ta[8], tb[8], tr[8], ti[8];
+    _mm256_storeu_ps(ta, va);
+    _mm256_storeu_ps(tb, vb);
+    _mm256_storeu_ps(tr, vr);
+    _mm256_storeu_ps(ti, vi);
+
+    for (int l = 0; l < 8; l += 2)
+    {
+        aa += ta[l] + ta[l + 1];
+        bb += tb[l] + tb[l + 1];
+        gRe += tr[l] + tr[l + 1];
+        gIm += ti[l + 1] - ti[l];
+    }
+#endif
+
+    for (; k < n; k++)
+    {
+        aa += p[k].Re * p[k].Re + p[k].Im * p[k].Im;
+        bb += q[k].Re * q[k].Re + q[k].Im * q[k].Im;
+        gRe += p[k].Re * q[k].Re + p[k].Im * q[k].Im;
+        gIm += p[k].Im * q[k].Re - p[k].Re * q[k].Im;
+    }
+
+    *alpha = aa;
+    *beta = bb;
+    gama->Re = gRe;
+    gama->Im = gIm;
+}
+
+/**
+ * @brief Applies the rotation p <- c p - w q, q <- conj(w) p + c q to two rows of length n.
+ */
+static void svdRotacionaLinhas(complex *p, complex *q, int n, float c, complex w)
+{
+    int k = 0;
+
+#if defined(__AVX2__) && defined(__FMA__)
+    const __m256 vc = _mm256_set1_ps(c);
+    const __m256 wr = _mm256_set1_ps(w.Re);
+    const __m256 wi = _mm256_set1_ps(w.Im);
+
+    for (; k + 4 <= n; k += 4)
+    {
+        const __m256 x = _mm256_loadu_ps((const float *)(p + k));
+        const __m256 y = _mm256_loadu_ps((const float *)(q + k));
+
+        //! w*q and conj(w)*p, with the interleaved complex product done by fmaddsub
+        const __m256 wy = _mm256_fmaddsub_ps(y, wr, _mm256_mul_ps(_mm256_permute_ps(y, 0xB1), wi));
+        const __m256 wx = _mm256_fmsubadd_ps(x, wr, _mm256_mul_ps(_mm256_permute_ps(x, 0xB1), wi));
+
+        _mm256_storeu_ps((float *)(p + k), _mm256_fmsub_ps(vc, x, wy));
+        _mm256_storeu_ps((float *)(q + k), _mm256_fmadd_ps(vc, y, wx));
+    }
+#endif
+
+    for (; k < n; k++)
+    {
+        const complex x = p[k], y = q[k];
+
+        p[k].Re = c * x.Re - (w.Re * y.Re - w.Im * y.Im);
+        p[k].Im = c * x.Im - (w.Re * y.Im + w.Im * y.Re);
+        q[k].Re = c * y.Re + (w.Re * x.Re + w.Im * x.Im);
+        q[k].Im = c * y.Im + (w.Re * x.Im - w.Im * x.Re);
+    }
+}
+
+/**
+ * @brief Swaps two rows of length n.
+ */
+static void svdTrocaLinhas(complex *p, complex *q, int n)
+{
+    for (int k = 0; k < n; k++)
+    {
+        const complex t = p[k];
+        p[k] = q[k];
+        q[k] = t;
+    }
+}
+
+/**
+ * @brief Orthogonalizes the rows of X, accumulating the rotations in Q, and sorts them by decreasing norm.
+ *
+ * @param[in,out] X Working matrix (k x n); on return its rows are orthogonal, and scaled to unit norm
+ * @param[in,out] Q Accumulated rotations (k x k); must hold the identity on entry
+ * @param[out] S The k row norms (singular values), in decreasing order
+ */
+static void svdJacobiLinhas(complexMatrix X, complexMatrix Q, float *S)
+{
+    const int k = X.linhas;
+    const int n = X.colunas;
+
+    //! Rows whose correlation is below this fraction of their norms are taken as orthogonal
+    const float tolerancia = FLT_EPSILON * (n > 16 ? (float)n : 16.0f);
+
+    for (int varredura = 0; varredura < SVD_MAX_VARREDURAS; varredura++)
+    {
+        int rotacoes = 0;
+
+        for (int p = 0; p < k - 1; p++)
+        {
+            for (int q = p + 1; q < k; q++)
+            {
+                float alpha, beta;
+                complex gama;
+
+                svdProdutosLinhas(matrixLinha(X, p), matrixLinha(X, q), n, &alpha, &beta, &gama);
+
+                const float modulo = sqrtf(gama.Re * gama.Re + gama.Im * gama.Im);
+
+                if (modulo <= tolerancia * sqrtf(alpha * beta) || modulo < FLT_MIN)
+                {
+                    continue;
+                }
+
+                //! Real rotation (c, s) that zeroes the correlation, carried to the phase of gama
+                const float zeta = (beta - alpha) / (2.0f * modulo);
+                const float t = (zeta >= 0.0f ? 1.0f : -1.0f) / (fabsf(zeta) + sqrtf(1.0f + zeta * zeta));
+                const float c = 1.0f / sqrtf(1.0f + t * t);
+                const float s = c * t;
+                const complex w = {s * gama.Re / modulo, s * gama.Im / modulo};
+
+                svdRotacionaLinhas(matrixLinha(X, p), matrixLinha(X, q), n, c, w);
+                svdRotacionaLinhas(matrixLinha(Q, p), matrixLinha(Q, q), k, c, w);
+                rotacoes++;
+            }
+        }
+
+        if (rotacoes == 0)
+        {
+            break;
+        }
+    }
+
+    for (int i = 0; i < k; i++)
+    {
+        float alpha, beta;
+        complex gama;
+
+        svdProdutosLinhas(matrixLinha(X, i), matrixLinha(X, i), n, &alpha, &beta, &gama);
+        S[i] = sqrtf(alpha);
+    }
+
+    //! Selection sort by decreasing singular value (k is small), moving the rows of X and Q together
+    for (int i = 0; i < k - 1; i++)
+    {
+        int maior = i;
+
+        for (int j = i + 1; j < k; j++)
+        {
+            if (S[j] > S[maior])
+            {
+                maior = j;
+            }
+        }
+
+        if (maior != i)
+        {
+            const float t = S[i];
+            S[i] = S[maior];
+            S[maior] = t;
+            svdTrocaLinhas(matrixLinha(X, i), matrixLinha(X, maior), n);
+            svdTrocaLinhas(matrixLinha(Q, i), matrixLinha(Q, maior), k);
+        }
+    }
+
+    //! Normalizing the rows; rows of null singular values are left as zero
+    for (int i = 0; i < k; i++)
+    {
+        if (S[i] > FLT_MIN)
+        {
+            matrix_produtoEscalarInPlace(matrixView(X, i, 0, 1, n), 1.0f / S[i]);
+        }
+        else
+        {
+            S[i] = 0.0f;
+        }
+    }
+}
+
+/**
+ * @brief Fills a square matrix with the identity.
+ */
+static void svdIdentidade(complexMatrix matrix)
+{
+    for (int i = 0; i < matrix.linhas; i++)
+    {
+        complex *linha = matrixLinha(matrix, i);
+
+        for (int j = 0; j < matrix.colunas; j++)
+        {
+            linha[j].Re = (i == j) ? 1.0f : 0.0f;
+            linha[j].Im = 0.0f;
+        }
+    }
+}
+
+/**
+ * @brief Thin SVD on a caller-provided working matrix X (n x m, used only when m >= n).
+ */
+static void svdNucleo(complexMatrix matrix, complexMatrix U, float *S, complexMatrix Vh, complexMatrix X)
+{
+    const int m = matrix.linhas;
+    const int n = matrix.colunas;
+
+    if (m < n)
+    {
+        //! Wide matrix: the rows of M itself are orthogonalized in Vh and Q is built in U (then U = Q^H)
+        for (int i = 0; i < m; i++)
+        {
+            memcpy(matrixLinha(Vh, i), matrixLinha(matrix, i), (size_t)n * sizeof(complex));
+        }
+        svdIdentidade(U);
+        svdJacobiLinhas(Vh, U, S);
+        matrixHermitianaInPlace(U);
+    }
+    else
+    {
+        //! Tall (or square) matrix: the rows of M^H are orthogonalized, so M = X^H diag(S) Q, U = X^H and Vh = Q
+        matrixHermitianaEm(X, matrix);
+        svdIdentidade(Vh);
+        svdJacobiLinhas(X, Vh, S);
+        matrixHermitianaEm(U, X);
+    }
+}
+
+/**
+ * @param[in] matrix The m x n matrix to be decomposed (left untouched)
+ * @param[out] U The m x k matrix of left singular vectors, k = min(m, n)
+ * @param[out] S The k singular values, in decreasing order
+ * @param[out] Vh The k x n matrix of conjugated right singular vectors (V^H)
+ *
+ * @brief Computes the thin complex SVD, matrix = U diag(S) V^H, without printing anything.
+ *
+ * The decomposition is a one-sided Jacobi in single-precision complex arithmetic, so complex channels
+ * are decomposed as they are (the old GSL path only saw the real part). The singular vectors that go
+ * with null singular values are returned as zero. A tall matrix needs a working matrix, allocated here
+ * on every call; calc_svd_trabalho reuses one instead.
+ *
+ * @return 0 on success, -1 if the dimensions of the outputs do not agree.
+ */
+int calc_svd(complexMatrix matrix, complexMatrix U, float *S, complexMatrix Vh)
+{
+    svdTrabalho trabalho = allocateSVDTrabalho(matrix.linhas, matrix.colunas);
+    const int resultado = calc_svd_trabalho(trabalho, matrix, U, S, Vh);
+
+    freeSVDTrabalho(trabalho);
+
+    return resultado;
+}
+
+/**
+ * @param[in] linhas, colunas The shape of the matrices that will be decomposed
+ *
+ * @brief Allocates the working storage of calc_svd_trabalho once, for matrices of a given shape.
+ *
+ * Only the tall (or square) case needs storage: the n x m matrix M^H whose rows are orthogonalized.
+ *
+ * @return The workspace.
+ */
+svdTrabalho allocateSVDTrabalho(int linhas, int colunas)
+{
+    svdTrabalho trabalho;
+
+    trabalho.linhas = linhas;
+    trabalho.colunas = colunas;
+
+    if (linhas >= colunas)
+    {
+        trabalho.X = allocateComplexMatrix(colunas, linhas);
+    }
+    else
+    {
+        trabalho.X = matrixViewBuffer(NULL, 0, 0, 0);
+    }
+
+    return trabalho;
+}
+
+/**
+ * @brief Frees the storage of an SVD workspace.
+ */
+void freeSVDTrabalho(svdTrabalho trabalho)
+{
+    freeComplexMatrix(trabalho.X);
+}
+
+/**
+ * @param[in] trabalho A workspace from allocateSVDTrabalho with the shape of matrix
+ * @param[in] matrix, U, S, Vh As in calc_svd
+ *
+ * @brief Same decomposition as calc_svd, with no allocation: repeated SVDs of one shape reuse the workspace.
+ *
+ * @return 0 on success, -1 if the dimensions of the outputs or of the workspace do not agree.
+ */
+int calc_svd_trabalho(svdTrabalho trabalho, complexMatrix matrix, complexMatrix U, float *S, complexMatrix Vh)
+{
+    const int m = matrix.linhas;
+    const int n = matrix.colunas;
+    const int k = (m < n) ? m : n;
+
+    if (U.linhas != m || U.colunas != k || Vh.linhas != k || Vh.colunas != n ||
+        trabalho.linhas != m || trabalho.colunas != n)
+    {
+        return -1;
+    }
+
+    svdNucleo(matrix, U, S, Vh, trabalho.X);
+
+    return 0;
+}
+
+/************************************* GSL BRIDGE ***************************************/
+
+/*
+ * 'complex' is two floats, real part first, so a complexMatrix has exactly the layout of a
+ * gsl_matrix_complex_float with tda = ld: the float views below cost nothing in either direction.
+ * The double precision matrices are copied row by row on the raw data, never element by element
+ * through gsl_matrix_complex_set/get.
+ */
+
+/**
+ * @param[in] matrix The complexMatrix (or view) to be seen by GSL
+ *
+ * @brief Returns a gsl_matrix_complex_float view over the elements of matrix (nothing is copied).
+ *
+ * @return The view; it is valid while the storage of matrix is.
+ */
+gsl_matrix_complex_float_view matrixParaGSLView(complexMatrix matrix)
+{
+    return gsl_matrix_complex_float_view_array_with_tda((float *)matrix.dados, (size_t)matrix.linhas,
+                                                        (size_t)matrix.colunas, (size_t)matrix.ld);
+}
+
+/**
+ * @param[in] gsl The GSL matrix whose elements will be seen as a complexMatrix
+ *
+ * @brief Returns a complexMatrix view over the elements of a gsl_matrix_complex_float (nothing is copied).
+ *
+ * @return The view, which owns nothing.
+ */
+complexMatrix matrixDeGSLView(gsl_matrix_complex_float *gsl)
+{
+    return matrixViewBuffer((complex *)gsl->data, (int)gsl->size1, (int)gsl->size2, (int)gsl->tda);
+}
+
+/**
+ * @param[out] destino The GSL matrix that receives the elements (same shape as origem)
+ * @param[in] origem The complexMatrix
+ *
+ * @brief Copies a complexMatrix into a double precision gsl_matrix_complex.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixParaGSL(gsl_matrix_complex *destino, complexMatrix origem)
+{
+    if (destino->size1 != (size_t)origem.linhas || destino->size2 != (size_t)origem.colunas)
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < origem.linhas; i++)
+    {
+        const float *fonte = (const float *)matrixLinha(origem, i);
+        double *linha = destino->data + 2 * (size_t)i * destino->tda;
+
+        for (int j = 0; j < 2 * origem.colunas; j++)
+        {
+            linha[j] = fonte[j];
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @param[out] destino The complexMatrix that receives the elements (same shape as origem)
+ * @param[in] origem The double precision GSL matrix
+ *
+ * @brief Copies a gsl_matrix_complex into a complexMatrix, rounding to single precision.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int gslParaMatrix(complexMatrix destino, const gsl_matrix_complex *origem)
+{
+    if (origem->size1 != (size_t)destino.linhas || origem->size2 != (size_t)destino.colunas)
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < destino.linhas; i++)
+    {
+        const double *fonte = origem->data + 2 * (size_t)i * origem->tda;
+        float *linha = (float *)matrixLinha(destino, i);
+
+        for (int j = 0; j < 2 * destino.colunas; j++)
+        {
+            linha[j] = (float)fonte[j];
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Freeing memory allocated for a complex matrix.
+ *
+ * The row pointers and the elements live in the same block, so a single release is enough.
+ * Views own nothing ('bloco' is NULL) and are left untouched.
+ *
+ * @param matrix The complexMatrix object to be freed.
+ */
+void freeComplexMatrix(complexMatrix matrix)
+{
+    matrixAlignedFree(matrix.bloco);
+}
+
+void printMatrix(complexMatrix matrix);
+
+/**
+ * @brief Decomposes a matrix with calc_svd and prints U, S and V^H.
+ */
+static void teste_imprime_svd(complexMatrix matrix)
+{
+    const int k = (matrix.linhas < matrix.colunas) ? matrix.linhas : matrix.colunas;
+    complexMatrix U = allocateComplexMatrix(matrix.linhas, k);
+    complexMatrix Vh = allocateComplexMatrix(k, matrix.colunas);
+    float *S = (float *)malloc((size_t)k * sizeof(float));
+
+    if (S == NULL)
+    {
+        printf("Falha na alocacao de memoria\n");
+        exit(1);
+    }
+
+    calc_svd(matrix, U, S, Vh);
+
+    printf("\nMatriz U:\n");
+    printMatrix(U);
+
+    printf("\nVetor S:\n");
+    for (int i = 0; i < k; i++)
+    {
+        printf("|%.2f|\n", S[i]);
+    }
+
+    printf("\nMatriz V^H:\n");
+    printMatrix(Vh);
+
+    free(S);
+    freeComplexMatrix(U);
+    freeComplexMatrix(Vh);
+}
+
+//! Function that will perform all the tests and print the results in the terminal
+void teste_calc_svd() {
+     /**
+     * @brief Test case 1: Matrix 3x2
+     *
+     * This test case focuses on a matrix of size 3x2. It demonstrates the process of allocating memory for the matrix.
+     */
+    printf("\n========= Matriz 3x2 =========\n");
+    
+    /**
+    * @brief Allocating memory for the matrix and putting values in it.
+    *
+    * This code snippet allocates memory for a complex matrix of size 3x2 using the `allocateComplexMatrix` function. It then assigns values to the elements of the matrix by iterating over the rows and columns.
+    */
+    complexMatrix matrixA = allocateComplexMatrix(3, 2);
+    
+    /** 
+     * @brief putting values in the matrix
+    */
+    for (int i = 0; i < matrixA.linhas; i++) {
+        for (int j = 0; j < matrixA.colunas; j++) {
+            matrixA.mtx[i][j].Re = i + j + 1;
+            matrixA.mtx[i][j].Im = i + j + 1.5;
+        }
+    }
+
+    printf("\nMatriz de entrada:\n");
+    for (int i = 0; i < matrixA.linhas; i++) {
+        for (int j = 0; j < matrixA.colunas; j++) {
+            if (j == 0) {
+                printf("|%.1f + %.1fi\t", matrixA.mtx[i][j].Re, matrixA.mtx[i][j].Im);
+            } else if (j == matrixA.colunas - 1) {
+                printf("%.1f + %.1fi|\t", matrixA.mtx[i][j].Re, matrixA.mtx[i][j].Im);
+            } else {
+                printf("%.1f + %.1fi\t", matrixA.mtx[i][j].Re, matrixA.mtx[i][j].Im);
+            }
+        }
+        printf("\n");
+    }
+    
+    printf("\n");
+    teste_imprime_svd(matrixA);
+    freeComplexMatrix(matrixA);
+    printf("\n");
+
+    /**
+     * @brief Test case 2: Matrix 4x4
+     *
+     * This test case focuses on a matrix of size 4x4. It demonstrates the process of allocating memory for the matrix and putting values in it.
+     */
+    printf("\n========= Matriz 4x4 =========\n");
+    complexMatrix matrixB = allocateComplexMatrix(4, 4);
+    
+    for (int i = 0; i < matrixB.linhas; i++) {
+        for (int j = 0; j < matrixB.colunas; j++) {
+            matrixB.mtx[i][j].Re = i + j + 3.2;
+            matrixB.mtx[i][j].Im = 0;
+        }
+    }
+
+    printf("\nMatriz de entrada:\n");
+    for (int i = 0; i < matrixB.linhas; i++) {
+        for (int j = 0; j < matrixB.colunas; j++) {
+            if (j == 0) {
+                printf("|%.1f\t", matrixB.mtx[i][j].Re);
+            } else if (j == matrixB.colunas - 1) {
+                printf("%.1f|\t", matrixB.mtx[i][j].Re);
+            } else {
+                printf("%.1f\t", matrixB.mtx[i][j].Re);
+            }
+        }
+        printf("\n");
+    }
+
+    teste_imprime_svd(matrixB);
+    freeComplexMatrix(matrixB);
+    printf("\n");
+
+    /**
+     * @brief Test case 3: Matrix 6x5
+     *
+     * This test case focuses on a matrix of size 6x5. It demonstrates the process of allocating memory for the matrix and putting values in it.
+     */
+    printf("\n========= Matriz 6x5 =========\n");
+    complexMatrix matrixC = allocateComplexMatrix(6, 5);
+    
+    for (int i = 0; i < matrixC.linhas; i++) {
+        for (int j = 0; j < matrixC.colunas; j++) {
+            matrixC.mtx[i][j].Re = i + j + 5;
+            matrixC.mtx[i][j].Im = 0;
+        }
+    }
+
+    printf("\nMatriz de entrada:\n");
+    for (int i = 0; i < matrixC.linhas; i++) {
+        for (int j = 0; j < matrixC.colunas; j++) {
+            if (j == 0) {
+                printf("|%.1f\t", matrixC.mtx[i][j].Re);
+            } else if (j == matrixC.colunas - 1) {
+                printf("%.1f|\t", matrixC.mtx[i][j].Re);
+            } else {
+                printf("%.1f\t", matrixC.mtx[i][j].Re);
+            }
+        }
+        printf("\n");
+    }
+    
+    teste_imprime_svd(matrixC);
+    freeComplexMatrix(matrixC);
+    printf("\n");
+
+    /**
+     * @brief Test case 4: Matrix 5x6
+     *
+     * This test case focuses on a matrix of size 5x6. It demonstrates the process of allocating memory for the matrix and putting values in it.
+     */
+    printf("\n========= Matriz 5x6 =========\n");
+    complexMatrix matrixD = allocateComplexMatrix(5, 6);
+    
+    for (int i = 0; i < matrixD.linhas; i++) {
+        for (int j = 0; j < matrixD.colunas; j++) {
+            matrixD.mtx[i][j].Re = i + j + 2.5;
+            matrixD.mtx[i][j].Im = 0;
+        }
+    }
+
+    printf("\nMatriz de entrada:\n");
+    for (int i = 0; i < matrixD.linhas; i++) {
+        for (int j = 0; j < matrixD.colunas; j++) {
+            if (j == 0) {
+                printf("|%.1f\t", matrixD.mtx[i][j].Re);
+            } else if (j == matrixD.colunas - 1) {
+                printf("%.1f|\t", matrixD.mtx[i][j].Re);
+            } else {
+                printf("%.1f\t", matrixD.mtx[i][j].Re);
+            }
+        }
+        printf("\n");
+    }
+
+    teste_imprime_svd(matrixD);
+    freeComplexMatrix(matrixD);
+    printf("\n");
+}
+
+/************************************* OPERATION FUNCTIONS ***************************************/
+
+/**
+ * @brief Terminates the program when the operands of a value-returning operation do not agree.
+ *
+ * @param [in] operacao Name of the operation, for the error message
+ */
+static void matrixErroDimensoes(const char *operacao)
+{
+    printf("Dimensoes incompativeis para a operacao %s\n", operacao);
+    exit(1);
+}
+
+/**
+ * @param[in] matrix The original matrix
+ * @param[out] transposta The transposed matrix
+ *
+ * @brief Creating a function to calculate the transposed matrix.
+ *
+ * This function takes the original matrix as input and calculates the transposed matrix. It allocates memory for the transposed matrix and then goes through each element of the original matrix, setting the corresponding element in the transposed matrix. The rows and columns are switched in the transposed matrix.
+ *
+ * @return The transposed matrix.
+ */
+complexMatrix matrixTransposta(complexMatrix matrix)
+{
+
+    /**
+     * @brief Allocating memory for the complex matrix.
+     */
+    complexMatrix transposta = allocateComplexMatrix(matrix.colunas, matrix.linhas);
+
+    //! Filling the transposed matrix in place of the freshly allocated one
+    matrixTranspostaEm(transposta, matrix);
+
+    return transposta;
+}
+
+
+/**
+ * @param[in] matrix The original matrix
+ * @param[out] conjugada The conjugate matrix
+ *
+ * @brief Creating a function to calculate the conjugate matrix.
+ *
+ * This function takes the original matrix as input and calculates the conjugate matrix. It allocates memory for the conjugate matrix and then iterates through each element of the original matrix, setting the corresponding element in the conjugate matrix. The imaginary part of each element is reversed in sign.
+ *
+ * @return The conjugate matrix.
+ */
+complexMatrix matrixConjugada(complexMatrix matrix)
+{
+
+    //! Allocating memory to the conjugate matrix (same shape as the original) using the allocateComplexMatrix function
+    complexMatrix conjugada = allocateComplexMatrix(matrix.linhas, matrix.colunas);
+
+    matrixConjugadaEm(conjugada, matrix);
+
+    //! Returning the conjugate matrix
+    return conjugada;
+}
+
+
+/**
+ * @param[in] transposta The transposed matrix
+ * @param[out] hermitiana The Hermitian matrix
+ *
+ * @brief Creating a function to calculate the Hermitian matrix.
+ *
+ * This function takes the transposed matrix as input and calculates the Hermitian matrix. It allocates memory for the Hermitian matrix and then iterates through each element of the transposed matrix, setting the corresponding element in the Hermitian matrix. The sign of the imaginary part of each element is reversed.
+ *
+ * @return The Hermitian matrix.
+ */
+complexMatrix matrixHermitiana(complexMatrix transposta)
+{
+
+     /**
+     * @brief Allocating memory for the Hermitian matrix using the allocateComplexMatrix function.
+     */
+    complexMatrix hermitiana = allocateComplexMatrix(transposta.linhas, transposta.colunas);
+
+    //! The transposition was already done by the caller, so only the conjugation is left
+    matrixConjugadaEm(hermitiana, transposta);
+
+    //! Returns the Hermitian matrix
+    return hermitiana;
+}
+
+/**
+ * @param[in] matrix1 The first matrix
+ * @param[in] matrix2 The second matrix
+ * @param[out] soma The sum matrix
+ *
+ * @brief Creating a function to calculate the sum of two matrices.
+ *
+ * This function takes two matrices, matrix1 and matrix2, as input and calculates the sum of the corresponding elements. It allocates memory for the sum matrix and then iterates through each element of matrix1 and matrix2, summing the corresponding elements and assigning the result to the sum matrix.
+ *
+ * @return The sum matrix.
+ */
+complexMatrix matrixSoma(complexMatrix matrix1, complexMatrix matrix2)
+{
+    /**
+    * @brief Allocating memory for the sum matrix using the allocateComplexMatrix function.
+    */
+    complexMatrix soma = allocateComplexMatrix(matrix1.linhas, matrix1.colunas);
+
+    if (matrixSomaEm(soma, matrix1, matrix2) != 0)
+    {
+        matrixErroDimensoes("soma");
+    }
+
+    //! Returning the sum matrix
+    return soma;
+}
+
+/**
+ * @param[in] matrix1 The first matrix
+ * @param[in] matrix2 The second matrix
+ * @param[out] subtracao The subtraction matrix
+ *
+ * @brief Creating a function to calculate the subtraction between two matrices.
+ *
+ * This function takes two matrices, matrix1 and matrix2, as input and calculates the subtraction of the corresponding elements. It allocates memory for the subtraction matrix and then iterates through each element of matrix1 and matrix2, subtracting the corresponding elements and assigning the result to the subtraction matrix.
+ *
+ * @return The subtraction matrix.
+ */
+complexMatrix matrixSubtracao(complexMatrix matrix1, complexMatrix matrix2)
+{
+
+    /**
+     * @brief Allocating memory for the subtraction matrix using the allocateComplexMatrix function.
+     */
+    complexMatrix subtracao = allocateComplexMatrix(matrix1.linhas, matrix1.colunas);
+
+    if (matrixSubtracaoEm(subtracao, matrix1, matrix2) != 0)
+    {
+        matrixErroDimensoes("subtracao");
+    }
+
+    //! Returning the subtraction matrix
+    return subtracao;
+}
+
+
+/**
+ * @param[in] matrix The original matrix
+ * @param[in] num The scalar number
+ * @param[out] produtoEscalar The result matrix after scalar multiplication
+ *
+ * @brief Creating a function to perform scalar multiplication with each element of the original matrix.
+ *
+ * This function takes a matrix, matrix, and a scalar number, num, as input and performs scalar multiplication by multiplying each element of the matrix by the scalar number. It allocates memory for the result matrix and then iterates through each element of the original matrix, multiplying the corresponding elements by the scalar number and assigning the result to the product matrix.
+ *
+ * @return The result matrix after scalar multiplication.
+ */
+complexMatrix matrix_produtoEscalar(complexMatrix matrix, float num)
+{
+    /**
+    * @brief Allocating memory for the result matrix of scalar multiplication using the allocateComplexMatrix function.
+    */
+    complexMatrix produtoEscalar = allocateComplexMatrix(matrix.linhas, matrix.colunas);
+
+    matrix_produtoEscalarEm(produtoEscalar, matrix, num);
+
+    //! Returning the result matrix after scalar multiplication.
+    return produtoEscalar;
+}
+
+/************************************* TRANSPOSITION KERNELS ***************************************/
+
+/*
+ * The transposes work on TRANSP_BLOCO x TRANSP_BLOCO tiles (8 KB of source and 8 KB of destination),
+ * so both the rows read and the rows written stay in L1 while the tile is processed. Inside a tile,
+ * 4x4 blocks are transposed in registers: a complex float has 64 bits, so a row of four complex
+ * numbers is one __m256d and the classic double-precision 4x4 transpose applies unchanged.
+ */
+#define TRANSP_BLOCO 32
+
+#if defined(__AVX2__) && defined(__FMA__)
+/**
+ * @brief Transposes (and optionally conjugates) the 4x4 block whose rows are r0..r3, in registers.
+ */
+static inline void transposta4x4(__m256d *r0, __m256d *r1, __m256d *r2, __m256d *r3, int conjuga)
+{
+    const __m256d t0 = _mm256_unpacklo_pd(*r0, *r1); //!< r0[0] r1[0] | r0[2] r1[2]
+    const __m256d t1 = _mm256_unpackhi_pd(*r0, *r1); //!< r0[1] r1[1] | r0[3] r1[3]
+    const __m256d t2 = _mm256_unpacklo_pd(*r2, *r3);
+    const __m256d t3 = _mm256_unpackhi_pd(*r2, *r3);
+
+    *r0 = _mm256_permute2f128_pd(t0, t2, 0x20);
+    *r1 = _mm256_permute2f128_pd(t1, t3, 0x20);
+    *r2 = _mm256_permute2f128_pd(t0, t2, 0x31);
+    *r3 = _mm256_permute2f128_pd(t1, t3, 0x31);
+
+    if (conjuga)
+    {
+        //! Flipping the sign bit of the imaginary parts (odd floats)
+        const __m256d sinal = _mm256_castps_pd(_mm256_set_ps(-0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f));
+        *r0 = _mm256_xor_pd(*r0, sinal);
+        *r1 = _mm256_xor_pd(*r1, sinal);
+        *r2 = _mm256_xor_pd(*r2, sinal);
+        *r3 = _mm256_xor_pd(*r3, sinal);
+    }
+}
+
+/**
+ * @brief Loads the 4x4 block at (i, j) of a matrix, one __m256d per row.
+ */
+static inline void carrega4x4(complexMatrix matrix, int i, int j, __m256d r[4])
+{
+    for (int k = 0; k < 4; k++)
+    {
+        r[k] = _mm256_loadu_pd((const double *)(matrixLinha(matrix, i + k) + j));
+    }
+}
+
+/**
+ * @brief Stores four __m256d as the rows of the 4x4 block at (i, j) of a matrix.
+ */
+static inline void guarda4x4(complexMatrix matrix, int i, int j, const __m256d r[4])
+{
+    for (int k = 0; k < 4; k++)
+    {
+        _mm256_storeu_pd((double *)(matrixLinha(matrix, i + k) + j), r[k]);
+    }
+}
+#endif
+
+/**
+ * @brief Writes the (conjugate) transpose of the element (i, j) of origem into destino.
+ */
+static inline void transpostaElemento(complexMatrix destino, complexMatrix origem, int i, int j, int conjuga)
+{
+    const complex z = MATRIX_ELEM(origem, i, j);
+
+    MATRIX_ELEM(destino, j, i).Re = z.Re;
+    MATRIX_ELEM(destino, j, i).Im = conjuga ? -z.Im : z.Im;
+}
+
+/**
+ * @brief Cache-blocked transpose (conjuga = 0) or conjugate transpose (conjuga = 1) of origem into destino.
+ *
+ * @param[out] destino The result (colunas x linhas of origem); must not overlap origem
+ * @param[in] origem The original matrix
+ * @param[in] conjuga Nonzero to conjugate the elements as well
+ */
+static void transpostaBlocada(complexMatrix destino, complexMatrix origem, int conjuga)
+{
+    for (int ib = 0; ib < origem.linhas; ib += TRANSP_BLOCO)
+    {
+        const int iFim = (ib + TRANSP_BLOCO < origem.linhas) ? ib + TRANSP_BLOCO : origem.linhas;
+
+        for (int jb = 0; jb < origem.colunas; jb += TRANSP_BLOCO)
+        {
+            const int jFim = (jb + TRANSP_BLOCO < origem.colunas) ? jb + TRANSP_BLOCO : origem.colunas;
+            int i = ib;
+
+#if defined(__AVX2__) && defined(__FMA__)
+            //! Full 4x4 blocks of the tile, transposed in registers
+            for (; i + 4 <= iFim; i += 4)
+            {
+                int j = jb;
+
+                for (; j + 4 <= jFim; j += 4)
+                {
+                    __m256d r[4];
+
+                    carrega4x4(origem, i, j, r);
+                    transposta4x4(&r[0], &r[1], &r[2], &r[3], conjuga);
+                    guarda4x4(destino, j, i, r);
+                }
+                for (; j < jFim; j++)
+                {
+                    for (int k = 0; k < 4; k++)
+                    {
+                        transpostaElemento(destino, origem, i + k, j, conjuga);
+                    }
+                }
+            }
+#endif
+            //! Remaining rows of the tile (or the whole tile without AVX2)
+            for (; i < iFim; i++)
+            {
+                for (int j = jb; j < jFim; j++)
+                {
+                    transpostaElemento(destino, origem, i, j, conjuga);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief In-place transpose (conjuga = 0) or conjugate transpose (conjuga = 1) of a square matrix.
+ *
+ * Blocks (i, j) and (j, i) are swapped while being transposed, tile by tile; the blocks on the
+ * diagonal are transposed onto themselves.
+ *
+ * @param[in,out] matrix The square matrix
+ * @param[in] conjuga Nonzero to conjugate the elements as well
+ */
+static void transpostaInPlace(complexMatrix matrix, int conjuga)
+{
+    const int n = matrix.linhas;
+    int fim4 = 0;
+
+#if defined(__AVX2__) && defined(__FMA__)
+    //! Part of the matrix covered by whole 4x4 blocks
+    fim4 = n / 4 * 4;
+
+    for (int ib = 0; ib < fim4; ib += TRANSP_BLOCO)
+    {
+        const int iFim = (ib + TRANSP_BLOCO < fim4) ? ib + TRANSP_BLOCO : fim4;
+
+        for (int jb = ib; jb < fim4; jb += TRANSP_BLOCO)
+        {
+            const int jFim = (jb + TRANSP_BLOCO < fim4) ? jb + TRANSP_BLOCO : fim4;
+
+            for (int i = ib; i < iFim; i += 4)
+            {
+                for (int j = (jb == ib) ? i : jb; j < jFim; j += 4)
+                {
+                    __m256d a[4], b[4];
+
+                    carrega4x4(matrix, i, j, a);
+                    transposta4x4(&a[0], &a[1], &a[2], &a[3], conjuga);
+
+                    if (i == j)
+                    {
+                        guarda4x4(matrix, i, i, a);
+                        continue;
+                    }
+
+                    carrega4x4(matrix, j, i, b);
+                    transposta4x4(&b[0], &b[1], &b[2], &b[3], conjuga);
+                    guarda4x4(matrix, j, i, a);
+                    guarda4x4(matrix, i, j, b);
+                }
+            }
+        }
+    }
+#endif
+
+    //! Elements outside the 4x4 blocks: the last rows and columns (or the whole matrix without AVX2)
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = (i < fim4) ? fim4 : i; j < n; j++)
+        {
+            complex a = MATRIX_ELEM(matrix, i, j);
+            complex b = MATRIX_ELEM(matrix, j, i);
+
+            if (conjuga)
+            {
+                a.Im = -a.Im;
+                b.Im = -b.Im;
+            }
+            MATRIX_ELEM(matrix, i, j) = b;
+            MATRIX_ELEM(matrix, j, i) = a;
+        }
+    }
+}
+
+/************************************* ALLOCATION-FREE OPERATION FUNCTIONS ***************************************/
+/*
+ * The functions below write their result into a matrix provided by the caller ('destino'), so a
+ * processing loop can reuse the same buffers and perform no heap allocation at all. They return 0
+ * on success and -1 when the dimensions do not agree (nothing is written in that case).
+ * For the element-wise operations 'destino' may be one of the operands, which gives the in-place forms.
+ */
+
+/**
+ * @brief Checks that two matrices have the same number of rows and columns.
+ */
+static int matrixMesmaForma(complexMatrix a, complexMatrix b)
+{
+    return a.linhas == b.linhas && a.colunas == b.colunas;
+}
+
+/**
+ * @param[out] destino The sum matrix
+ * @param[in] matrix1 The first matrix
+ * @param[in] matrix2 The second matrix
+ *
+ * @brief Writes matrix1 + matrix2 into destino.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixSomaEm(complexMatrix destino, complexMatrix matrix1, complexMatrix matrix2)
+{
+    if (!matrixMesmaForma(destino, matrix1) || !matrixMesmaForma(matrix1, matrix2))
+    {
+        return -1;
+    }
+
+    int linhas;
+    size_t colunas;
+    matrixPercurso(destino, matrix1, matrix2, &linhas, &colunas);
+
+    for (int l = 0; l < linhas; l++)
+    {
+        complex *d = matrixLinha(destino, l);
+        const complex *a = matrixLinha(matrix1, l);
+        const complex *b = matrixLinha(matrix2, l);
+
+        for (size_t c = 0; c < colunas; c++)
+        {
+            //! Summing the corresponding elements and assigning the result to the sum matrix
+            d[c].Re = a[c].Re + b[c].Re;
+            d[c].Im = a[c].Im + b[c].Im;
+        }
+    }
+
+    return 0;
+}
+
 /**
+ * @param[out] destino The subtraction matrix
+ * @param[in] matrix1 The first matrix
+ * @param[in] matrix2 The matrix subtracted from matrix1
  *
- * @param [in] linhas
- * @param [in] colunas
- * @param [out] matrix
+ * @brief Writes matrix1 - matrix2 into destino.
  *
+ * @return 0 on success, -1 if the dimensions do not agree.
  */
+int matrixSubtracaoEm(complexMatrix destino, complexMatrix matrix1, complexMatrix matrix2)
+{
+    if (!matrixMesmaForma(destino, matrix1) || !matrixMesmaForma(matrix1, matrix2))
+    {
+        return -1;
+    }
 
-//! Creating a function whose purpose is to dynamically allocate memory for the complex matrix
-complexMatrix allocateComplexMatrix(int linhas, int colunas) {
+    int linhas;
+    size_t colunas;
+    matrixPercurso(destino, matrix1, matrix2, &linhas, &colunas);
 
-    //! Declaring the matrix variable of type ComplexMatrix
-    complexMatrix matrix;
+    for (int l = 0; l < linhas; l++)
+    {
+        complex *d = matrixLinha(destino, l);
+        const complex *a = matrixLinha(matrix1, l);
+        const complex *b = matrixLinha(matrix2, l);
 
-    //! The complexMatrix type variable has rows and columns "attributes" and must receive them as parameters
-    matrix.linhas = linhas;
-    matrix.colunas = colunas;
+        for (size_t c = 0; c < colunas; c++)
+        {
+            //! Subtracting the corresponding elements and assigning the result to the subtraction matrix
+            d[c].Re = a[c].Re - b[c].Re;
+            d[c].Im = a[c].Im - b[c].Im;
+        }
+    }
 
-    //! Allocating memory for matrix lines
-    matrix.mtx = (complex **)malloc(linhas * sizeof(complex *));
+    return 0;
+}
 
-   /**
- * @brief Handles possible errors when trying to allocate memory to the rows of a matrix.
+/**
+ * @param[out] destino The result matrix after scalar multiplication
+ * @param[in] matrix The original matrix
+ * @param[in] num The scalar number
+ *
+ * @brief Writes num * matrix into destino.
  *
- * This code checks if the memory allocation for the rows of the matrix was successful. If the allocation failed, it prints an error message and terminates the program with an exit code of 1.
+ * @return 0 on success, -1 if the dimensions do not agree.
  */
-if (matrix.mtx == NULL)
+int matrix_produtoEscalarEm(complexMatrix destino, complexMatrix matrix, float num)
 {
-    printf("Falha na alocacao de memoria\n");
-    exit(1);
+    if (!matrixMesmaForma(destino, matrix))
+    {
+        return -1;
+    }
+
+    int linhas;
+    size_t colunas;
+    matrixPercurso(destino, matrix, matrix, &linhas, &colunas);
+
+    for (int l = 0; l < linhas; l++)
+    {
+        complex *d = matrixLinha(destino, l);
+        const complex *origem = matrixLinha(matrix, l);
+
+        for (size_t c = 0; c < colunas; c++)
+        {
+            //! Multiplying the scalar number to each element of the original matrix
+            d[c].Re = origem[c].Re * num;
+            d[c].Im = origem[c].Im * num;
+        }
+    }
+
+    return 0;
 }
 
-    /**
- * @brief Allocates memory for the columns of each line in the matrix.
+/**
+ * @param[out] destino The conjugate matrix
+ * @param[in] matrix The original matrix
+ *
+ * @brief Writes the conjugate of matrix into destino.
  *
- * This code iterates over each row of the matrix and allocates memory for the columns of each line. It uses the `malloc` function to allocate memory for an array of `colunas` complex numbers (`complex`).
+ * @return 0 on success, -1 if the dimensions do not agree.
  */
+int matrixConjugadaEm(complexMatrix destino, complexMatrix matrix)
+{
+    if (!matrixMesmaForma(destino, matrix))
+    {
+        return -1;
+    }
+
+    int linhas;
+    size_t colunas;
+    matrixPercurso(destino, matrix, matrix, &linhas, &colunas);
+
     for (int i = 0; i < linhas; i++)
     {
-        matrix.mtx[i] = (complex *)malloc(colunas * sizeof(complex));
+        complex *d = matrixLinha(destino, i);
+        const complex *origem = matrixLinha(matrix, i);
 
-       /**
- * @brief Handles possible errors when allocating memory to the columns of each line in the matrix.
- *
- * This code checks if the memory allocation for the columns of each line in the matrix was successful. If the allocation failed (for example: `matrix.mtx[i]` is `NULL`), it prints an error message and terminates the program with an exit code of 1.
- */
-        if (matrix.mtx[i] == NULL)
+        for (size_t j = 0; j < colunas; j++)
         {
-            printf("Falha na alocação de memória\n");
-            exit(1);
+            d[j].Re = origem[j].Re;
+            d[j].Im = -origem[j].Im; /*!< Reverses the sign of the imaginary part*/
         }
     }
 
-    //! Returning matrix
-    return matrix;
+    return 0;
 }
 
-/************************ SVD CALCULATION FUNCTIONS **************************/
 /**
- * @brief Performs the implementation for Singular Value Decomposition (SVD) calculation.
- * @param [in] matrix
-*/
-
-/// This function does the implementation for the SVD calculation
-void calc_svd(complexMatrix matrix) 
-{
-    
-    int i = 0;
-    int j = 0;
-
-    /**
- * @brief Checks if the matrix is complex.
+ * @param[out] destino The transposed matrix (colunas x linhas of 'matrix'); must not overlap 'matrix'
+ * @param[in] matrix The original matrix
+ *
+ * @brief Writes the transpose of matrix into destino.
  *
- * This code snippet checks if the elements in the matrix are complex numbers. It specifically checks if the imaginary part (`Im`) of an element at position `matrix.mtx[i][j]` is non-zero. If it is non-zero, the code prints a message indicating that the matrix is complex, and therefore, only the real part will be used for SVD calculation.
+ * @return 0 on success, -1 if the dimensions do not agree.
  */
-    if (matrix.mtx[i][j].Im != 0) {
-        printf("A matriz e complexa, portanto sera calculado o SVD apenas da parte real.\n");
+int matrixTranspostaEm(complexMatrix destino, complexMatrix matrix)
+{
+    if (destino.linhas != matrix.colunas || destino.colunas != matrix.linhas)
+    {
+        return -1;
     }
 
+    //! Switching the rows and columns positions tile by tile, so neither side is walked with a large stride
+    transpostaBlocada(destino, matrix, 0);
 
-   /**
- * @brief Generates a GSL matrix using the real part of the complex matrix.
+    return 0;
+}
+
+/**
+ * @param[out] destino The Hermitian matrix (colunas x linhas of 'matrix'); must not overlap 'matrix'
+ * @param[in] matrix The original matrix
  *
- * This code snippet allocates memory for a GSL matrix (`gsl_matrix`) with the same number of rows and columns as the complex matrix (`matrix`). The matrix is allocated using the `gsl_matrix_alloc` function from the GSL. It is intended to be used for storing the real part of the complex matrix during further computations.
+ * @brief Writes the conjugate transpose of matrix into destino in a single pass.
  *
- * @param matrix The complexMatrix object from which the real part will be extracted to generate the GSL matrix.
+ * Unlike matrixHermitiana, which expects an already transposed matrix, this function takes the
+ * original matrix and transposes and conjugates it at once, without any temporary copy.
  *
- * @return A pointer to the allocated GSL matrix.
+ * @return 0 on success, -1 if the dimensions do not agree.
  */
-gsl_matrix* gslMatrix = gsl_matrix_alloc(matrix.linhas, matrix.colunas);
+int matrixHermitianaEm(complexMatrix destino, complexMatrix matrix)
+{
+    if (destino.linhas != matrix.colunas || destino.colunas != matrix.linhas)
+    {
+        return -1;
+    }
 
-    /**
- * @brief Assigns the values of the real part of the parameter matrix to the gslMatrix matrix.
+    transpostaBlocada(destino, matrix, 1);
+
+    return 0;
+}
+
+/**
+ * @param[in,out] matrix The square matrix to be transposed
  *
- * This code snippet iterates over the rows and columns of the `matrix` parameter and assigns the real part of each element to the corresponding position in the `gslMatrix` matrix using the `gsl_matrix_set` function.
+ * @brief Transposes a square matrix in place, without any temporary copy.
  *
- * @param gslMatrix The gsl_matrix object to which the values will be assigned.
- * @param matrix The complexMatrix parameter from which the real part values will be extracted.
+ * @return 0 on success, -1 if the matrix is not square.
  */
-    for (i = 0; i < matrix.linhas; i++) {
-        for (j=0; j < matrix.colunas; j++){
-        gsl_matrix_set(gslMatrix, i, j, matrix.mtx[i][j].Re);
+int matrixTranspostaInPlace(complexMatrix matrix)
+{
+    if (matrix.linhas != matrix.colunas)
+    {
+        return -1;
     }
+
+    transpostaInPlace(matrix, 0);
+
+    return 0;
 }
 
-    /**
- * @brief Performing SVD decomposition.
+/**
+ * @param[in,out] matrix The square matrix to be replaced by its conjugate transpose
  *
- * This code snippet performs Singular Value Decomposition (SVD) on the provided matrix. It allocates memory for the required GSL objects and performs the SVD decomposition using the GSL library.
+ * @brief Replaces a square matrix by its conjugate transpose, without any temporary copy.
  *
- * @param matrix The complexMatrix object on which the SVD decomposition will be performed.
- * @param A The GSL matrix object allocated for SVD decomposition.
- * @param V The GSL matrix object allocated for SVD decomposition.
- * @param S The GSL vector object allocated for SVD decomposition.
- * @param work The GSL vector object allocated for SVD decomposition.
+ * @return 0 on success, -1 if the matrix is not square.
  */
-    gsl_matrix *A = gsl_matrix_alloc(matrix.linhas, matrix.colunas);
-    gsl_matrix *V = gsl_matrix_alloc(matrix.colunas, matrix.colunas);
-    gsl_vector *S = gsl_vector_alloc(matrix.colunas);
-    gsl_vector *work = gsl_vector_alloc(matrix.colunas);
+int matrixHermitianaInPlace(complexMatrix matrix)
+{
+    if (matrix.linhas != matrix.colunas)
+    {
+        return -1;
+    }
 
-   /**
- * @brief Calling the function that performs SVD calculation.
+    transpostaInPlace(matrix, 1);
+
+    return 0;
+}
+
+/**
+ * @brief In-place sum, matrix1 += matrix2.
  *
- * This code snippet calls the GSL function gsl_linalg_SV_decomp to perform the Singular Value Decomposition (SVD) calculation. The function takes the GSL matrix A, GSL matrix V, GSL vector S, and GSL vector work as arguments.
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixSomaInPlace(complexMatrix matrix1, complexMatrix matrix2)
+{
+    return matrixSomaEm(matrix1, matrix1, matrix2);
+}
+
+/**
+ * @brief In-place subtraction, matrix1 -= matrix2.
  *
- * @param A The GSL matrix object for SVD decomposition.
- * @param V The GSL matrix object for SVD decomposition.
- * @param S The GSL vector object for SVD decomposition.
- * @param work The GSL vector object for SVD decomposition.
+ * @return 0 on success, -1 if the dimensions do not agree.
  */
-    gsl_linalg_SV_decomp(A, V, S, work);
+int matrixSubtracaoInPlace(complexMatrix matrix1, complexMatrix matrix2)
+{
+    return matrixSubtracaoEm(matrix1, matrix1, matrix2);
+}
 
-    /**
- * @brief Printing the results of SVD decomposition.
- *
- * This code snippet prints the results of the Singular Value Decomposition (SVD) calculation. It prints the matrix A, vector S, and matrix V using the GSL library functions and appropriate formatting.
- */
-    printf("\nMatrix A:\n");
-    for (i = 0; i < A->size1; i++) {
-        for (j = 0; j < A->size2; j++) {
-            if(j ==0){
-            printf("|%.2f\t", gsl_matrix_get(A, i, j));
-        } else if (j == A->size2 - 1) {
-            printf("%.2f|\t", gsl_matrix_get(A, i, j));
-        } else {
-            printf("%.2f\t", gsl_matrix_get(A, i, j));
-        }
-    }
-    printf("\n");
+/**
+ * @brief In-place scalar product, matrix *= num.
+ */
+void matrix_produtoEscalarInPlace(complexMatrix matrix, float num)
+{
+    matrix_produtoEscalarEm(matrix, matrix, num);
 }
 
-printf("\nVetor S:\n");
-for (int i = 0; i < S->size; i++) {
-    printf("|%.2f|\n", gsl_vector_get(S, i));
+/**
+ * @brief In-place conjugation: reverses the sign of the imaginary part of every element.
+ */
+void matrixConjugadaInPlace(complexMatrix matrix)
+{
+    matrixConjugadaEm(matrix, matrix);
 }
 
-printf("\nMatriz V:\n");
-for (int i = 0; i < V->size1; i++) {
-    for (int j = 0; j < V->size2; j++) {
-        if (j == 0) {
-            printf("|%.2f\t", gsl_matrix_get(V, i, j));
-        } else if (j == V->size2 - 1) {
-            printf("%.2f|\t", gsl_matrix_get(V, i, j));
-            }
-            else{
-                printf("%.2f\t", gsl_matrix_get(V, i, j));
+/************************************* MATRIX MULTIPLICATION (GEMM) ***************************************/
+
+/*
+ * Blocking parameters of the complex GEMM, in complex elements.
+ * A KC x NC panel of B is packed once and reused by every MR-row strip of A, so it stays in L2,
+ * while the MR x NR tile of C lives in registers during the whole KC loop.
+ */
+#define GEMM_MR 4    /*!< Rows of C computed by the micro-kernel */
+#define GEMM_NR 8    /*!< Columns of C computed by the micro-kernel */
+#define GEMM_KC 128  /*!< Depth of a packed panel */
+#define GEMM_NC 256  /*!< Columns of a packed panel */
+
+/*
+ * Below this number of multiply-adds the packing does not pay off and the plain loops are used.
+ */
+#define GEMM_LIMIAR_PEQUENO (32 * 32 * 32)
+
+/*
+ * How each operand enters the product: as stored, or conjugate transposed (op(X) = X^H).
+ */
+#define GEMM_N 0  /*!< Operand used as stored */
+#define GEMM_H 1  /*!< Operand used conjugate transposed, read directly from the original storage */
+
+/**
+ * @brief Plain i-k-j complex product, used for small matrices such as 4x3 channels.
+ *
+ * The inner loop walks a row of B and a row of C contiguously, so it is cache friendly and the
+ * compiler is free to vectorize it.
+ *
+ * @param[out] produto The result matrix (linhas of A x colunas of B)
+ * @param[in] matrix1 The left matrix A
+ * @param[in] matrix2 The right matrix B
+ */
+static void gemmPequeno(complexMatrix produto, complexMatrix matrix1, complexMatrix matrix2)
+{
+    for (int i = 0; i < matrix1.linhas; i++)
+    {
+        complex *c = matrixLinha(produto, i);
+        const complex *a = matrixLinha(matrix1, i);
+
+        for (int j = 0; j < produto.colunas; j++)
+        {
+            c[j].Re = 0.0f;
+            c[j].Im = 0.0f;
+        }
+
+        for (int k = 0; k < matrix1.colunas; k++)
+        {
+            const float ar = a[k].Re;
+            const float ai = a[k].Im;
+            const complex *b = matrixLinha(matrix2, k);
+
+            for (int j = 0; j < produto.colunas; j++)
+            {
+                //! (ar + i ai)(br + i bi) = (ar br - ai bi) + i (ar bi + ai br)
+                c[j].Re += ar * b[j].Re - ai * b[j].Im;
+                c[j].Im += ar * b[j].Im + ai * b[j].Re;
             }
         }
-        printf("\n");
     }
-    
-    /**
- * @brief Releasing memory allocated for GSL objects.
+}
+
+/**
+ * @brief Small A^H * B as a sum of rank-1 updates, one per row k of A and B.
  *
- * This code snippet releases the memory allocated for the GSL objects used in the SVD decomposition. It frees the memory for the GSL matrices A and V, GSL vector S and work, and the GSL matrix gslMatrix.
+ * Row k of A and row k of B are both contiguous, so A^H is never formed. When 'triangular' is set
+ * (Gram matrix, A == B), only the upper triangle j >= i is accumulated.
  *
- * @param A The GSL matrix object to be freed.
- * @param V The GSL matrix object to be freed.
- * @param S The GSL vector object to be freed.
- * @param work The GSL vector object to be freed.
- * @param gslMatrix The GSL matrix object to be freed.
+ * @param[out] produto The result matrix (colunas of A x colunas of B)
+ * @param[in] matrix1 The matrix A (k x m)
+ * @param[in] matrix2 The matrix B (k x n)
+ * @param[in] triangular Nonzero to compute only the upper triangle
  */
-    gsl_matrix_free(A);
-    gsl_matrix_free(V);
-    gsl_vector_free(S);
-    gsl_vector_free(work);
-    gsl_matrix_free(gslMatrix);
+static void gemmPequenoAhB(complexMatrix produto, complexMatrix matrix1, complexMatrix matrix2, int triangular)
+{
+    for (int i = 0; i < produto.linhas; i++)
+    {
+        complex *c = matrixLinha(produto, i);
+        for (int j = 0; j < produto.colunas; j++)
+        {
+            c[j].Re = 0.0f;
+            c[j].Im = 0.0f;
+        }
+    }
+
+    for (int k = 0; k < matrix1.linhas; k++)
+    {
+        const complex *a = matrixLinha(matrix1, k);
+        const complex *b = matrixLinha(matrix2, k);
+
+        for (int i = 0; i < produto.linhas; i++)
+        {
+            //! conj(a) = ar - i ai
+            const float ar = a[i].Re;
+            const float ai = -a[i].Im;
+            complex *c = matrixLinha(produto, i);
+
+            for (int j = triangular ? i : 0; j < produto.colunas; j++)
+            {
+                c[j].Re += ar * b[j].Re - ai * b[j].Im;
+                c[j].Im += ar * b[j].Im + ai * b[j].Re;
+            }
+        }
+    }
 }
 
 /**
- * @brief Freeing memory allocated for a complex matrix.
+ * @brief Small A * B^H, where every element is the dot product of a row of A and a row of B.
  *
- * This function frees the memory allocated for a complex matrix by iterating over its rows and then freeing the memory for each row.
- *
- * @param matrix The complexMatrix object to be freed.
+ * @param[out] produto The result matrix (linhas of A x linhas of B)
+ * @param[in] matrix1 The matrix A (m x k)
+ * @param[in] matrix2 The matrix B (n x k)
  */
-void freeComplexMatrix(complexMatrix matrix)
+static void gemmPequenoABh(complexMatrix produto, complexMatrix matrix1, complexMatrix matrix2)
 {
-    for (int i = 0; i < matrix.linhas; i++) {
-        free(matrix.mtx[i]);
+    for (int i = 0; i < produto.linhas; i++)
+    {
+        const complex *a = matrixLinha(matrix1, i);
+        complex *c = matrixLinha(produto, i);
+
+        for (int j = 0; j < produto.colunas; j++)
+        {
+            const complex *b = matrixLinha(matrix2, j);
+            float re = 0.0f, im = 0.0f;
+
+            for (int k = 0; k < matrix1.colunas; k++)
+            {
+                //! a * conj(b) = (ar br + ai bi) + i (ai br - ar bi)
+                re += a[k].Re * b[k].Re + a[k].Im * b[k].Im;
+                im += a[k].Im * b[k].Re - a[k].Re * b[k].Im;
+            }
+            c[j].Re = re;
+            c[j].Im = im;
+        }
     }
-    free(matrix.mtx);
 }
 
-//! Function that will perform all the tests and print the results in the terminal
-void teste_calc_svd() {
-     /**
-     * @brief Test case 1: Matrix 3x2
-     *
-     * This test case focuses on a matrix of size 3x2. It demonstrates the process of allocating memory for the matrix.
-     */
-    printf("\n========= Matriz 3x2 =========\n");
-    
-    /**
-    * @brief Allocating memory for the matrix and putting values in it.
-    *
-    * This code snippet allocates memory for a complex matrix of size 3x2 using the `allocateComplexMatrix` function. It then assigns values to the elements of the matrix by iterating over the rows and columns.
-    */
-    complexMatrix matrixA = allocateComplexMatrix(3, 2);
-    
-    /** 
-     * @brief putting values in the matrix
-    */
-    for (int i = 0; i < matrixA.linhas; i++) {
-        for (int j = 0; j < matrixA.colunas; j++) {
-            matrixA.mtx[i][j].Re = i + j + 1;
-            matrixA.mtx[i][j].Im = i + j + 1.5;
-        }
+//! Key that owns the packing buffer of each thread: its destructor frees the buffer when the thread
+//! exits, so the threads of the pool do not leak it when they are joined
+static pthread_key_t gemmChavePacote;
+static pthread_once_t gemmChaveCriada = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Creates gemmChavePacote (called once, through pthread_once).
+ */
+static void gemmCriaChave(void)
+{
+    if (pthread_key_create(&gemmChavePacote, matrixAlignedFree) != 0)
+    {
+        printf("Falha na criacao da chave de thread\n");
+        exit(1);
     }
+}
 
-    printf("\nMatriz de entrada:\n");
-    for (int i = 0; i < matrixA.linhas; i++) {
-        for (int j = 0; j < matrixA.colunas; j++) {
-            if (j == 0) {
-                printf("|%.1f + %.1fi\t", matrixA.mtx[i][j].Re, matrixA.mtx[i][j].Im);
-            } else if (j == matrixA.colunas - 1) {
-                printf("%.1f + %.1fi|\t", matrixA.mtx[i][j].Re, matrixA.mtx[i][j].Im);
-            } else {
-                printf("%.1f + %.1fi\t", matrixA.mtx[i][j].Re, matrixA.mtx[i][j].Im);
+/**
+ * @brief Packs a kc x nc block of op(B) into panels of GEMM_NR columns.
+ *
+ * For every k, a panel holds the GEMM_NR elements (br, bi) followed by the same elements rotated
+ * by i, (-bi, br). With both forms at hand the micro-kernel computes a complex product with two
+ * fused multiply-adds on a single accumulator, without any shuffle. Columns past nc are zero.
+ * When op(B) = B^H, element (k, j) is read as conj(B[j][k]), so the conjugate transpose is never formed.
+ *
+ * @param[out] pacote Destination buffer (ceil(nc / GEMM_NR) * kc * 4 * GEMM_NR floats)
+ * @param[in] matrix2 The matrix B
+ * @param[in] op2 GEMM_N or GEMM_H
+ * @param[in] k0, j0 First row and column of the block of op(B)
+ * @param[in] kc, nc Size of the block
+ */
+static void gemmEmpacotaB(float *pacote, complexMatrix matrix2, int op2, int k0, int j0, int kc, int nc)
+{
+    for (int jr = 0; jr < nc; jr += GEMM_NR)
+    {
+        const int nr = (nc - jr < GEMM_NR) ? nc - jr : GEMM_NR;
+
+        for (int k = 0; k < kc; k++)
+        {
+            float *direto = pacote;
+            float *girado = pacote + 2 * GEMM_NR;
+
+            for (int j = 0; j < GEMM_NR; j++)
+            {
+                float br = 0.0f, bi = 0.0f;
+
+                if (j < nr && op2 == GEMM_N)
+                {
+                    const complex b = MATRIX_ELEM(matrix2, k0 + k, j0 + jr + j);
+                    br = b.Re;
+                    bi = b.Im;
+                }
+                else if (j < nr)
+                {
+                    const complex b = MATRIX_ELEM(matrix2, j0 + jr + j, k0 + k);
+                    br = b.Re;
+                    bi = -b.Im;
+                }
+
+                direto[2 * j] = br;
+                direto[2 * j + 1] = bi;
+                girado[2 * j] = -bi;
+                girado[2 * j + 1] = br;
             }
+            pacote += 4 * GEMM_NR;
         }
-        printf("\n");
     }
-    
-    printf("\n");
-    calc_svd(matrixA);
-    printf("\n");
+}
 
-    /**
-     * @brief Test case 2: Matrix 4x4
-     *
-     * This test case focuses on a matrix of size 4x4. It demonstrates the process of allocating memory for the matrix and putting values in it.
-     */
-    printf("\n========= Matriz 4x4 =========\n");
-    complexMatrix matrixB = allocateComplexMatrix(4, 4);
-    
-    for (int i = 0; i < matrixB.linhas; i++) {
-        for (int j = 0; j < matrixB.linhas; j++) {
-            matrixB.mtx[i][j].Re = i + j + 3.2;
-            matrixB.mtx[i][j].Im = 0;
-        }
+#if defined(__AVX2__) && defined(__FMA__)
+/**
+ * @brief AVX2/FMA micro-kernel: tile[GEMM_MR][GEMM_NR] = A(GEMM_MR x kc) * packed panel.
+ *
+ * Each __m256 holds four interleaved complex numbers. For every k, the real and imaginary parts of
+ * A are broadcast and multiplied by the direct and rotated copies of the panel, accumulating the
+ * complex product in 8 registers.
+ */
+static void gemmMicroKernel(int kc, const complex *const *a, const float *pacote, complex *tile)
+{
+    __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+    __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+    __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+    __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+
+    for (int k = 0; k < kc; k++)
+    {
+        const __m256 b0 = _mm256_load_ps(pacote);
+        const __m256 b1 = _mm256_load_ps(pacote + 8);
+        const __m256 s0 = _mm256_load_ps(pacote + 16);
+        const __m256 s1 = _mm256_load_ps(pacote + 24);
+        __m256 ar, ai;
+
+        ar = _mm256_broadcast_ss(&a[0][k].Re);
+        ai = _mm256_broadcast_ss(&a[0][k].Im);
+        c00 = _mm256_fmadd_ps(ai, s0, _mm256_fmadd_ps(ar, b0, c00));
+        c01 = _mm256_fmadd_ps(ai, s1, _mm256_fmadd_ps(ar, b1, c01));
+
+        ar = _mm256_broadcast_ss(&a[1][k].Re);
+        ai = _mm256_broadcast_ss(&a[1][k].Im);
+        c10 = _mm256_fmadd_ps(ai, s0, _mm256_fmadd_ps(ar, b0, c10));
+        c11 = _mm256_fmadd_ps(ai, s1, _mm256_fmadd_ps(ar, b1, c11));
+
+        ar = _mm256_broadcast_ss(&a[2][k].Re);
+        ai = _mm256_broadcast_ss(&a[2][k].Im);
+        c20 = _mm256_fmadd_ps(ai, s0, _mm256_fmadd_ps(ar, b0, c20));
+        c21 = _mm256_fmadd_ps(ai, s1, _mm256_fmadd_ps(ar, b1, c21));
+
+        ar = _mm256_broadcast_ss(&a[3][k].Re);
+        ai = _mm256_broadcast_ss(&a[3][k].Im);
+        c30 = _mm256_fmadd_ps(ai, s0, _mm256_fmadd_ps(ar, b0, c30));
+        c31 = _mm256_fmadd_ps(ai, s1, _mm256_fmadd_ps(ar, b1, c31));
+
+        pacote += 4 * GEMM_NR;
     }
 
-    printf("\nMatriz de entrada:\n");
-    for (int i = 0; i < matrixB.linhas; i++) {
-        for (int j = 0; j < matrixB.colunas; j++) {
-            if (j == 0) {
-                printf("|%.1f\t", matrixB.mtx[i][j].Re);
-            } else if (j == matrixB.colunas - 1) {
-                printf("%.1f|\t", matrixB.mtx[i][j].Re);
-            } else {
-                printf("%.1f\t", matrixB.mtx[i][j].Re);
+    float *t = (float *)tile;
+    _mm256_storeu_ps(t + 0, c00);
+    _mm256_storeu_ps(t + 8, c01);
+    _mm256_storeu_ps(t + 16, c10);
+    _mm256_storeu_ps(t + 24, c11);
+    _mm256_storeu_ps(t + 32, c20);
+    _mm256_storeu_ps(t + 40, c21);
+    _mm256_storeu_ps(t + 48, c30);
+    _mm256_storeu_ps(t + 56, c31);
+}
+#else
+/**
+ * @brief Portable micro-kernel: tile[GEMM_MR][GEMM_NR] = A(GEMM_MR x kc) * packed panel.
+ */
+static void gemmMicroKernel(int kc, const complex *const *a, const float *pacote, complex *tile)
+{
+    float acc[GEMM_MR][2 * GEMM_NR] = {{0.0f}};
+
+    for (int k = 0; k < kc; k++)
+    {
+        for (int r = 0; r < GEMM_MR; r++)
+        {
+            const float ar = a[r][k].Re;
+            const float ai = a[r][k].Im;
+
+            for (int j = 0; j < 2 * GEMM_NR; j++)
+            {
+                acc[r][j] += ar * pacote[j] + ai * pacote[2 * GEMM_NR + j];
             }
         }
-        printf("\n");
+        pacote += 4 * GEMM_NR;
     }
 
-    calc_svd(matrixB);
-    printf("\n");
-
-    /**
-     * @brief Test case 3: Matrix 6x5
-     *
-     * This test case focuses on a matrix of size 6x5. It demonstrates the process of allocating memory for the matrix and putting values in it.
-     */
-    printf("\n========= Matriz 6x5 =========\n");
-    complexMatrix matrixC = allocateComplexMatrix(6, 5);
-    
-    for (int i = 0; i < matrixC.linhas; i++) {
-        for (int j = 0; j < matrixC.linhas; j++) {
-            matrixC.mtx[i][j].Re = i + j + 5;
-            matrixC.mtx[i][j].Im = 0;
+    for (int r = 0; r < GEMM_MR; r++)
+    {
+        for (int j = 0; j < GEMM_NR; j++)
+        {
+            tile[r * GEMM_NR + j].Re = acc[r][2 * j];
+            tile[r * GEMM_NR + j].Im = acc[r][2 * j + 1];
         }
     }
+}
+#endif
 
-    printf("\nMatriz de entrada:\n");
-    for (int i = 0; i < matrixC.linhas; i++) {
-        for (int j = 0; j < matrixC.colunas; j++) {
-            if (j == 0) {
-                printf("|%.1f\t", matrixC.mtx[i][j].Re);
-            } else if (j == matrixC.colunas - 1) {
-                printf("%.1f|\t", matrixC.mtx[i][j].Re);
-            } else {
-                printf("%.1f\t", matrixC.mtx[i][j].Re);
-            }
+/**
+ * @brief Cache-blocked complex product C = op(A) * op(B) for matrices larger than GEMM_LIMIAR_PEQUENO.
+ *
+ * op(B) is packed in KC x NC panels; for each panel, strips of GEMM_MR rows of op(A) are multiplied by
+ * the GEMM_NR-column slices of the panel and the resulting tiles are accumulated into C. When
+ * op(A) = A^H, each strip is gathered (conjugated) from GEMM_MR consecutive columns of A into a small
+ * buffer, so the transpose is never formed. With 'triangular' set, tiles entirely below the diagonal
+ * are skipped (the caller mirrors the upper triangle afterwards).
+ *
+ * @param[out] produto The result matrix (m x n)
+ * @param[in] matrix1 The matrix A
+ * @param[in] op1 GEMM_N or GEMM_H
+ * @param[in] matrix2 The matrix B
+ * @param[in] op2 GEMM_N or GEMM_H
+ * @param[in] triangular Nonzero to compute only the tiles that touch the upper triangle
+ */
+static void gemmBlocado(complexMatrix produto, complexMatrix matrix1, int op1, complexMatrix matrix2, int op2, int triangular)
+{
+    const int m = produto.linhas;
+    const int n = produto.colunas;
+    const int kTotal = (op1 == GEMM_N) ? matrix1.colunas : matrix1.linhas;
+
+    //! Row of zeros that stands in for the missing rows of the last strip of op(A)
+    static const complex zeros[GEMM_KC];
+
+    //! Strip of op(A) gathered from the columns of A when op(A) = A^H
+    complex tiraA[GEMM_MR][GEMM_KC];
+
+    //! Buffer for one packed panel; allocated on the first product of each thread and then reused,
+    //! so repeated products perform no heap allocation. It is freed when the thread exits
+    static _Thread_local float *pacote = NULL;
+    if (pacote == NULL)
+    {
+        pthread_once(&gemmChaveCriada, gemmCriaChave);
+        pacote = (float *)matrixAlignedAlloc((size_t)GEMM_KC * GEMM_NC * 4 * sizeof(float));
+        if (pacote == NULL || pthread_setspecific(gemmChavePacote, pacote) != 0)
+        {
+            printf("Falha na alocacao de memoria\n");
+            exit(1);
         }
-        printf("\n");
     }
-    
-    calc_svd(matrixC);
-    printf("\n");
 
-    /**
-     * @brief Test case 4: Matrix 5x6
-     *
-     * This test case focuses on a matrix of size 5x6. It demonstrates the process of allocating memory for the matrix and putting values in it.
-     */
-    printf("\n========= Matriz 5x6 =========\n");
-    complexMatrix matrixD = allocateComplexMatrix(5, 6);
-    
-    for (int i = 0; i < matrixD.linhas; i++) {
-        for (int j = 0; j < matrixD.linhas; j++) {
-            matrixD.mtx[i][j].Re = i + j + 2.5;
-            matrixD.mtx[i][j].Im = 0;
+    complex tile[GEMM_MR * GEMM_NR];
+
+    for (int i = 0; i < m; i++)
+    {
+        complex *c = matrixLinha(produto, i);
+        for (int j = 0; j < n; j++)
+        {
+            c[j].Re = 0.0f;
+            c[j].Im = 0.0f;
         }
     }
 
-    printf("\nMatriz de entrada:\n");
-    for (int i = 0; i < matrixD.linhas; i++) {
-        for (int j = 0; j < matrixD.colunas; j++) {
-            if (j == 0) {
-                printf("|%.1f\t", matrixD.mtx[i][j].Re);
-            } else if (j == matrixD.colunas - 1) {
-                printf("%.1f|\t", matrixD.mtx[i][j].Re);
-            } else {
-                printf("%.1f\t", matrixD.mtx[i][j].Re);
+    for (int jc = 0; jc < n; jc += GEMM_NC)
+    {
+        const int nc = (n - jc < GEMM_NC) ? n - jc : GEMM_NC;
+
+        for (int pc = 0; pc < kTotal; pc += GEMM_KC)
+        {
+            const int kc = (kTotal - pc < GEMM_KC) ? kTotal - pc : GEMM_KC;
+
+            gemmEmpacotaB(pacote, matrix2, op2, pc, jc, kc, nc);
+
+            for (int ic = 0; ic < m; ic += GEMM_MR)
+            {
+                const int mr = (m - ic < GEMM_MR) ? m - ic : GEMM_MR;
+                const complex *a[GEMM_MR];
+
+                //! Nothing of this panel reaches the upper triangle for these rows
+                if (triangular && jc + nc <= ic)
+                {
+                    continue;
+                }
+
+                if (op1 == GEMM_N)
+                {
+                    for (int r = 0; r < GEMM_MR; r++)
+                    {
+                        a[r] = (r < mr) ? matrixLinha(matrix1, ic + r) + pc : zeros;
+                    }
+                }
+                else
+                {
+                    //! Row k of A holds the GEMM_MR elements of the strip contiguously
+                    for (int k = 0; k < kc; k++)
+                    {
+                        const complex *linha = matrixLinha(matrix1, pc + k) + ic;
+                        for (int r = 0; r < mr; r++)
+                        {
+                            tiraA[r][k].Re = linha[r].Re;
+                            tiraA[r][k].Im = -linha[r].Im;
+                        }
+                    }
+                    for (int r = 0; r < GEMM_MR; r++)
+                    {
+                        a[r] = (r < mr) ? tiraA[r] : zeros;
+                    }
+                }
+
+                for (int jr = 0; jr < nc; jr += GEMM_NR)
+                {
+                    const int nr = (nc - jr < GEMM_NR) ? nc - jr : GEMM_NR;
+
+                    if (triangular && jc + jr + nr <= ic)
+                    {
+                        continue;
+                    }
+
+                    gemmMicroKernel(kc, a, pacote + (size_t)(jr / GEMM_NR) * kc * 4 * GEMM_NR, tile);
+
+                    //! Accumulating the valid part of the tile into C
+                    for (int r = 0; r < mr; r++)
+                    {
+                        complex *c = matrixLinha(produto, ic + r) + jc + jr;
+                        for (int j = 0; j < nr; j++)
+                        {
+                            c[j].Re += tile[r * GEMM_NR + j].Re;
+                            c[j].Im += tile[r * GEMM_NR + j].Im;
+                        }
+                    }
+                }
             }
         }
-        printf("\n");
     }
-
-    calc_svd(matrixD);
-    printf("\n");
 }
 
-/************************************* OPERATION FUNCTIONS ***************************************/
-
 /**
- * @param[in] matrix The original matrix
- * @param[out] transposta The transposed matrix
+ * @param[out] destino The result matrix (m x n); must not overlap matrix1 or matrix2
+ * @param[in] matrix1 The first matrix (m x k)
+ * @param[in] matrix2 The second matrix (k x n)
  *
- * @brief Creating a function to calculate the transposed matrix.
+ * @brief Writes the complex matrix product matrix1 * matrix2 into destino.
  *
- * This function takes the original matrix as input and calculates the transposed matrix. It allocates memory for the transposed matrix and then goes through each element of the original matrix, setting the corresponding element in the transposed matrix. The rows and columns are switched in the transposed matrix.
+ * Small products use a plain loop; larger ones go through the cache-blocked AVX2/FMA kernel.
  *
- * @return The transposed matrix.
+ * @return 0 on success, -1 if the dimensions do not agree.
  */
-complexMatrix matrixTransposta(complexMatrix matrix)
+int matrixProdutoEm(complexMatrix destino, complexMatrix matrix1, complexMatrix matrix2)
 {
+    //! Checking that the inner dimensions agree and that destino has the shape of the product
+    if (matrix1.colunas != matrix2.linhas || destino.linhas != matrix1.linhas || destino.colunas != matrix2.colunas)
+    {
+        return -1;
+    }
 
-    /**
-     * @brief Allocating memory for the complex matrix.
-     */
-    complexMatrix transposta = allocateComplexMatrix(matrix.colunas, matrix.linhas);
-
-    //! Looping through each element of the original matrix
-    for (int i = 0; i < matrix.linhas; i++)
+    if ((long long)matrix1.linhas * matrix2.colunas * matrix1.colunas <= GEMM_LIMIAR_PEQUENO)
     {
-        for (int j = 0; j < matrix.colunas; j++)
-        {
-            //! Setting the actual element of the original matrix current value to the transposed one
-            //! Switching the rows and columns positions in the transposed matrix
-            transposta.mtx[j][i].Re = matrix.mtx[i][j].Re;
-            transposta.mtx[j][i].Im = matrix.mtx[i][j].Im;
-        }
+        gemmPequeno(destino, matrix1, matrix2);
+    }
+    else
+    {
+        gemmBlocado(destino, matrix1, GEMM_N, matrix2, GEMM_N, 0);
     }
-    return transposta;
-}
 
+    return 0;
+}
 
 /**
- * @param[in] matrix The original matrix
- * @param[out] conjugada The conjugate matrix
- *
- * @brief Creating a function to calculate the conjugate matrix.
+ * @param[out] destino The result matrix (m x n); must not overlap matrix1 or matrix2
+ * @param[in] matrix1 The matrix A (k x m)
+ * @param[in] matrix2 The matrix B (k x n)
  *
- * This function takes the original matrix as input and calculates the conjugate matrix. It allocates memory for the conjugate matrix and then iterates through each element of the original matrix, setting the corresponding element in the conjugate matrix. The imaginary part of each element is reversed in sign.
+ * @brief Writes A^H * B into destino, reading A in its original storage (no transposed or conjugated copy).
  *
- * @return The conjugate matrix.
+ * @return 0 on success, -1 if the dimensions do not agree.
  */
-complexMatrix matrixConjugada(complexMatrix matrix)
+int matrixProdutoAhBEm(complexMatrix destino, complexMatrix matrix1, complexMatrix matrix2)
 {
+    if (matrix1.linhas != matrix2.linhas || destino.linhas != matrix1.colunas || destino.colunas != matrix2.colunas)
+    {
+        return -1;
+    }
 
-    //! Allocating memory to the conjugate matrix using the allocateComplexMaatrix function 
-    complexMatrix conjugada = allocateComplexMatrix(matrix.colunas, matrix.linhas);
-
-    //! Loop for going through each original matrix element 
-    for (int i = 0; i < matrix.linhas; i++)
+    if ((long long)matrix1.colunas * matrix2.colunas * matrix1.linhas <= GEMM_LIMIAR_PEQUENO)
     {
-        for (int j = 0; j < matrix.colunas; j++)
-        {
-            //! Setting the value of the current element of the original matrix to the conjugate matrix
-            conjugada.mtx[i][j].Re = matrix.mtx[i][j].Re;
-            conjugada.mtx[i][j].Im = -matrix.mtx[i][j].Im; /*!< Reverses the sign of the imaginary part*/
-        }
+        gemmPequenoAhB(destino, matrix1, matrix2, 0);
+    }
+    else
+    {
+        gemmBlocado(destino, matrix1, GEMM_H, matrix2, GEMM_N, 0);
     }
 
-    //! Returning the conjugate matrix
-    return conjugada;
+    return 0;
 }
 
-
 /**
- * @param[in] transposta The transposed matrix
- * @param[out] hermitiana The Hermitian matrix
+ * @param[out] destino The result matrix (m x n); must not overlap matrix1 or matrix2
+ * @param[in] matrix1 The matrix A (m x k)
+ * @param[in] matrix2 The matrix B (n x k)
  *
- * @brief Creating a function to calculate the Hermitian matrix.
- *
- * This function takes the transposed matrix as input and calculates the Hermitian matrix. It allocates memory for the Hermitian matrix and then iterates through each element of the transposed matrix, setting the corresponding element in the Hermitian matrix. The sign of the imaginary part of each element is reversed.
+ * @brief Writes A * B^H into destino, reading B in its original storage (no transposed or conjugated copy).
  *
- * @return The Hermitian matrix.
+ * @return 0 on success, -1 if the dimensions do not agree.
  */
-complexMatrix matrixHermitiana(complexMatrix transposta)
+int matrixProdutoABhEm(complexMatrix destino, complexMatrix matrix1, complexMatrix matrix2)
 {
+    if (matrix1.colunas != matrix2.colunas || destino.linhas != matrix1.linhas || destino.colunas != matrix2.linhas)
+    {
+        return -1;
+    }
 
-     /**
-     * @brief Allocating memory for the Hermitian matrix using the allocateComplexMatrix function.
-     */
-    complexMatrix hermitiana = allocateComplexMatrix(transposta.colunas, transposta.linhas);
-
-     /**
-     * @brief Loop for iterating through each element of the transposed matrix.
-     */
-    for (int i = 0; i < transposta.linhas; i++)
+    if ((long long)matrix1.linhas * matrix2.linhas * matrix1.colunas <= GEMM_LIMIAR_PEQUENO)
     {
-        for (int j = 0; j < transposta.colunas; j++)
-        {
-            //! Assigning the value of the current element of the transposed matrix to the Hermitian matrix
-            hermitiana.mtx[i][j].Re = transposta.mtx[i][j].Re;
-            hermitiana.mtx[i][j].Im = -transposta.mtx[i][j].Im; /*!< Reverses the sign of the imaginary part*/
-        }
+        gemmPequenoABh(destino, matrix1, matrix2);
+    }
+    else
+    {
+        gemmBlocado(destino, matrix1, GEMM_N, matrix2, GEMM_H, 0);
     }
 
-    //! Returns the Hermitian matrix
-    return hermitiana;
+    return 0;
 }
 
 /**
- * @param[in] matrix1 The first matrix
- * @param[in] matrix2 The second matrix
- * @param[out] soma The sum matrix
+ * @param[out] destino The Gram matrix (n x n); must not overlap matrix
+ * @param[in] matrix The matrix H (m x n)
  *
- * @brief Creating a function to calculate the sum of two matrices.
+ * @brief Writes the Hermitian Gram matrix H^H * H into destino.
  *
- * This function takes two matrices, matrix1 and matrix2, as input and calculates the sum of the corresponding elements. It allocates memory for the sum matrix and then iterates through each element of matrix1 and matrix2, summing the corresponding elements and assigning the result to the sum matrix.
+ * Only the upper triangle is computed (about half of the multiply-adds); the lower triangle is filled
+ * with the conjugates, and the diagonal, which is real, has its imaginary part set to zero exactly.
  *
- * @return The sum matrix.
+ * @return 0 on success, -1 if the dimensions do not agree.
  */
-complexMatrix matrixSoma(complexMatrix matrix1, complexMatrix matrix2)
+int matrixGramEm(complexMatrix destino, complexMatrix matrix)
 {
-    /**
-    * @brief Allocating memory for the sum matrix using the allocateComplexMatrix function.
-    */
-    complexMatrix soma = allocateComplexMatrix(matrix1.linhas, matrix1.colunas);
+    const int n = matrix.colunas;
 
-    /**
-     * @brief Loop for iterating through each element of matrix1 and matrix2 (assuming they have the same dimensions).
-     */
-    for (int l = 0; l < matrix1.linhas; l++)
+    if (destino.linhas != n || destino.colunas != n)
     {
-        for (int c = 0; c < matrix1.colunas; c++)
+        return -1;
+    }
+
+    if ((long long)n * n * matrix.linhas <= GEMM_LIMIAR_PEQUENO)
+    {
+        gemmPequenoAhB(destino, matrix, matrix, 1);
+    }
+    else
+    {
+        gemmBlocado(destino, matrix, GEMM_H, matrix, GEMM_N, 1);
+    }
+
+    //! Mirroring the upper triangle into the lower one
+    for (int i = 0; i < n; i++)
+    {
+        MATRIX_ELEM(destino, i, i).Im = 0.0f;
+
+        for (int j = i + 1; j < n; j++)
         {
-            //! Summing the corresponding elements and assigning the result to the sum matrix
-            soma.mtx[l][c].Re = matrix1.mtx[l][c].Re + matrix2.mtx[l][c].Re;
-            soma.mtx[l][c].Im = matrix1.mtx[l][c].Im + matrix2.mtx[l][c].Im;
+            MATRIX_ELEM(destino, j, i).Re = MATRIX_ELEM(destino, i, j).Re;
+            MATRIX_ELEM(destino, j, i).Im = -MATRIX_ELEM(destino, i, j).Im;
         }
     }
 
-    //! Returning the sum matrix
-    return soma;
+    return 0;
 }
 
 /**
- * @param[in] matrix1 The first matrix
- * @param[in] matrix2 The second matrix
- * @param[out] subtracao The subtraction matrix
+ * @param[in] matrix1 The first matrix (m x k)
+ * @param[in] matrix2 The second matrix (k x n)
+ * @param[out] produto The result matrix after multiplication (m x n)
  *
- * @brief Creating a function to calculate the subtraction between two matrices.
+ * @brief Creating a function to perform the complex matrix multiplication between matrix1 and matrix2.
  *
- * This function takes two matrices, matrix1 and matrix2, as input and calculates the subtraction of the corresponding elements. It allocates memory for the subtraction matrix and then iterates through each element of matrix1 and matrix2, subtracting the corresponding elements and assigning the result to the subtraction matrix.
+ * This function computes C = A * B with the full complex product, Re = ar*br - ai*bi and
+ * Im = ar*bi + ai*br, summed along the inner dimension. The number of columns of matrix1 must match
+ * the number of rows of matrix2; otherwise an error message is printed and the program terminates.
  *
- * @return The subtraction matrix.
+ * @return The result matrix after matrix multiplication.
  */
-complexMatrix matrixSubtracao(complexMatrix matrix1, complexMatrix matrix2)
+complexMatrix matrixProduto(complexMatrix matrix1, complexMatrix matrix2)
 {
+    //! Checking that the inner dimensions agree
+    if (matrix1.colunas != matrix2.linhas)
+    {
+        printf("Dimensoes incompativeis para o produto matricial (%dx%d * %dx%d)\n",
+               matrix1.linhas, matrix1.colunas, matrix2.linhas, matrix2.colunas);
+        exit(1);
+    }
 
     /**
-     * @brief Allocating memory for the subtraction matrix using the allocateComplexMatrix function.
+     * @brief Allocating memory for the result matrix (rows of matrix1 x columns of matrix2).
      */
-    complexMatrix subtracao = allocateComplexMatrix(matrix1.linhas, matrix1.colunas);
+    complexMatrix produto = allocateComplexMatrix(matrix1.linhas, matrix2.colunas);
 
-     /**
-     * @brief Loop for iterating through each element of matrix1 and matrix2 (assuming they have the same dimensions).
-     */
-    for (int l = 0; l < matrix1.linhas; l++)
-    {
-        for (int c = 0; c < matrix1.colunas; c++)
-        {
-            //! Subtracting the corresponding elements and assigning the result to the subtraction matrix
-            subtracao.mtx[l][c].Re = matrix1.mtx[l][c].Re - matrix2.mtx[l][c].Re;
-            subtracao.mtx[l][c].Im = matrix1.mtx[l][c].Im - matrix2.mtx[l][c].Im;
-        }
-    }
+    matrixProdutoEm(produto, matrix1, matrix2);
 
-    //! Returning the subtraction matrix
-    return subtracao;
+    //! Returning the result matrix after matrix multiplication.
+    return produto;
 }
 
-
 /**
- * @param[in] matrix The original matrix
- * @param[in] num The scalar number
- * @param[out] produtoEscalar The result matrix after scalar multiplication
+ * @param[in] matrix1 The matrix A (k x m)
+ * @param[in] matrix2 The matrix B (k x n)
  *
- * @brief Creating a function to perform scalar multiplication with each element of the original matrix.
- *
- * This function takes a matrix, matrix, and a scalar number, num, as input and performs scalar multiplication by multiplying each element of the matrix by the scalar number. It allocates memory for the result matrix and then iterates through each element of the original matrix, multiplying the corresponding elements by the scalar number and assigning the result to the product matrix.
+ * @brief Calculates A^H * B without forming A^H. Terminates the program if the dimensions do not agree.
  *
- * @return The result matrix after scalar multiplication.
+ * @return The m x n product.
  */
-complexMatrix matrix_produtoEscalar(complexMatrix matrix, float num)
+complexMatrix matrixProdutoAhB(complexMatrix matrix1, complexMatrix matrix2)
 {
-    /**
-    * @brief Allocating memory for the result matrix of scalar multiplication using the allocateComplexMatrix function.
-    */
-    complexMatrix produtoEscalar = allocateComplexMatrix(matrix.linhas, matrix.colunas);
+    complexMatrix produto = allocateComplexMatrix(matrix1.colunas, matrix2.colunas);
 
-    /**
-     * @brief Loop for iterating through each element of the original matrix.
-     */
-    for (int l = 0; l < matrix.linhas; l++)
+    if (matrixProdutoAhBEm(produto, matrix1, matrix2) != 0)
     {
-        for (int c = 0; c < matrix.colunas; c++)
-        {
-            //! Multiplying the scalar number to each element of the original matrix and assigning the result to the elements of the product matrix.
-            produtoEscalar.mtx[l][c].Re = matrix.mtx[l][c].Re * num;
-            produtoEscalar.mtx[l][c].Im = matrix.mtx[l][c].Im * num;
-        }
+        matrixErroDimensoes("A^H * B");
     }
 
-    //! Returning the result matrix after scalar multiplication.
-    return produtoEscalar;
+    return produto;
 }
 
-
 /**
- * @param[in] matrix1 The first matrix
- * @param[in] matrix2 The second matrix
- * @param[out] produto The result matrix after multiplication
- *
- * @brief Creating a function to perform matrix multiplication between matrix1 and matrix2.
+ * @param[in] matrix1 The matrix A (m x k)
+ * @param[in] matrix2 The matrix B (n x k)
  *
- * This function takes two matrices, matrix1 and matrix2, as input and performs matrix multiplication by multiplying the corresponding elements of the matrices. It allocates memory for the result matrix and then iterates through each element of the matrices, multiplying the corresponding elements and assigning the result to the product matrix.
+ * @brief Calculates A * B^H without forming B^H. Terminates the program if the dimensions do not agree.
  *
- * @return The result matrix after matrix multiplication.
+ * @return The m x n product.
  */
-complexMatrix matrixProduto(complexMatrix matrix1, complexMatrix matrix2)
+complexMatrix matrixProdutoABh(complexMatrix matrix1, complexMatrix matrix2)
 {
-    /**
-     * @brief Allocating memory for the result matrix of matrix multiplication using the allocateComplexMatrix function.
-     */
-    complexMatrix produto = allocateComplexMatrix(matrix1.linhas, matrix1.colunas);
+    complexMatrix produto = allocateComplexMatrix(matrix1.linhas, matrix2.linhas);
 
-     /**
-     * @brief Loop for iterating through each element of matrix1 and matrix2, considering that they have the same dimensions.
-     */
-    for (int l = 0; l < matrix1.linhas; l++)
+    if (matrixProdutoABhEm(produto, matrix1, matrix2) != 0)
     {
-        for (int c = 0; c < matrix1.colunas; c++)
-        {
-            //! Multiplying matrix1 and matrix2 and assigning the result to the elements of the product matrix.
-            produto.mtx[l][c].Re = matrix1.mtx[l][c].Re * matrix2.mtx[l][c].Re;
-            produto.mtx[l][c].Im = matrix1.mtx[l][c].Im * matrix2.mtx[l][c].Im;
-        }
+        matrixErroDimensoes("A * B^H");
     }
 
-    //! Returning the result matrix after matrix multiplication.
     return produto;
 }
 
+/**
+ * @param[in] matrix The matrix H (m x n)
+ *
+ * @brief Calculates the Hermitian Gram matrix H^H * H, computing only its upper triangle.
+ *
+ * @return The n x n Gram matrix.
+ */
+complexMatrix matrixGram(complexMatrix matrix)
+{
+    complexMatrix gram = allocateComplexMatrix(matrix.colunas, matrix.colunas);
+
+    matrixGramEm(gram, matrix);
+
+    return gram;
+}
+
 /************************ TESTING FUNCTIONS **************************/
 
 /**
@@ -625,19 +2153,22 @@ void printMatrix(complexMatrix matrix)
 {
     for (int l = 0; l < matrix.linhas; l++)
     {
+        //! Reaching the row through 'dados', so views (which have no row pointers) can be printed too
+        const complex *linha = matrixLinha(matrix, l);
+
         for (int c = 0; c < matrix.colunas; c++)
         {
             if (c == 0)
             {
-                printf("|%.2f + %.2fi\t", matrix.mtx[l][c].Re, matrix.mtx[l][c].Im);
+                printf("|%.2f + %.2fi\t", linha[c].Re, linha[c].Im);
             }
             else if (c == matrix.colunas - 1)
             {
-                printf("%.2f + %.2fi|\t", matrix.mtx[l][c].Re, matrix.mtx[l][c].Im);
+                printf("%.2f + %.2fi|\t", linha[c].Re, linha[c].Im);
             }
             else
             {
-                printf("%.2f + %.2fi\t", matrix.mtx[l][c].Re, matrix.mtx[l][c].Im);
+                printf("%.2f + %.2fi\t", linha[c].Re, linha[c].Im);
             }
         }
         printf("\n"); /// Add a new line after printing all line elements
@@ -653,19 +2184,21 @@ void printMatrix1(complexMatrix matrix1)
 {
     for (int l = 0; l < matrix1.linhas; l++)
     {
+        const complex *linha = matrixLinha(matrix1, l);
+
         for (int c = 0; c < matrix1.colunas; c++)
         {
             if (c == 0)
             {
-                printf("|%.2f + %.2fi\t", matrix1.mtx[l][c].Re, matrix1.mtx[l][c].Im);
+                printf("|%.2f + %.2fi\t", linha[c].Re, linha[c].Im);
             }
             else if (c == matrix1.colunas - 1)
             {
-                printf("%.2f + %.2fi|\t", matrix1.mtx[l][c].Re, matrix1.mtx[l][c].Im);
+                printf("%.2f + %.2fi|\t", linha[c].Re, linha[c].Im);
             }
             else
             {
-                printf("%.2f + %.2fi\t", matrix1.mtx[l][c].Re, matrix1.mtx[l][c].Im);
+                printf("%.2f + %.2fi\t", linha[c].Re, linha[c].Im);
             }
         }
         printf("\n");
@@ -681,10 +2214,12 @@ void printMatrix2(complexMatrix matrix2)
 {
     for (int l = 0; l < matrix2.linhas; l++)
     {
+        const complex *linha = matrixLinha(matrix2, l);
+
         for (int c = 0; c < matrix2.colunas; c++)
         {
             printf("[%d][%d]: ", l, c);
-            printComplex(matrix2.mtx[l][c]);
+            printComplex(linha[c]);
         }
     }
 }
@@ -698,19 +2233,21 @@ void printTransposta(complexMatrix transposta)
 {
     for (int l = 0; l < transposta.linhas; l++)
     {
+        const complex *linha = matrixLinha(transposta, l);
+
         for (int c = 0; c < transposta.colunas; c++)
         {
             if (c == 0)
             {
-                printf("|%.2f + %.2fi\t", transposta.mtx[l][c].Re, transposta.mtx[l][c].Im);
+                printf("|%.2f + %.2fi\t", linha[c].Re, linha[c].Im);
             }
             else if (c == transposta.colunas - 1)
             {
-                printf("%.2f + %.2fi|\t", transposta.mtx[l][c].Re, transposta.mtx[l][c].Im);
+                printf("%.2f + %.2fi|\t", linha[c].Re, linha[c].Im);
             }
             else
             {
-                printf("%.2f + %.2fi\t", transposta.mtx[l][c].Re, transposta.mtx[l][c].Im);
+                printf("%.2f + %.2fi\t", linha[c].Re, linha[c].Im);
             }
         }
         printf("\n");
@@ -726,19 +2263,21 @@ void printConjugada(complexMatrix conjugada)
 {
     for (int l = 0; l < conjugada.linhas; l++)
     {
+        const complex *linha = matrixLinha(conjugada, l);
+
         for (int c = 0; c < conjugada.colunas; c++)
         {
             if (c == 0)
             {
-                printf("|%.2f + %.2fi\t", conjugada.mtx[l][c].Re, conjugada.mtx[l][c].Im);
+                printf("|%.2f + %.2fi\t", linha[c].Re, linha[c].Im);
             }
             else if (c == conjugada.colunas - 1)
             {
-                printf("%.2f + %.2fi|\t", conjugada.mtx[l][c].Re, conjugada.mtx[l][c].Im);
+                printf("%.2f + %.2fi|\t", linha[c].Re, linha[c].Im);
             }
             else
             {
-                printf("%.2f + %.2fi\t", conjugada.mtx[l][c].Re, conjugada.mtx[l][c].Im);
+                printf("%.2f + %.2fi\t", linha[c].Re, linha[c].Im);
             }
         }
         printf("\n");
@@ -754,19 +2293,21 @@ void printHermitiana(complexMatrix hermitiana)
 {
     for (int l = 0; l < hermitiana.linhas; l++)
     {
+        const complex *linha = matrixLinha(hermitiana, l);
+
         for (int c = 0; c < hermitiana.colunas; c++)
         {
             if (c == 0)
             {
-                printf("|%.2f + %.2fi\t", hermitiana.mtx[l][c].Re, hermitiana.mtx[l][c].Im);
+                printf("|%.2f + %.2fi\t", linha[c].Re, linha[c].Im);
             }
             else if (c == hermitiana.colunas - 1)
             {
-                printf("%.2f + %.2fi|\t", hermitiana.mtx[l][c].Re, hermitiana.mtx[l][c].Im);
+                printf("%.2f + %.2fi|\t", linha[c].Re, linha[c].Im);
             }
             else
             {
-                printf("%.2f + %.2fi\t", hermitiana.mtx[l][c].Re, hermitiana.mtx[l][c].Im);
+                printf("%.2f + %.2fi\t", linha[c].Re, linha[c].Im);
             }
         }
         printf("\n");
@@ -782,19 +2323,21 @@ void printSoma(complexMatrix soma)
 {
     for (int l = 0; l < soma.linhas; l++)
     {
+        const complex *linha = matrixLinha(soma, l);
+
         for (int c = 0; c < soma.colunas; c++)
         {
             if (c == 0)
             {
-                printf("|%.2f + %.2fi\t", soma.mtx[l][c].Re, soma.mtx[l][c].Im);
+                printf("|%.2f + %.2fi\t", linha[c].Re, linha[c].Im);
             }
             else if (c == soma.colunas - 1)
             {
-                printf("%.2f + %.2fi|\t", soma.mtx[l][c].Re, soma.mtx[l][c].Im);
+                printf("%.2f + %.2fi|\t", linha[c].Re, linha[c].Im);
             }
             else
             {
-                printf("%.2f + %.2fi\t", soma.mtx[l][c].Re, soma.mtx[l][c].Im);
+                printf("%.2f + %.2fi\t", linha[c].Re, linha[c].Im);
             }
         }
         printf("\n");
@@ -810,19 +2353,21 @@ void printSubtracao(complexMatrix subtracao)
 {
     for (int l = 0; l < subtracao.linhas; l++)
     {
+        const complex *linha = matrixLinha(subtracao, l);
+
         for (int c = 0; c < subtracao.colunas; c++)
         {
             if (c == 0)
             {
-                printf("|%.2f + %.2fi\t", subtracao.mtx[l][c].Re, subtracao.mtx[l][c].Im);
+                printf("|%.2f + %.2fi\t", linha[c].Re, linha[c].Im);
             }
             else if (c == subtracao.colunas - 1)
             {
-                printf("%.2f + %.2fi|\t", subtracao.mtx[l][c].Re, subtracao.mtx[l][c].Im);
+                printf("%.2f + %.2fi|\t", linha[c].Re, linha[c].Im);
             }
             else
             {
-                printf("%.2f + %.2fi\t", subtracao.mtx[l][c].Re, subtracao.mtx[l][c].Im);
+                printf("%.2f + %.2fi\t", linha[c].Re, linha[c].Im);
             }
         }
         printf("\n");
@@ -838,19 +2383,21 @@ void print_produtoEscalar(complexMatrix produtoEscalar)
 {
     for (int l = 0; l < produtoEscalar.linhas; l++)
     {
+        const complex *linha = matrixLinha(produtoEscalar, l);
+
         for (int c = 0; c < produtoEscalar.colunas; c++)
         {
             if (c == 0)
             {
-                printf("|%.2f + %.2fi\t", produtoEscalar.mtx[l][c].Re, produtoEscalar.mtx[l][c].Im);
+                printf("|%.2f + %.2fi\t", linha[c].Re, linha[c].Im);
             }
             else if (c == produtoEscalar.colunas - 1)
             {
-                printf("%.2f + %.2fi|\t", produtoEscalar.mtx[l][c].Re, produtoEscalar.mtx[l][c].Im);
+                printf("%.2f + %.2fi|\t", linha[c].Re, linha[c].Im);
             }
             else
             {
-                printf("%.2f + %.2fi\t", produtoEscalar.mtx[l][c].Re, produtoEscalar.mtx[l][c].Im);
+                printf("%.2f + %.2fi\t", linha[c].Re, linha[c].Im);
             }
         }
         printf("\n");
@@ -866,19 +2413,21 @@ void printProduto(complexMatrix produto)
 {
     for (int l = 0; l < produto.linhas; l++)
     {
+        const complex *linha = matrixLinha(produto, l);
+
         for (int c = 0; c < produto.colunas; c++)
         {
             if (c == 0)
             {
-                printf("|%.2f + %.2fi\t", produto.mtx[l][c].Re, produto.mtx[l][c].Im);
+                printf("|%.2f + %.2fi\t", linha[c].Re, linha[c].Im);
             }
             else if (c == produto.colunas - 1)
             {
-                printf("%.2f + %.2fi|\t", produto.mtx[l][c].Re, produto.mtx[l][c].Im);
+                printf("%.2f + %.2fi|\t", linha[c].Re, linha[c].Im);
             }
             else
             {
-                printf("%.2f + %.2fi\t", produto.mtx[l][c].Re, produto.mtx[l][c].Im);
+                printf("%.2f + %.2fi\t", linha[c].Re, linha[c].Im);
             }
         }
         printf("\n");
@@ -895,10 +2444,18 @@ void teste_todos()
     int colunas = 3;
     float num = 2.5;
 
+    //! All the matrices of the test are temporaries with the same lifetime, so they are carved from one arena
+    matrixArena arena;
+    if (arenaInit(&arena, 16 * matrixTamanhoBloco(linhas, colunas)) != 0)
+    {
+        printf("Falha na alocacao de memoria\n");
+        exit(1);
+    }
+
     //! Calling the create and allocate memory for the original matrices, A and B.
-    complexMatrix matrix = allocateComplexMatrix(linhas, colunas);
-    complexMatrix matrix1 = allocateComplexMatrix(linhas, colunas);
-    complexMatrix matrix2 = allocateComplexMatrix(linhas, colunas);
+    complexMatrix matrix = arenaComplexMatrix(&arena, linhas, colunas);
+    complexMatrix matrix1 = arenaComplexMatrix(&arena, linhas, colunas);
+    complexMatrix matrix2 = arenaComplexMatrix(&arena, linhas, colunas);
 
     //! Filling in the Original Matrix
     for (int l = 0; l < matrix.linhas; l++)
@@ -910,10 +2467,13 @@ void teste_todos()
         }
     }
 
-    //! Calling the defined functions that depend on the original matrix.
-    complexMatrix transposta = matrixTransposta(matrix);
-    complexMatrix conjugada = matrixConjugada(matrix);
-    complexMatrix hermitiana = matrixHermitiana(transposta);
+    //! Calling the defined functions that depend on the original matrix, writing into matrices of the arena.
+    complexMatrix transposta = arenaComplexMatrix(&arena, colunas, linhas);
+    complexMatrix conjugada = arenaComplexMatrix(&arena, linhas, colunas);
+    complexMatrix hermitiana = arenaComplexMatrix(&arena, colunas, linhas);
+    matrixTranspostaEm(transposta, matrix);
+    matrixConjugadaEm(conjugada, matrix);
+    matrixHermitianaEm(hermitiana, matrix);
 
     /// Filling in Matrix A.
     for (int l = 0; l < matrix1.linhas; l++)
@@ -936,10 +2496,14 @@ void teste_todos()
     }
 
     //! Calling the previously defined functions that depend on Matrices A and B.
-    complexMatrix soma = matrixSoma(matrix1, matrix2);
-    complexMatrix subtracao = matrixSubtracao(matrix1, matrix2);
-    complexMatrix produtoEscalar = matrix_produtoEscalar(matrix, num);
-    complexMatrix produto = matrixProduto(matrix1, matrix2);
+    complexMatrix soma = arenaComplexMatrix(&arena, linhas, colunas);
+    complexMatrix subtracao = arenaComplexMatrix(&arena, linhas, colunas);
+    complexMatrix produtoEscalar = arenaComplexMatrix(&arena, linhas, colunas);
+    complexMatrix produto = arenaComplexMatrix(&arena, linhas, colunas);
+    matrixSomaEm(soma, matrix1, matrix2);
+    matrixSubtracaoEm(subtracao, matrix1, matrix2);
+    matrix_produtoEscalarEm(produtoEscalar, matrix, num);
+    matrixProdutoEm(produto, matrix1, matrix2);
 
 
     /******************** PRINTING THE TESTING FUNCTIONS *********************/
@@ -1026,5 +2590,27 @@ void teste_todos()
     freeComplexMatrix(matrixA);
     freeComplexMatrix(matrixB);
     freeComplexMatrix(matrixC);
+
+    //! Releasing every matrix of the test at once
+    arenaFree(&arena);
+
     teste_calc_svd();
+
+    //! Checks with pass/fail output: the program exits with an error if any of them fails
+    int falhas = 0;
+    falhas += teste_fatoracao();
+    falhas += teste_memoria();
+    falhas += teste_lote();
+    falhas += teste_fixas();
+    falhas += teste_expr();
+    falhas += teste_ponto_fixo();
+    falhas += teste_paralelo();
+    falhas += teste_aleatorio();
+
+    printf("\n  ============ Resumo ============ \n");
+    printf("%d verificacoes com falha\n", falhas);
+    if (falhas != 0)
+    {
+        exit(1);
+    }
 }
\ No newline at end of file
@@ -6,8 +6,14 @@
 #ifndef MATRIZES_H
 #define MATRIZES_H
 #include <stdio.h>
+#include <stddef.h>
 #include <gsl/gsl_linalg.h>
 
+/*!
+* @brief Alignment, in bytes, of every block allocated for a complexMatrix (one cache line).
+*/
+#define MATRIX_ALINHAMENTO 64
+
 /*! 
 * @brief Definition of the complex structure.
 */
@@ -22,15 +28,111 @@ typedef struct
 typedef struct
 {
     int linhas, colunas; /*!< Fields to store the number of rows and columns */
-    complex **mtx;       /*!< Definition of a pointer to pointer 'mtx' for a matrix of complex numbers */
+    int ld;              /*!< Leading dimension: number of elements between the start of two consecutive rows */
+    complex *dados;      /*!< Contiguous, 64-byte aligned storage of the elements, one row after the other */
+    complex **mtx;       /*!< Row pointers into 'dados', so elements can still be reached as mtx[i][j] (NULL for views) */
+    void *bloco;         /*!< Start of the block owned by the matrix (NULL for views, which own nothing) */
 } complexMatrix;
 
+/*!
+* @brief Element (i, j) of a complexMatrix, reached through 'dados' and the leading dimension.
+*/
+#define MATRIX_ELEM(matrix, i, j) ((matrix).dados[(size_t)(i) * (matrix).ld + (j)])
+
+/*!
+* @brief Returns a pointer to the first element of row i, without touching the row pointer array.
+*/
+static inline complex *matrixLinha(complexMatrix matrix, int i)
+{
+    return matrix.dados + (size_t)i * matrix.ld;
+}
+
 ///****************************************** DECLARATION OF COMPLEX FUNCTIONS ****************************************************/
 ///
 ///-----> The functions below are being implemented in 'matrizes.c'.
 ///-----> Below we have only the signatures of the respective functions.
 ///
-complexMatrix allocateComplexMaatrix(int linhas, int colunas);
+
+/**
+ * @brief Allocates a 64-byte aligned block of memory.
+ *
+ * @param bytes Number of bytes requested.
+ * @return Pointer to the block, or NULL if the allocation failed.
+ */
+void *matrixAlignedAlloc(size_t bytes);
+
+/**
+ * @brief Releases a block returned by matrixAlignedAlloc.
+ *
+ * @param ptr The block to be released (NULL is accepted).
+ */
+void matrixAlignedFree(void *ptr);
+
+/**
+ * @brief Number of bytes of the block that holds a complex matrix (row pointers + elements).
+ *
+ * @param linhas Number of rows.
+ * @param colunas Number of columns.
+ * @return Size of the block, a multiple of MATRIX_ALINHAMENTO.
+ */
+size_t matrixTamanhoBloco(int linhas, int colunas);
+
+/**
+ * @brief Lays a complex matrix out over a 64-byte aligned block of matrixTamanhoBloco(linhas, colunas) bytes.
+ *
+ * Used by the allocators (heap, arena and pool) so that all of them produce the same layout.
+ *
+ * @param bloco The block of memory.
+ * @param linhas Number of rows.
+ * @param colunas Number of columns.
+ * @return The complexMatrix laid over the block ('bloco' field set to the block).
+ */
+complexMatrix matrixSobreBloco(void *bloco, int linhas, int colunas);
+
+/**
+ * @brief Allocates a complex matrix in a single 64-byte aligned block.
+ *
+ * The row pointer array and the elements share the same allocation, so the cost is O(1)
+ * regardless of the number of rows and the elements are laid out contiguously with ld == colunas.
+ *
+ * @param linhas Number of rows.
+ * @param colunas Number of columns.
+ * @return The allocated complexMatrix.
+ */
+complexMatrix allocateComplexMatrix(int linhas, int colunas);
+
+/**
+ * @brief Frees the memory owned by a complex matrix. Views own nothing and are ignored.
+ *
+ * @param matrix The complexMatrix object to be freed.
+ */
+void freeComplexMatrix(complexMatrix matrix);
+
+/**
+ * @brief Creates a view over a rectangular block of an existing matrix.
+ *
+ * The view shares the storage and the leading dimension of the original matrix, so it costs nothing.
+ * It has no row pointer array ('mtx' is NULL): elements must be reached with MATRIX_ELEM or matrixLinha.
+ *
+ * @param matrix The matrix that owns the elements.
+ * @param linha0 First row of the block.
+ * @param coluna0 First column of the block.
+ * @param linhas Number of rows of the block.
+ * @param colunas Number of columns of the block.
+ * @return The complexMatrix view.
+ */
+complexMatrix matrixView(complexMatrix matrix, int linha0, int coluna0, int linhas, int colunas);
+
+/**
+ * @brief Creates a view over an external buffer of complex numbers.
+ *
+ * @param dados Pointer to the first element.
+ * @param linhas Number of rows.
+ * @param colunas Number of columns.
+ * @param ld Leading dimension of the buffer (ld >= colunas).
+ * @return The complexMatrix view.
+ */
+complexMatrix matrixViewBuffer(complex *dados, int linhas, int colunas, int ld);
 
 /**
  * @brief Calculates the transpose of a complex matrix.
@@ -99,12 +201,276 @@ complexMatrix matrix_produtoEscalar(complexMatrix matrix, float num);
 /**
  * @brief Calculates the product of two complex matrices.
  *
- * This function calculates and returns the product of the two given complex matrices.
+ * This function calculates and returns the complex matrix product matrix1 * matrix2.
+ * The number of columns of matrix1 must be equal to the number of rows of matrix2.
  *
- * @param matrix1 The first complexMatrix to be multiplied.
- * @param matrix2 The second complexMatrix to be multiplied.
- * @return The complexMatrix object representing the resulting product matrix.
+ * @param matrix1 The first complexMatrix to be multiplied (m x k).
+ * @param matrix2 The second complexMatrix to be multiplied (k x n).
+ * @return The complexMatrix object representing the resulting product matrix (m x n).
  */
 complexMatrix matrixProduto(complexMatrix matrix1, complexMatrix matrix2);
 
+/**
+ * @brief Calculates A^H * B without forming A^H.
+ *
+ * @param matrix1 The complexMatrix A (k x m).
+ * @param matrix2 The complexMatrix B (k x n).
+ * @return The complexMatrix object representing the product (m x n).
+ */
+complexMatrix matrixProdutoAhB(complexMatrix matrix1, complexMatrix matrix2);
+
+/**
+ * @brief Calculates A * B^H without forming B^H.
+ *
+ * @param matrix1 The complexMatrix A (m x k).
+ * @param matrix2 The complexMatrix B (n x k).
+ * @return The complexMatrix object representing the product (m x n).
+ */
+complexMatrix matrixProdutoABh(complexMatrix matrix1, complexMatrix matrix2);
+
+/**
+ * @brief Calculates the Hermitian Gram matrix H^H * H (used by ZF/MMSE detection and capacity computation).
+ *
+ * @param matrix The complexMatrix H (m x n).
+ * @return The complexMatrix object representing the Gram matrix (n x n).
+ */
+complexMatrix matrixGram(complexMatrix matrix);
+
+/**
+ * @brief Computes the thin complex SVD, matrix = U diag(S) V^H (one-sided Jacobi, single precision).
+ *
+ * Nothing is printed; the factors are written to the caller's buffers.
+ *
+ * @param matrix The m x n complexMatrix to be decomposed (left untouched).
+ * @param U The m x k complexMatrix that receives the left singular vectors, k = min(m, n).
+ * @param S Array of k floats that receives the singular values, in decreasing order.
+ * @param Vh The k x n complexMatrix that receives V^H.
+ * @return 0 on success, -1 if the dimensions of the outputs do not agree.
+ */
+int calc_svd(complexMatrix matrix, complexMatrix U, float *S, complexMatrix Vh);
+
+/*!
+* @brief Working storage of calc_svd_trabalho, sized once for one shape of matrix.
+*/
+typedef struct
+{
+    int linhas, colunas; /*!< Shape of the matrices the workspace was sized for */
+    complexMatrix X;     /*!< Working matrix of the tall case (colunas x linhas); empty for wide shapes */
+} svdTrabalho;
+
+/**
+ * @brief Allocates the workspace of calc_svd_trabalho for linhas x colunas matrices.
+ *
+ * If the allocation fails, an error message is printed and the program terminates.
+ *
+ * @param linhas Number of rows of the matrices to be decomposed.
+ * @param colunas Number of columns of the matrices to be decomposed.
+ * @return The workspace.
+ */
+svdTrabalho allocateSVDTrabalho(int linhas, int colunas);
+
+/**
+ * @brief Frees the storage of an SVD workspace.
+ *
+ * @param trabalho The svdTrabalho object to be freed.
+ */
+void freeSVDTrabalho(svdTrabalho trabalho);
+
+/**
+ * @brief Same thin SVD as calc_svd, without allocating: the working matrix comes from the workspace.
+ *
+ * @param trabalho The workspace, allocated for the shape of matrix.
+ * @param matrix The m x n complexMatrix to be decomposed (left untouched).
+ * @param U The m x k complexMatrix that receives the left singular vectors, k = min(m, n).
+ * @param S Array of k floats that receives the singular values, in decreasing order.
+ * @param Vh The k x n complexMatrix that receives V^H.
+ * @return 0 on success, -1 if the dimensions of the outputs or of the workspace do not agree.
+ */
+int calc_svd_trabalho(svdTrabalho trabalho, complexMatrix matrix, complexMatrix U, float *S, complexMatrix Vh);
+
+///****************************************** GSL BRIDGE ****************************************************/
+///
+///-----> A complexMatrix has the memory layout of a gsl_matrix_complex_float with tda = ld, so the float
+///-----> bridge is a pair of views. The double precision bridge copies whole rows.
+///
+
+/**
+ * @brief Returns a gsl_matrix_complex_float view over the elements of matrix (nothing is copied).
+ *
+ * @param matrix The complexMatrix (or view).
+ * @return The GSL view; it is valid while the storage of matrix is.
+ */
+gsl_matrix_complex_float_view matrixParaGSLView(complexMatrix matrix);
+
+/**
+ * @brief Returns a complexMatrix view over the elements of a gsl_matrix_complex_float (nothing is copied).
+ *
+ * @param gsl The GSL matrix.
+ * @return The complexMatrix view, which owns nothing.
+ */
+complexMatrix matrixDeGSLView(gsl_matrix_complex_float *gsl);
+
+/**
+ * @brief Copies a complexMatrix into a double precision gsl_matrix_complex.
+ *
+ * @param destino The GSL matrix (same shape as origem).
+ * @param origem The complexMatrix.
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixParaGSL(gsl_matrix_complex *destino, complexMatrix origem);
+
+/**
+ * @brief Copies a gsl_matrix_complex into a complexMatrix, rounding to single precision.
+ *
+ * @param destino The complexMatrix (same shape as origem).
+ * @param origem The GSL matrix.
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int gslParaMatrix(complexMatrix destino, const gsl_matrix_complex *origem);
+
+///****************************************** ALLOCATION-FREE OPERATIONS ****************************************************/
+///
+///-----> The functions below write into a matrix provided by the caller ('destino') instead of allocating one.
+///-----> They return 0 on success and -1 when the dimensions do not agree.
+///-----> For the element-wise operations, 'destino' may be one of the operands (in-place operation).
+///
+
+/**
+ * @brief Writes matrix1 + matrix2 into destino.
+ *
+ * @param destino The matrix that receives the sum (same shape as the operands).
+ * @param matrix1 The first complexMatrix to be summed.
+ * @param matrix2 The second complexMatrix to be summed.
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixSomaEm(complexMatrix destino, complexMatrix matrix1, complexMatrix matrix2);
+
+/**
+ * @brief Writes matrix1 - matrix2 into destino.
+ *
+ * @param destino The matrix that receives the subtraction (same shape as the operands).
+ * @param matrix1 The complexMatrix to be subtracted.
+ * @param matrix2 The complexMatrix to be subtracted from matrix1.
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixSubtracaoEm(complexMatrix destino, complexMatrix matrix1, complexMatrix matrix2);
+
+/**
+ * @brief Writes num * matrix into destino.
+ *
+ * @param destino The matrix that receives the product (same shape as matrix).
+ * @param matrix The complexMatrix to be multiplied by the scalar.
+ * @param num The scalar to be multiplied by the matrix.
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrix_produtoEscalarEm(complexMatrix destino, complexMatrix matrix, float num);
+
+/**
+ * @brief Writes the conjugate of matrix into destino.
+ *
+ * @param destino The matrix that receives the conjugate (same shape as matrix).
+ * @param matrix The complexMatrix to be conjugated.
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixConjugadaEm(complexMatrix destino, complexMatrix matrix);
+
+/**
+ * @brief Writes the transpose of matrix into destino.
+ *
+ * @param destino The matrix that receives the transpose (colunas x linhas); must not overlap matrix.
+ * @param matrix The complexMatrix to be transposed.
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixTranspostaEm(complexMatrix destino, complexMatrix matrix);
+
+/**
+ * @brief Writes the conjugate transpose of matrix into destino in a single pass.
+ *
+ * Unlike matrixHermitiana, the argument is the original matrix, not its transpose.
+ *
+ * @param destino The matrix that receives the Hermitian (colunas x linhas); must not overlap matrix.
+ * @param matrix The original complexMatrix.
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixHermitianaEm(complexMatrix destino, complexMatrix matrix);
+
+/**
+ * @brief Writes the complex matrix product matrix1 * matrix2 into destino.
+ *
+ * @param destino The matrix that receives the product (m x n); must not overlap the operands.
+ * @param matrix1 The first complexMatrix to be multiplied (m x k).
+ * @param matrix2 The second complexMatrix to be multiplied (k x n).
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixProdutoEm(complexMatrix destino, complexMatrix matrix1, complexMatrix matrix2);
+
+/**
+ * @brief Writes A^H * B into destino without forming A^H (A is read in its original storage).
+ *
+ * @param destino The matrix that receives the product (m x n); must not overlap the operands.
+ * @param matrix1 The complexMatrix A (k x m).
+ * @param matrix2 The complexMatrix B (k x n).
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixProdutoAhBEm(complexMatrix destino, complexMatrix matrix1, complexMatrix matrix2);
+
+/**
+ * @brief Writes A * B^H into destino without forming B^H (B is read in its original storage).
+ *
+ * @param destino The matrix that receives the product (m x n); must not overlap the operands.
+ * @param matrix1 The complexMatrix A (m x k).
+ * @param matrix2 The complexMatrix B (n x k).
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixProdutoABhEm(complexMatrix destino, complexMatrix matrix1, complexMatrix matrix2);
+
+/**
+ * @brief Writes the Hermitian Gram matrix H^H * H into destino, computing only the upper triangle.
+ *
+ * @param destino The matrix that receives the Gram matrix (n x n); must not overlap matrix.
+ * @param matrix The complexMatrix H (m x n).
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixGramEm(complexMatrix destino, complexMatrix matrix);
+
+/**
+ * @brief Transposes a square matrix in place (cache blocked, without any temporary copy).
+ *
+ * @param matrix The square complexMatrix.
+ * @return 0 on success, -1 if the matrix is not square.
+ */
+int matrixTranspostaInPlace(complexMatrix matrix);
+
+/**
+ * @brief Replaces a square matrix by its conjugate transpose, in place.
+ *
+ * @param matrix The square complexMatrix.
+ * @return 0 on success, -1 if the matrix is not square.
+ */
+int matrixHermitianaInPlace(complexMatrix matrix);
+
+/**
+ * @brief In-place sum, matrix1 += matrix2.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixSomaInPlace(complexMatrix matrix1, complexMatrix matrix2);
+
+/**
+ * @brief In-place subtraction, matrix1 -= matrix2.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixSubtracaoInPlace(complexMatrix matrix1, complexMatrix matrix2);
+
+/**
+ * @brief In-place scalar product, matrix *= num.
+ */
+void matrix_produtoEscalarInPlace(complexMatrix matrix, float num);
+
+/**
+ * @brief In-place conjugation of every element of matrix.
+ */
+void matrixConjugadaInPlace(complexMatrix matrix);
+
 #endif
\ No newline at end of file
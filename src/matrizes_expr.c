@@ -0,0 +1,402 @@
+/**
+ * @file matrizes_expr.c
+ * @brief Implementation file for lazy element-wise matrix expressions.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/// including the files where the structures are contained
+#include "matrizes_expr.h"
+#include "matrizes.h"
+#include "memoria.h"
+#include "teste.h"
+
+/*
+ * Number of elements of a row evaluated at a time. Every level of the tree gets one segment of
+ * scratch, so the working set of a whole evaluation stays in L1.
+ */
+#define EXPR_SEGMENTO 64
+
+/************************************* BUILDING EXPRESSIONS ***************************************/
+
+/**
+ * @brief Carves a node from the arena, handling an exhausted arena like a failed allocation.
+ */
+static matrixExpr *exprNo(matrixArena *arena, matrixExprOp op, int linhas, int colunas, int profundidade)
+{
+    if (profundidade > MATRIX_EXPR_MAX_PROFUNDIDADE)
+    {
+        return NULL;
+    }
+
+    matrixExpr *no = (matrixExpr *)arenaAlloc(arena, sizeof(matrixExpr));
+
+    if (no == NULL)
+    {
+        printf("Memoria da arena esgotada\n");
+        exit(1);
+    }
+
+    no->op = op;
+    no->linhas = linhas;
+    no->colunas = colunas;
+    no->profundidade = profundidade;
+    no->escalar = 1.0f;
+    no->a = NULL;
+    no->b = NULL;
+
+    return no;
+}
+
+/**
+ * @brief Binary node: both operands must exist and have the same shape.
+ */
+static const matrixExpr *exprBinaria(matrixArena *arena, matrixExprOp op, const matrixExpr *a, const matrixExpr *b)
+{
+    if (a == NULL || b == NULL || a->linhas != b->linhas || a->colunas != b->colunas)
+    {
+        return NULL;
+    }
+
+    const int profundidade = 1 + (a->profundidade > b->profundidade ? a->profundidade : b->profundidade);
+    matrixExpr *no = exprNo(arena, op, a->linhas, a->colunas, profundidade);
+
+    if (no != NULL)
+    {
+        no->a = a;
+        no->b = b;
+    }
+
+    return no;
+}
+
+/**
+ * @param[in] arena The arena that holds the node
+ * @param[in] matrix The operand
+ *
+ * @brief Creates a leaf referring to matrix.
+ *
+ * @return The node.
+ */
+const matrixExpr *exprMatriz(matrixArena *arena, complexMatrix matrix)
+{
+    matrixExpr *no = exprNo(arena, EXPR_MATRIZ, matrix.linhas, matrix.colunas, 1);
+
+    no->matrix = matrix;
+
+    return no;
+}
+
+/**
+ * @brief Creates the node a + b.
+ *
+ * @return The node, or NULL if an operand is NULL or the shapes do not agree.
+ */
+const matrixExpr *exprSoma(matrixArena *arena, const matrixExpr *a, const matrixExpr *b)
+{
+    return exprBinaria(arena, EXPR_SOMA, a, b);
+}
+
+/**
+ * @brief Creates the node a - b.
+ *
+ * @return The node, or NULL if an operand is NULL or the shapes do not agree.
+ */
+const matrixExpr *exprSubtracao(matrixArena *arena, const matrixExpr *a, const matrixExpr *b)
+{
+    return exprBinaria(arena, EXPR_SUBTRACAO, a, b);
+}
+
+/**
+ * @brief Creates the node num * a.
+ *
+ * @return The node, or NULL if a is NULL.
+ */
+const matrixExpr *exprEscalar(matrixArena *arena, const matrixExpr *a, float num)
+{
+    if (a == NULL)
+    {
+        return NULL;
+    }
+
+    matrixExpr *no = exprNo(arena, EXPR_ESCALAR, a->linhas, a->colunas, a->profundidade + 1);
+
+    if (no != NULL)
+    {
+        no->a = a;
+        no->escalar = num;
+    }
+
+    return no;
+}
+
+/**
+ * @brief Creates the node conj(a).
+ *
+ * @return The node, or NULL if a is NULL.
+ */
+const matrixExpr *exprConjugada(matrixArena *arena, const matrixExpr *a)
+{
+    if (a == NULL)
+    {
+        return NULL;
+    }
+
+    matrixExpr *no = exprNo(arena, EXPR_CONJUGADA, a->linhas, a->colunas, a->profundidade + 1);
+
+    if (no != NULL)
+    {
+        no->a = a;
+    }
+
+    return no;
+}
+
+/************************************* EVALUATION ***************************************/
+
+/**
+ * @param[in] no The node
+ * @param[in] i Row of the segment
+ * @param[in] j0 First column of the segment
+ * @param[in] n Number of elements of the segment (at most EXPR_SEGMENTO)
+ * @param[out] saida Segment where the node writes its result
+ * @param[in] rascunho Scratch for the children, one segment per level below the node
+ *
+ * @brief Evaluates the segment (i, j0 .. j0 + n - 1) of a node.
+ *
+ * The first child is evaluated into the node's own output segment and the second one into the
+ * scratch, so the node then combines them in place. A leaf does not copy anything: it returns a
+ * pointer into its matrix.
+ *
+ * @return Pointer to the n results (saida, or the row of a leaf).
+ */
+static const complex *exprAvaliaSegmento(const matrixExpr *no, int i, int j0, int n, complex *saida, complex *rascunho)
+{
+    if (no->op == EXPR_MATRIZ)
+    {
+        return matrixLinha(no->matrix, i) + j0;
+    }
+
+    const complex *a = exprAvaliaSegmento(no->a, i, j0, n, saida, rascunho);
+
+    switch (no->op)
+    {
+    case EXPR_SOMA:
+    case EXPR_SUBTRACAO:
+    {
+        const complex *b = exprAvaliaSegmento(no->b, i, j0, n, rascunho, rascunho + EXPR_SEGMENTO);
+
+        if (no->op == EXPR_SOMA)
+        {
+            for (int k = 0; k < n; k++)
+            {
+                saida[k].Re = a[k].Re + b[k].Re;
+                saida[k].Im = a[k].Im + b[k].Im;
+            }
+        }
+        else
+        {
+            for (int k = 0; k < n; k++)
+            {
+                saida[k].Re = a[k].Re - b[k].Re;
+                saida[k].Im = a[k].Im - b[k].Im;
+            }
+        }
+        break;
+    }
+    case EXPR_ESCALAR:
+        for (int k = 0; k < n; k++)
+        {
+            saida[k].Re = no->escalar * a[k].Re;
+            saida[k].Im = no->escalar * a[k].Im;
+        }
+        break;
+    case EXPR_CONJUGADA:
+        for (int k = 0; k < n; k++)
+        {
+            saida[k].Re = a[k].Re;
+            saida[k].Im = -a[k].Im;
+        }
+        break;
+    default:
+        break;
+    }
+
+    return saida;
+}
+
+/**
+ * @param[out] destino The matrix that receives the result
+ * @param[in] expr The expression
+ *
+ * @brief Evaluates the expression segment by segment; each segment is computed in L1 and then written to destino once.
+ *
+ * @return 0 on success, -1 if expr is NULL or destino does not have its shape.
+ */
+int matrixAvaliaEm(complexMatrix destino, const matrixExpr *expr)
+{
+    if (expr == NULL || destino.linhas != expr->linhas || destino.colunas != expr->colunas)
+    {
+        return -1;
+    }
+
+    //! One segment per level of the tree; the root also works in scratch, so destino may be a leaf
+    complex segmentos[MATRIX_EXPR_MAX_PROFUNDIDADE * EXPR_SEGMENTO];
+
+    for (int i = 0; i < destino.linhas; i++)
+    {
+        complex *linha = matrixLinha(destino, i);
+
+        for (int j0 = 0; j0 < destino.colunas; j0 += EXPR_SEGMENTO)
+        {
+            const int n = (destino.colunas - j0 < EXPR_SEGMENTO) ? destino.colunas - j0 : EXPR_SEGMENTO;
+            const complex *resultado = exprAvaliaSegmento(expr, i, j0, n, segmentos, segmentos + EXPR_SEGMENTO);
+
+            for (int k = 0; k < n; k++)
+            {
+                linha[j0 + k] = resultado[k];
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @param[in] expr The expression
+ *
+ * @brief Allocates a matrix of the shape of the expression and evaluates the expression into it.
+ *
+ * @return The result.
+ */
+complexMatrix matrixAvalia(const matrixExpr *expr)
+{
+    if (expr == NULL)
+    {
+        printf("Expressao invalida: dimensoes incompativeis\n");
+        exit(1);
+    }
+
+    complexMatrix resultado = allocateComplexMatrix(expr->linhas, expr->colunas);
+    matrixAvaliaEm(resultado, expr);
+
+    return resultado;
+}
+
+/************************************* TESTS ***************************************/
+
+/**
+ * @brief Checks the fused evaluation against the chain of one-operation calls it replaces.
+ *
+ * The expressions mix every node kind, have a view (leading dimension larger than the width) as a leaf,
+ * and are evaluated into a new matrix, into a separate destination and into one of their own leaves.
+ * Invalid expressions (shapes that do not agree, a tree deeper than MATRIX_EXPR_MAX_PROFUNDIDADE) and a
+ * destination of the wrong shape must give -1.
+ *
+ * @return The number of failed checks.
+ */
+int teste_expr(void)
+{
+    const int linhas = 37, colunas = 29;
+    const float tolerancia = 1e-5f;
+    matrixArena arena;
+    int falhas = 0;
+    int status;
+    float diferenca;
+
+    printf("\n  ============ Teste das expressoes avaliadas em uma passada ============ \n\n");
+
+    if (arenaInit(&arena, 1 << 16) != 0)
+    {
+        printf("Falha na alocacao de memoria\n");
+        exit(1);
+    }
+
+    complexMatrix A = allocateComplexMatrix(linhas, colunas);
+    complexMatrix B = allocateComplexMatrix(linhas, colunas);
+    complexMatrix grande = allocateComplexMatrix(linhas + 3, colunas + 5);
+    complexMatrix C = matrixView(grande, 2, 3, linhas, colunas);
+    complexMatrix esperado = allocateComplexMatrix(linhas, colunas);
+    complexMatrix temp = allocateComplexMatrix(linhas, colunas);
+    complexMatrix destino = allocateComplexMatrix(linhas, colunas);
+
+    testePreenche(A, 1);
+    testePreenche(B, 2);
+    testePreenche(grande, 3);
+
+    //! conj(2.5 (A + B) - C) + A, one call per operation
+    matrixSomaEm(temp, A, B);
+    matrix_produtoEscalarEm(destino, temp, 2.5f);
+    matrixSubtracaoEm(temp, destino, C);
+    matrixConjugadaEm(destino, temp);
+    matrixSomaEm(esperado, destino, A);
+
+    const matrixExpr *a = exprMatriz(&arena, A);
+    const matrixExpr *expr = exprSoma(&arena,
+                                      exprConjugada(&arena, exprSubtracao(&arena,
+                                                                          exprEscalar(&arena, exprSoma(&arena, a, exprMatriz(&arena, B)), 2.5f),
+                                                                          exprMatriz(&arena, C))),
+                                      a);
+
+    status = matrixAvaliaEm(destino, expr);
+    diferenca = testeDiferenca(destino, esperado);
+    falhas += testeConfere("matrixAvaliaEm  = cadeia de operacoes", status == 0 && diferenca < tolerancia, "diferenca %.2e", diferenca);
+
+    {
+        complexMatrix nova = matrixAvalia(expr);
+
+        diferenca = testeDiferenca(nova, esperado);
+        falhas += testeConfere("matrixAvalia  = cadeia de operacoes", diferenca < tolerancia, "diferenca %.2e", diferenca);
+        freeComplexMatrix(nova);
+    }
+
+    //! destino is the leaf A, read twice by the expression
+    status = matrixAvaliaEm(A, expr);
+    diferenca = testeDiferenca(A, esperado);
+    falhas += testeConfere("matrixAvaliaEm  destino = folha", status == 0 && diferenca < tolerancia, "diferenca %.2e", diferenca);
+
+    //! Shapes that do not agree: the constructor gives NULL and the evaluation -1
+    {
+        complexMatrix T = allocateComplexMatrix(colunas, linhas);
+        const matrixExpr *invalida = exprSoma(&arena, exprMatriz(&arena, B), exprMatriz(&arena, T));
+
+        falhas += testeConfere("exprSoma  dimensoes incompativeis", invalida == NULL && matrixAvaliaEm(destino, invalida) == -1, NULL);
+        falhas += testeConfere("matrixAvaliaEm  destino de outra forma", matrixAvaliaEm(T, exprMatriz(&arena, B)) == -1, NULL);
+        freeComplexMatrix(T);
+    }
+
+    //! A tree of exactly MATRIX_EXPR_MAX_PROFUNDIDADE levels is evaluated; one level more is rejected
+    {
+        const matrixExpr *profunda = exprMatriz(&arena, B);
+
+        //! The reference alternates between two buffers: esperado always holds the last product
+        matrix_produtoEscalarEm(esperado, B, 1.0f);
+        for (int nivel = 1; nivel < MATRIX_EXPR_MAX_PROFUNDIDADE; nivel++)
+        {
+            const complexMatrix anterior = esperado;
+
+            profunda = exprEscalar(&arena, profunda, 1.1f);
+            matrix_produtoEscalarEm(temp, anterior, 1.1f);
+            esperado = temp;
+            temp = anterior;
+        }
+
+        status = matrixAvaliaEm(destino, profunda);
+        diferenca = testeDiferenca(destino, esperado);
+        falhas += testeConfere("matrixAvaliaEm  profundidade maxima", status == 0 && diferenca < tolerancia, "diferenca %.2e", diferenca);
+
+        const matrixExpr *funda_demais = exprConjugada(&arena, profunda);
+        falhas += testeConfere("exprConjugada  profundidade demais", funda_demais == NULL && matrixAvaliaEm(destino, funda_demais) == -1, NULL);
+    }
+
+    freeComplexMatrix(A);
+    freeComplexMatrix(B);
+    freeComplexMatrix(grande);
+    freeComplexMatrix(esperado);
+    freeComplexMatrix(temp);
+    freeComplexMatrix(destino);
+    arenaFree(&arena);
+
+    return falhas;
+}
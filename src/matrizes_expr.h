@@ -0,0 +1,114 @@
+/**
+ * @file matrizes_expr.h
+ * @brief Header file for lazy element-wise matrix expressions, evaluated in a single fused pass.
+ */
+
+#ifndef MATRIZES_EXPR_H
+#define MATRIZES_EXPR_H
+#include "matrizes.h"
+#include "memoria.h"
+
+/*!
+* @brief Maximum depth of an expression tree (a single matrix has depth 1).
+*/
+#define MATRIX_EXPR_MAX_PROFUNDIDADE 16
+
+/*!
+* @brief Kind of node of an expression tree.
+*/
+typedef enum
+{
+    EXPR_MATRIZ,     /*!< Leaf: a complexMatrix */
+    EXPR_SOMA,       /*!< a + b */
+    EXPR_SUBTRACAO,  /*!< a - b */
+    EXPR_ESCALAR,    /*!< escalar * a */
+    EXPR_CONJUGADA   /*!< conj(a) */
+} matrixExprOp;
+
+/*!
+* @brief Node of a deferred element-wise expression over complexMatrix operands.
+*
+* Building an expression only records the operations; nothing is computed until matrixAvaliaEm,
+* which walks the tree over short row segments so the whole chain runs in one pass over the
+* operands, with no intermediate matrices. Nodes are carved from a matrixArena and released
+* with it (or back to a mark).
+*/
+typedef struct matrixExpr
+{
+    matrixExprOp op;               /*!< Operation of the node */
+    int linhas, colunas;           /*!< Shape of the result of the node */
+    int profundidade;              /*!< Depth of the subtree rooted at the node */
+    complexMatrix matrix;          /*!< Operand of a leaf */
+    float escalar;                 /*!< Factor of EXPR_ESCALAR */
+    const struct matrixExpr *a;    /*!< First (or only) child */
+    const struct matrixExpr *b;    /*!< Second child of the binary nodes */
+} matrixExpr;
+
+///****************************************** BUILDING EXPRESSIONS ****************************************************/
+///
+///-----> The constructors return NULL when an operand is NULL, when the shapes do not agree or when the
+///-----> tree would be deeper than MATRIX_EXPR_MAX_PROFUNDIDADE, so errors propagate up to the evaluation.
+///-----> If the arena is exhausted, an error message is printed and the program terminates.
+///
+
+/**
+ * @brief Leaf node referring to a matrix (the matrix is not copied and must outlive the expression).
+ */
+const matrixExpr *exprMatriz(matrixArena *arena, complexMatrix matrix);
+
+/**
+ * @brief Deferred a + b.
+ */
+const matrixExpr *exprSoma(matrixArena *arena, const matrixExpr *a, const matrixExpr *b);
+
+/**
+ * @brief Deferred a - b.
+ */
+const matrixExpr *exprSubtracao(matrixArena *arena, const matrixExpr *a, const matrixExpr *b);
+
+/**
+ * @brief Deferred num * a.
+ */
+const matrixExpr *exprEscalar(matrixArena *arena, const matrixExpr *a, float num);
+
+/**
+ * @brief Deferred conj(a).
+ */
+const matrixExpr *exprConjugada(matrixArena *arena, const matrixExpr *a);
+
+///****************************************** EVALUATION ****************************************************/
+
+/**
+ * @brief Evaluates an expression into destino in a single pass.
+ *
+ * destino may be one of the leaf matrices (each element only depends on the elements at the same
+ * position), but not a view that overlaps a leaf at another position.
+ *
+ * @param destino The complexMatrix that receives the result.
+ * @param expr The expression.
+ * @return 0 on success, -1 if expr is NULL or destino does not have its shape.
+ */
+int matrixAvaliaEm(complexMatrix destino, const matrixExpr *expr);
+
+/**
+ * @brief Evaluates an expression into a newly allocated matrix.
+ *
+ * If expr is NULL (an invalid expression), an error message is printed and the program terminates.
+ *
+ * @param expr The expression.
+ * @return The result.
+ */
+complexMatrix matrixAvalia(const matrixExpr *expr);
+
+///****************************************** TESTS ****************************************************/
+
+/**
+ * @brief Checks matrixAvaliaEm and matrixAvalia against the equivalent chains of matrixSomaEm,
+ * matrixSubtracaoEm, matrix_produtoEscalarEm and matrixConjugadaEm, with destino aliasing a leaf, and the
+ * -1 of shapes that do not agree and of trees deeper than MATRIX_EXPR_MAX_PROFUNDIDADE.
+ *
+ * @return The number of failed checks.
+ */
+int teste_expr(void);
+
+#endif
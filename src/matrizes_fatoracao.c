@@ -0,0 +1,1245 @@
+/**
+ * @file matrizes_fatoracao.c
+ * @brief Implementation file for the complex factorizations, linear solvers and ZF/MMSE filters.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <stdint.h>
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+/// including the files where the structures are contained
+#include "matrizes_fatoracao.h"
+#include "matrizes.h"
+#include "matrizes_lote.h"
+#include "teste.h"
+
+/*
+ * Every kernel is written on rows: the matrices are stored row after row, so the inner loops are
+ * row updates y += f x and conjugated dot products, the two helpers below, vectorized with AVX2.
+ * Column accesses only happen in the pivot search and in the Householder vectors.
+ */
+
+/************************************* ROW HELPERS ***************************************/
+
+static inline complex cMul(complex a, complex b)
+{
+    complex r = {a.Re * b.Re - a.Im * b.Im, a.Re * b.Im + a.Im * b.Re};
+    return r;
+}
+
+static inline complex cInverso(complex a) //!< 1 / a = conj(a) / |a|^2
+{
+    const float modulo2 = a.Re * a.Re + a.Im * a.Im;
+    complex r = {a.Re / modulo2, -a.Im / modulo2};
+    return r;
+}
+
+static inline float cModulo2(complex a)
+{
+    return a.Re * a.Re + a.Im * a.Im;
+}
+
+/**
+ * @brief y[c] += f * x[c] for c = 0 .. n - 1.
+ */
+static void fatLinhaMulSoma(complex *y, complex f, const complex *x, int n)
+{
+    int c = 0;
+
+#if defined(__AVX2__) && defined(__FMA__)
+    const __m256 fr = _mm256_set1_ps(f.Re), fi = _mm256_set1_ps(f.Im);
+
+    for (; c + 4 <= n; c += 4)
+    {
+        //! (fr xr - fi xi, fr xi + fi xr) from x and x with its parts swapped
+        const __m256 xv = _mm256_loadu_ps(&x[c].Re);
+        const __m256 produto = _mm256_fmaddsub_ps(fr, xv, _mm256_mul_ps(fi, _mm256_permute_ps(xv, 0xB1)));
+
+        _mm256_storeu_ps(&y[c].Re, _mm256_add_ps(_mm256_loadu_ps(&y[c].Re), produto));
+    }
+#endif
+    for (; c < n; c++)
+    {
+        y[c].Re += f.Re * x[c].Re - f.Im * x[c].Im;
+        y[c].Im += f.Re * x[c].Im + f.Im * x[c].Re;
+    }
+}
+
+/**
+ * @brief Returns the sum of a[c] * conj(b[c]) for c = 0 .. n - 1.
+ */
+static complex fatProdutoConj(const complex *a, const complex *b, int n)
+{
+    complex s = {0.0f, 0.0f};
+    int c = 0;
+
+#if defined(__AVX2__) && defined(__FMA__)
+    __m256 diretos = _mm256_setzero_ps(), cruzados = _mm256_setzero_ps();
+
+    for (; c + 4 <= n; c += 4)
+    {
+        const __m256 av = _mm256_loadu_ps(&a[c].Re);
+        const __m256 bv = _mm256_loadu_ps(&b[c].Re);
+
+        //! diretos: ar br, ai bi; cruzados: ar bi, ai br
+        diretos = _mm256_fmadd_ps(av, bv, diretos);
+        cruzados = _mm256_fmadd_ps(av, _mm256_permute_ps(bv, 0xB1), cruzados);
+    }
+
+    float d[8], x[8];
+    _mm256_storeu_ps(d, diretos);
+    _mm256_storeu_ps(x, cruzados);
+
+    for (int l = 0; l < 8; l += 2)
+    {
+        s.Re += d[l] + d[l + 1];
+        s.Im += x[l + 1] - x[l];
+    }
+#endif
+    for (; c < n; c++)
+    {
+        s.Re += a[c].Re * b[c].Re + a[c].Im * b[c].Im;
+        s.Im += a[c].Im * b[c].Re - a[c].Re * b[c].Im;
+    }
+
+    return s;
+}
+
+/**
+ * @brief Copies origem into destino row by row, unless they are the same storage.
+ */
+static void fatCopia(complexMatrix destino, complexMatrix origem)
+{
+    if (destino.dados == origem.dados)
+    {
+        return;
+    }
+
+    for (int i = 0; i < origem.linhas; i++)
+    {
+        memmove(matrixLinha(destino, i), matrixLinha(origem, i), (size_t)origem.colunas * sizeof(complex));
+    }
+}
+
+/**
+ * @brief Swaps rows p and q of a matrix.
+ */
+static void fatTrocaLinhas(complexMatrix matrix, int p, int q)
+{
+    complex *a = matrixLinha(matrix, p);
+    complex *b = matrixLinha(matrix, q);
+
+    for (int c = 0; c < matrix.colunas; c++)
+    {
+        const complex t = a[c];
+        a[c] = b[c];
+        b[c] = t;
+    }
+}
+
+/**
+ * @brief Multiplies row i of a matrix by f.
+ */
+static void fatEscalaLinha(complexMatrix matrix, int i, complex f)
+{
+    complex *a = matrixLinha(matrix, i);
+
+    for (int c = 0; c < matrix.colunas; c++)
+    {
+        a[c] = cMul(a[c], f);
+    }
+}
+
+/**
+ * @brief Back substitution R X = X in place, for an upper triangular R (n x n) and X (n x k).
+ *
+ * @return 0 on success, -1 if R has a zero on the diagonal.
+ */
+static int fatSubstituicaoTriangularSuperior(complexMatrix X, complexMatrix R)
+{
+    const int n = R.linhas;
+
+    for (int i = n - 1; i >= 0; i--)
+    {
+        const complex *r = matrixLinha(R, i);
+
+        if (cModulo2(r[i]) == 0.0f)
+        {
+            return -1;
+        }
+
+        for (int p = i + 1; p < n; p++)
+        {
+            const complex f = {-r[p].Re, -r[p].Im};
+            fatLinhaMulSoma(matrixLinha(X, i), f, matrixLinha(X, p), X.colunas);
+        }
+
+        fatEscalaLinha(X, i, cInverso(r[i]));
+    }
+
+    return 0;
+}
+
+/************************************* FACTORIZATIONS ***************************************/
+
+/**
+ * @param[out] L The lower triangular factor (may be matrix)
+ * @param[in] matrix The Hermitian positive definite matrix
+ *
+ * @brief Row-oriented Cholesky: l(i, j) = (a(i, j) - sum_p l(i, p) conj(l(j, p))) / l(j, j).
+ *
+ * Every entry of the lower triangle is read from matrix before the same entry of L is written,
+ * so the factorization can run in place.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree or the matrix is not positive definite.
+ */
+int matrixCholeskyEm(complexMatrix L, complexMatrix matrix)
+{
+    if (matrix.linhas != matrix.colunas || L.linhas != matrix.linhas || L.colunas != matrix.colunas)
+    {
+        return -1;
+    }
+
+    const int n = matrix.linhas;
+
+    for (int i = 0; i < n; i++)
+    {
+        const complex *a = matrixLinha(matrix, i);
+        complex *li = matrixLinha(L, i);
+
+        for (int j = 0; j <= i; j++)
+        {
+            const complex *lj = matrixLinha(L, j);
+            const complex soma = fatProdutoConj(li, lj, j);
+            const complex s = {a[j].Re - soma.Re, a[j].Im - soma.Im};
+
+            if (j == i)
+            {
+                //! The diagonal of a Hermitian matrix is real; a non-positive pivot means not positive definite
+                if (!(s.Re > 0.0f))
+                {
+                    return -1;
+                }
+
+                li[i].Re = sqrtf(s.Re);
+                li[i].Im = 0.0f;
+            }
+            else
+            {
+                li[j].Re = s.Re / lj[j].Re;
+                li[j].Im = s.Im / lj[j].Re;
+            }
+        }
+
+        for (int j = i + 1; j < n; j++)
+        {
+            li[j].Re = 0.0f;
+            li[j].Im = 0.0f;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @param[out] LU The factors (may be matrix)
+ * @param[out] pivos The pivot rows
+ * @param[in] matrix The square matrix
+ *
+ * @brief Right-looking LU with partial pivoting: at step k the row with the largest |a(r, k)| is moved
+ * up and its multiples are subtracted from the rows below.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree or the matrix is singular.
+ */
+int matrixLUEm(complexMatrix LU, int *pivos, complexMatrix matrix)
+{
+    if (matrix.linhas != matrix.colunas || LU.linhas != matrix.linhas || LU.colunas != matrix.colunas)
+    {
+        return -1;
+    }
+
+    const int n = matrix.linhas;
+
+    fatCopia(LU, matrix);
+
+    for (int k = 0; k < n; k++)
+    {
+        int pivo = k;
+
+        for (int r = k + 1; r < n; r++)
+        {
+            if (cModulo2(MATRIX_ELEM(LU, r, k)) > cModulo2(MATRIX_ELEM(LU, pivo, k)))
+            {
+                pivo = r;
+            }
+        }
+
+        pivos[k] = pivo;
+
+        if (cModulo2(MATRIX_ELEM(LU, pivo, k)) == 0.0f)
+        {
+            return -1;
+        }
+
+        if (pivo != k)
+        {
+            fatTrocaLinhas(LU, k, pivo);
+        }
+
+        const complex *linhaK = matrixLinha(LU, k);
+        const complex inverso = cInverso(linhaK[k]);
+
+        for (int r = k + 1; r < n; r++)
+        {
+            complex *linhaR = matrixLinha(LU, r);
+            const complex f = cMul(linhaR[k], inverso);
+            const complex menosF = {-f.Re, -f.Im};
+
+            linhaR[k] = f;
+            fatLinhaMulSoma(linhaR + k + 1, menosF, linhaK + k + 1, n - k - 1);
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @param[out] Q The matrix with orthonormal columns (m x n)
+ * @param[out] R The upper triangular factor (n x n)
+ * @param[in] matrix The matrix A (m x n, m >= n)
+ *
+ * @brief Householder QR, working on Q.
+ *
+ * Step k reflects the column x = A(k:m, k) onto alpha e1, with alpha = -e^(i arg x0) |x|, using
+ * H = I - v v^H with |v|^2 = 2. The vectors v are kept in the columns of Q, and Q is then formed in
+ * place by applying the reflections backwards to the first n columns of the identity.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree or m < n.
+ */
+int matrixQREm(complexMatrix Q, complexMatrix R, complexMatrix matrix)
+{
+    const int m = matrix.linhas;
+    const int n = matrix.colunas;
+
+    if (m < n || Q.linhas != m || Q.colunas != n || R.linhas != n || R.colunas != n)
+    {
+        return -1;
+    }
+
+    //! w = v^H A(k:m, k+1:n), one entry per column to the right of k
+    complex *w = (complex *)malloc((size_t)(n > 0 ? n : 1) * sizeof(complex));
+
+    if (w == NULL)
+    {
+        printf("Falha na alocacao de memoria\n");
+        exit(1);
+    }
+
+    fatCopia(Q, matrix);
+
+    for (int k = 0; k < n; k++)
+    {
+        const int resto = n - k - 1;
+        float norma2 = 0.0f;
+
+        for (int r = k; r < m; r++)
+        {
+            norma2 += cModulo2(MATRIX_ELEM(Q, r, k));
+        }
+
+        const float norma = sqrtf(norma2);
+        const complex x0 = MATRIX_ELEM(Q, k, k);
+        const float modulo0 = sqrtf(cModulo2(x0));
+        complex fase = {1.0f, 0.0f};
+
+        if (modulo0 > 0.0f)
+        {
+            fase.Re = x0.Re / modulo0;
+            fase.Im = x0.Im / modulo0;
+        }
+
+        complex *linhaR = matrixLinha(R, k);
+
+        for (int j = 0; j < k; j++)
+        {
+            linhaR[j].Re = 0.0f;
+            linhaR[j].Im = 0.0f;
+        }
+
+        linhaR[k].Re = -fase.Re * norma;
+        linhaR[k].Im = -fase.Im * norma;
+
+        if (norma == 0.0f)
+        {
+            //! Null column: H = I, kept as v = 0
+            for (int j = k + 1; j < n; j++)
+            {
+                linhaR[j] = MATRIX_ELEM(Q, k, j);
+            }
+            continue;
+        }
+
+        //! v = (x - alpha e1) / sqrt(|x| (|x| + |x0|)), so that |v|^2 = 2
+        const float escala = 1.0f / sqrtf(norma * (norma + modulo0));
+
+        MATRIX_ELEM(Q, k, k).Re = (x0.Re + fase.Re * norma) * escala;
+        MATRIX_ELEM(Q, k, k).Im = (x0.Im + fase.Im * norma) * escala;
+
+        for (int r = k + 1; r < m; r++)
+        {
+            MATRIX_ELEM(Q, r, k).Re *= escala;
+            MATRIX_ELEM(Q, r, k).Im *= escala;
+        }
+
+        //! A(k:m, k+1:n) -= v (v^H A(k:m, k+1:n))
+        if (resto > 0)
+        {
+            memset(w, 0, (size_t)resto * sizeof(complex));
+
+            for (int r = k; r < m; r++)
+            {
+                const complex v = MATRIX_ELEM(Q, r, k);
+                const complex vConj = {v.Re, -v.Im};
+
+                fatLinhaMulSoma(w, vConj, matrixLinha(Q, r) + k + 1, resto);
+            }
+
+            for (int r = k; r < m; r++)
+            {
+                const complex v = MATRIX_ELEM(Q, r, k);
+                const complex menosV = {-v.Re, -v.Im};
+
+                fatLinhaMulSoma(matrixLinha(Q, r) + k + 1, menosV, w, resto);
+            }
+        }
+
+        for (int j = k + 1; j < n; j++)
+        {
+            linhaR[j] = MATRIX_ELEM(Q, k, j);
+        }
+    }
+
+    //! Q = H_0 H_1 ... H_(n-1) [I; 0], accumulated from the last reflection to the first
+    for (int k = n - 1; k >= 0; k--)
+    {
+        const int resto = n - k - 1;
+
+        if (resto > 0)
+        {
+            memset(w, 0, (size_t)resto * sizeof(complex));
+
+            for (int r = k; r < m; r++)
+            {
+                const complex v = MATRIX_ELEM(Q, r, k);
+                const complex vConj = {v.Re, -v.Im};
+
+                fatLinhaMulSoma(w, vConj, matrixLinha(Q, r) + k + 1, resto);
+            }
+
+            for (int r = k; r < m; r++)
+            {
+                const complex v = MATRIX_ELEM(Q, r, k);
+                const complex menosV = {-v.Re, -v.Im};
+
+                fatLinhaMulSoma(matrixLinha(Q, r) + k + 1, menosV, w, resto);
+            }
+        }
+
+        //! Column k becomes H_k e_k = e_k - v conj(v0)
+        const complex v0 = MATRIX_ELEM(Q, k, k);
+        const complex c = {-v0.Re, v0.Im};
+
+        for (int r = k + 1; r < m; r++)
+        {
+            MATRIX_ELEM(Q, r, k) = cMul(MATRIX_ELEM(Q, r, k), c);
+        }
+
+        MATRIX_ELEM(Q, k, k).Re = 1.0f - cModulo2(v0);
+        MATRIX_ELEM(Q, k, k).Im = 0.0f;
+
+        for (int r = 0; r < k; r++)
+        {
+            MATRIX_ELEM(Q, r, k).Re = 0.0f;
+            MATRIX_ELEM(Q, r, k).Im = 0.0f;
+        }
+    }
+
+    free(w);
+
+    return 0;
+}
+
+/************************************* SOLVERS ***************************************/
+
+/**
+ * @param[out] X The solution (may be B)
+ * @param[in] LU The factors of matrixLUEm
+ * @param[in] pivos The pivot rows of matrixLUEm
+ * @param[in] B The right-hand sides
+ *
+ * @brief Applies the row exchanges to B, then solves L Y = P B and U X = Y, row by row.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree or U has a zero on the diagonal.
+ */
+int matrixLUSolveEm(complexMatrix X, complexMatrix LU, const int *pivos, complexMatrix B)
+{
+    const int n = LU.linhas;
+
+    if (LU.colunas != n || B.linhas != n || X.linhas != n || X.colunas != B.colunas)
+    {
+        return -1;
+    }
+
+    fatCopia(X, B);
+
+    for (int k = 0; k < n; k++)
+    {
+        if (pivos[k] != k)
+        {
+            fatTrocaLinhas(X, k, pivos[k]);
+        }
+    }
+
+    //! Unit lower triangle
+    for (int i = 1; i < n; i++)
+    {
+        const complex *l = matrixLinha(LU, i);
+
+        for (int p = 0; p < i; p++)
+        {
+            const complex f = {-l[p].Re, -l[p].Im};
+            fatLinhaMulSoma(matrixLinha(X, i), f, matrixLinha(X, p), X.colunas);
+        }
+    }
+
+    return fatSubstituicaoTriangularSuperior(X, LU);
+}
+
+/**
+ * @param[out] X The solution (may be B)
+ * @param[in] L The factor of matrixCholeskyEm
+ * @param[in] B The right-hand sides
+ *
+ * @brief Forward substitution with L, then back substitution with L^H (read from the columns of L).
+ *
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixCholeskySolveEm(complexMatrix X, complexMatrix L, complexMatrix B)
+{
+    const int n = L.linhas;
+
+    if (L.colunas != n || B.linhas != n || X.linhas != n || X.colunas != B.colunas)
+    {
+        return -1;
+    }
+
+    fatCopia(X, B);
+
+    for (int i = 0; i < n; i++)
+    {
+        const complex *l = matrixLinha(L, i);
+
+        for (int p = 0; p < i; p++)
+        {
+            const complex f = {-l[p].Re, -l[p].Im};
+            fatLinhaMulSoma(matrixLinha(X, i), f, matrixLinha(X, p), X.colunas);
+        }
+
+        const complex inverso = {1.0f / l[i].Re, 0.0f};
+        fatEscalaLinha(X, i, inverso);
+    }
+
+    //! L^H(i, p) = conj(L(p, i))
+    for (int i = n - 1; i >= 0; i--)
+    {
+        for (int p = i + 1; p < n; p++)
+        {
+            const complex lpi = MATRIX_ELEM(L, p, i);
+            const complex f = {-lpi.Re, lpi.Im};
+            fatLinhaMulSoma(matrixLinha(X, i), f, matrixLinha(X, p), X.colunas);
+        }
+
+        const complex inverso = {1.0f / MATRIX_ELEM(L, i, i).Re, 0.0f};
+        fatEscalaLinha(X, i, inverso);
+    }
+
+    return 0;
+}
+
+/**
+ * @param[out] X The least-squares solution
+ * @param[in] Q The factor Q of matrixQREm
+ * @param[in] R The factor R of matrixQREm
+ * @param[in] B The right-hand sides
+ *
+ * @brief X = Q^H B (read from Q in place), then back substitution with R.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree or R is singular.
+ */
+int matrixQRSolveEm(complexMatrix X, complexMatrix Q, complexMatrix R, complexMatrix B)
+{
+    const int n = Q.colunas;
+
+    if (R.linhas != n || R.colunas != n || matrixProdutoAhBEm(X, Q, B) != 0)
+    {
+        return -1;
+    }
+
+    return fatSubstituicaoTriangularSuperior(X, R);
+}
+
+/**
+ * @param[out] X The solution (may be B)
+ * @param[in] A The square matrix
+ * @param[in] B The right-hand sides
+ *
+ * @brief LU of a copy of A, then matrixLUSolveEm.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree or A is singular.
+ */
+int matrixSolveEm(complexMatrix X, complexMatrix A, complexMatrix B)
+{
+    const int n = A.linhas;
+
+    if (A.colunas != n || B.linhas != n || X.linhas != n || X.colunas != B.colunas)
+    {
+        return -1;
+    }
+
+    complexMatrix LU = allocateComplexMatrix(n, n);
+    int *pivos = (int *)malloc((size_t)(n > 0 ? n : 1) * sizeof(int));
+
+    if (pivos == NULL)
+    {
+        printf("Falha na alocacao de memoria\n");
+        exit(1);
+    }
+
+    int resultado = matrixLUEm(LU, pivos, A);
+
+    if (resultado == 0)
+    {
+        resultado = matrixLUSolveEm(X, LU, pivos, B);
+    }
+
+    free(pivos);
+    freeComplexMatrix(LU);
+
+    return resultado;
+}
+
+/**
+ * @param[out] destino The inverse (may be matrix)
+ * @param[in] matrix The square matrix
+ *
+ * @brief Solves A X = I with the LU factorization of a copy of A.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree or the matrix is singular.
+ */
+int matrixInversaEm(complexMatrix destino, complexMatrix matrix)
+{
+    const int n = matrix.linhas;
+
+    if (matrix.colunas != n || destino.linhas != n || destino.colunas != n)
+    {
+        return -1;
+    }
+
+    complexMatrix LU = allocateComplexMatrix(n, n);
+    int *pivos = (int *)malloc((size_t)(n > 0 ? n : 1) * sizeof(int));
+
+    if (pivos == NULL)
+    {
+        printf("Falha na alocacao de memoria\n");
+        exit(1);
+    }
+
+    int resultado = matrixLUEm(LU, pivos, matrix);
+
+    if (resultado == 0)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            complex *linha = matrixLinha(destino, i);
+
+            for (int j = 0; j < n; j++)
+            {
+                linha[j].Re = (i == j) ? 1.0f : 0.0f;
+                linha[j].Im = 0.0f;
+            }
+        }
+
+        resultado = matrixLUSolveEm(destino, LU, pivos, destino);
+    }
+
+    free(pivos);
+    freeComplexMatrix(LU);
+
+    return resultado;
+}
+
+/************************************* EQUALIZATION FILTERS ***************************************/
+
+/**
+ * @param[out] W The zero-forcing filter (n x m)
+ * @param[in] H The channel (m x n, m >= n)
+ *
+ * @brief W = R^-1 Q^H: the normal equations are never formed, so the conditioning is that of H, not of H^H H.
+ *
+ * H is taken as rank deficient when a diagonal entry of R is below m * FLT_EPSILON times the largest one.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree or H does not have full column rank.
+ */
+int matrixZFEm(complexMatrix W, complexMatrix H)
+{
+    const int m = H.linhas, n = H.colunas;
+
+    if (m < n || W.linhas != n || W.colunas != m)
+    {
+        return -1;
+    }
+
+    complexMatrix Q = allocateComplexMatrix(m, n);
+    complexMatrix R = allocateComplexMatrix(n, n);
+
+    matrixQREm(Q, R, H);
+
+    //! Numerical rank: a diagonal entry of R lost in the rounding of the largest one means H is rank deficient
+    float maior = 0.0f;
+
+    for (int i = 0; i < n; i++)
+    {
+        const float d = cModulo2(MATRIX_ELEM(R, i, i));
+        maior = (d > maior) ? d : maior;
+    }
+
+    const float limite = FLT_EPSILON * (float)m * sqrtf(maior);
+    int resultado = (n > 0 && maior == 0.0f) ? -1 : 0;
+
+    for (int i = 0; i < n && resultado == 0; i++)
+    {
+        if (sqrtf(cModulo2(MATRIX_ELEM(R, i, i))) <= limite)
+        {
+            resultado = -1;
+        }
+    }
+
+    if (resultado == 0)
+    {
+        matrixHermitianaEm(W, Q);
+        resultado = fatSubstituicaoTriangularSuperior(W, R);
+    }
+
+    freeComplexMatrix(Q);
+    freeComplexMatrix(R);
+
+    return resultado;
+}
+
+/**
+ * @param[out] W The MMSE filter (n x m)
+ * @param[in] H The channel (m x n)
+ * @param[in] sigma2 The noise variance
+ *
+ * @brief G = H^H H + sigma2 I is factored as L L^H, and L L^H W = H^H is solved in place on W.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree or G is not positive definite.
+ */
+int matrixMMSEEm(complexMatrix W, complexMatrix H, float sigma2)
+{
+    const int m = H.linhas, n = H.colunas;
+
+    if (W.linhas != n || W.colunas != m)
+    {
+        return -1;
+    }
+
+    complexMatrix G = allocateComplexMatrix(n, n);
+
+    matrixGramEm(G, H);
+
+    for (int i = 0; i < n; i++)
+    {
+        MATRIX_ELEM(G, i, i).Re += sigma2;
+    }
+
+    int resultado = matrixCholeskyEm(G, G);
+
+    if (resultado == 0)
+    {
+        matrixHermitianaEm(W, H);
+        resultado = matrixCholeskySolveEm(W, G, W);
+    }
+
+    freeComplexMatrix(G);
+
+    return resultado;
+}
+
+/************************************* TESTS ***************************************/
+
+/**
+ * @brief Frobenius norm of a - b divided by the Frobenius norm of b (or of a - b if b is zero).
+ */
+static float testeFatoracaoResiduo(complexMatrix a, complexMatrix b)
+{
+    double diferenca = 0.0, norma = 0.0;
+
+    for (int i = 0; i < a.linhas; i++)
+    {
+        for (int j = 0; j < a.colunas; j++)
+        {
+            const double re = (double)MATRIX_ELEM(a, i, j).Re - MATRIX_ELEM(b, i, j).Re;
+            const double im = (double)MATRIX_ELEM(a, i, j).Im - MATRIX_ELEM(b, i, j).Im;
+            diferenca += re * re + im * im;
+            norma += (double)MATRIX_ELEM(b, i, j).Re * MATRIX_ELEM(b, i, j).Re + (double)MATRIX_ELEM(b, i, j).Im * MATRIX_ELEM(b, i, j).Im;
+        }
+    }
+
+    return (float)sqrt(diferenca / (norma > 0.0 ? norma : 1.0));
+}
+
+/**
+ * @brief Frobenius norm of a matrix.
+ */
+static float testeFatoracaoNorma(complexMatrix a)
+{
+    double norma = 0.0;
+
+    for (int i = 0; i < a.linhas; i++)
+    {
+        for (int j = 0; j < a.colunas; j++)
+        {
+            norma += (double)MATRIX_ELEM(a, i, j).Re * MATRIX_ELEM(a, i, j).Re + (double)MATRIX_ELEM(a, i, j).Im * MATRIX_ELEM(a, i, j).Im;
+        }
+    }
+
+    return (float)sqrt(norma);
+}
+
+/**
+ * @brief Writes the identity into a square matrix.
+ */
+static void testeFatoracaoIdentidade(complexMatrix matrix)
+{
+    for (int i = 0; i < matrix.linhas; i++)
+    {
+        for (int j = 0; j < matrix.colunas; j++)
+        {
+            MATRIX_ELEM(matrix, i, j).Re = (i == j) ? 1.0f : 0.0f;
+            MATRIX_ELEM(matrix, i, j).Im = 0.0f;
+        }
+    }
+}
+
+/**
+ * @brief Largest difference between lane b of a batch and a complexMatrix of the same shape.
+ */
+static float testeFatoracaoDiferencaLane(complexMatrixLote lote, int b, complexMatrix matrix)
+{
+    float maxima = 0.0f;
+
+    for (int i = 0; i < matrix.linhas; i++)
+    {
+        for (int j = 0; j < matrix.colunas; j++)
+        {
+            const size_t e = ((size_t)i * lote.colunas + j) * lote.passo + b;
+            maxima = fmaxf(maxima, fabsf(lote.Re[e] - MATRIX_ELEM(matrix, i, j).Re));
+            maxima = fmaxf(maxima, fabsf(lote.Im[e] - MATRIX_ELEM(matrix, i, j).Im));
+        }
+    }
+
+    return maxima;
+}
+
+/**
+ * @brief Checks the factorizations, solvers and filters through their residuals, the -1 returns of
+ * singular, not positive definite and rank deficient inputs, and the batched versions lane by lane.
+ *
+ * @return The number of failed checks.
+ */
+int teste_fatoracao(void)
+{
+    const float tolerancia = 1e-4f;
+    const int n = 6, m = 9, k = 4;
+    int falhas = 0;
+    float residuo;
+
+    printf("\n  ============ Teste das fatoracoes e solvers ============ \n\n");
+
+    complexMatrix A = allocateComplexMatrix(n, n);
+    complexMatrix M = allocateComplexMatrix(m, n);
+    complexMatrix H = allocateComplexMatrix(m, k);
+    complexMatrix B = allocateComplexMatrix(n, 3);
+    complexMatrix Bm = allocateComplexMatrix(m, 3);
+    complexMatrix X = allocateComplexMatrix(n, 3);
+    complexMatrix AX = allocateComplexMatrix(n, 3);
+    complexMatrix F = allocateComplexMatrix(n, n);
+    complexMatrix T = allocateComplexMatrix(n, n);
+    complexMatrix I = allocateComplexMatrix(n, n);
+    complexMatrix Ik = allocateComplexMatrix(k, k);
+    int pivos[6];
+
+    testePreenche(A, 1);
+    testePreenche(M, 2);
+    testePreenche(H, 3);
+    testePreenche(B, 4);
+    testePreenche(Bm, 5);
+    testeFatoracaoIdentidade(I);
+    testeFatoracaoIdentidade(Ik);
+
+    //! Hermitian positive definite S = M^H M + I
+    complexMatrix S = allocateComplexMatrix(n, n);
+    matrixGramEm(S, M);
+    for (int i = 0; i < n; i++)
+    {
+        MATRIX_ELEM(S, i, i).Re += 1.0f;
+    }
+
+    /* Cholesky: ||L L^H - S|| / ||S|| */
+    int status = matrixCholeskyEm(F, S);
+    matrixProdutoABhEm(T, F, F);
+    residuo = testeFatoracaoResiduo(T, S);
+    falhas += testeConfere("matrixCholeskyEm  L L^H = S", status == 0 && residuo < tolerancia, "residuo %.2e", residuo);
+
+    status = matrixCholeskySolveEm(X, F, B);
+    matrixProdutoEm(AX, S, X);
+    residuo = testeFatoracaoResiduo(AX, B);
+    falhas += testeConfere("matrixCholeskySolveEm  S X = B", status == 0 && residuo < tolerancia, "residuo %.2e", residuo);
+
+    /* LU: P A = L U, rebuilt from the packed factors and the LAPACK-style pivots */
+    status = matrixLUEm(F, pivos, A);
+    {
+        complexMatrix L = allocateComplexMatrix(n, n);
+        complexMatrix U = allocateComplexMatrix(n, n);
+        complexMatrix PA = allocateComplexMatrix(n, n);
+
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                const complex zero = {0.0f, 0.0f};
+                const complex um = {1.0f, 0.0f};
+
+                MATRIX_ELEM(L, i, j) = (i > j) ? MATRIX_ELEM(F, i, j) : ((i == j) ? um : zero);
+                MATRIX_ELEM(U, i, j) = (i <= j) ? MATRIX_ELEM(F, i, j) : zero;
+                MATRIX_ELEM(PA, i, j) = MATRIX_ELEM(A, i, j);
+            }
+        }
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                const complex troca = MATRIX_ELEM(PA, i, j);
+                MATRIX_ELEM(PA, i, j) = MATRIX_ELEM(PA, pivos[i], j);
+                MATRIX_ELEM(PA, pivos[i], j) = troca;
+            }
+        }
+
+        matrixProdutoEm(T, L, U);
+        residuo = testeFatoracaoResiduo(T, PA);
+        falhas += testeConfere("matrixLUEm  P A = L U", status == 0 && residuo < tolerancia, "residuo %.2e", residuo);
+
+        freeComplexMatrix(L);
+        freeComplexMatrix(U);
+        freeComplexMatrix(PA);
+    }
+
+    status = matrixLUSolveEm(X, F, pivos, B);
+    matrixProdutoEm(AX, A, X);
+    residuo = testeFatoracaoResiduo(AX, B);
+    falhas += testeConfere("matrixLUSolveEm  A X = B", status == 0 && residuo < tolerancia, "residuo %.2e", residuo);
+
+    //! A zero on the diagonal of U must reach the caller
+    MATRIX_ELEM(F, n - 1, n - 1).Re = 0.0f;
+    MATRIX_ELEM(F, n - 1, n - 1).Im = 0.0f;
+    falhas += testeConfere("matrixLUSolveEm  U singular", matrixLUSolveEm(X, F, pivos, B) == -1, NULL);
+
+    status = matrixSolveEm(X, A, B);
+    matrixProdutoEm(AX, A, X);
+    residuo = testeFatoracaoResiduo(AX, B);
+    falhas += testeConfere("matrixSolveEm  A X = B", status == 0 && residuo < tolerancia, "residuo %.2e", residuo);
+
+    status = matrixInversaEm(F, A);
+    matrixProdutoEm(T, A, F);
+    residuo = testeFatoracaoResiduo(T, I);
+    falhas += testeConfere("matrixInversaEm  A A^-1 = I", status == 0 && residuo < tolerancia, "residuo %.2e", residuo);
+
+    /* QR: ||Q R - M|| / ||M||, ||Q^H Q - I|| and the normal equations of the least-squares solution */
+    {
+        complexMatrix Q = allocateComplexMatrix(m, n);
+        complexMatrix R = allocateComplexMatrix(n, n);
+        complexMatrix QR = allocateComplexMatrix(m, n);
+        complexMatrix MX = allocateComplexMatrix(m, 3);
+        complexMatrix normal = allocateComplexMatrix(n, 3);
+
+        status = matrixQREm(Q, R, M);
+        matrixProdutoEm(QR, Q, R);
+        residuo = testeFatoracaoResiduo(QR, M);
+        falhas += testeConfere("matrixQREm  Q R = M", status == 0 && residuo < tolerancia, "residuo %.2e", residuo);
+
+        matrixGramEm(T, Q);
+        residuo = testeFatoracaoResiduo(T, I);
+        falhas += testeConfere("matrixQREm  Q^H Q = I", residuo < tolerancia, "residuo %.2e", residuo);
+
+        status = matrixQRSolveEm(X, Q, R, Bm);
+        matrixProdutoEm(MX, M, X);
+        matrixSubtracaoEm(MX, MX, Bm);
+        matrixProdutoAhBEm(normal, M, MX);
+        residuo = testeFatoracaoNorma(normal) / testeFatoracaoNorma(Bm);
+        falhas += testeConfere("matrixQRSolveEm  M^H (M X - B) = 0", status == 0 && residuo < tolerancia, "residuo %.2e", residuo);
+
+        complexMatrix larga = matrixView(M, 0, 0, n - 1, n);
+        complexMatrix Ql = allocateComplexMatrix(n - 1, n);
+        falhas += testeConfere("matrixQREm  m < n devolve -1", matrixQREm(Ql, R, larga) == -1, "residuo %.2e", 0.0f);
+
+        freeComplexMatrix(Ql);
+        freeComplexMatrix(Q);
+        freeComplexMatrix(R);
+        freeComplexMatrix(QR);
+        freeComplexMatrix(MX);
+        freeComplexMatrix(normal);
+    }
+
+    /* ZF and MMSE filters */
+    {
+        complexMatrix W = allocateComplexMatrix(k, m);
+        complexMatrix WH = allocateComplexMatrix(k, k);
+        complexMatrix G = allocateComplexMatrix(k, k);
+        complexMatrix GW = allocateComplexMatrix(k, m);
+        complexMatrix Hh = allocateComplexMatrix(k, m);
+        const float sigma2 = 0.1f;
+
+        status = matrixZFEm(W, H);
+        matrixProdutoEm(WH, W, H);
+        residuo = testeFatoracaoResiduo(WH, Ik);
+        falhas += testeConfere("matrixZFEm  W H = I", status == 0 && residuo < tolerancia, "residuo %.2e", residuo);
+
+        //! (H^H H + sigma2 I) W = H^H
+        status = matrixMMSEEm(W, H, sigma2);
+        matrixGramEm(G, H);
+        for (int i = 0; i < k; i++)
+        {
+            MATRIX_ELEM(G, i, i).Re += sigma2;
+        }
+        matrixProdutoEm(GW, G, W);
+        matrixHermitianaEm(Hh, H);
+        residuo = testeFatoracaoResiduo(GW, Hh);
+        falhas += testeConfere("matrixMMSEEm  (H^H H + s I) W = H^H", status == 0 && residuo < tolerancia, "residuo %.2e", residuo);
+
+        //! Rank deficient H: the last column repeats the first one
+        complexMatrix deficiente = allocateComplexMatrix(m, k);
+        for (int i = 0; i < m; i++)
+        {
+            for (int j = 0; j < k; j++)
+            {
+                MATRIX_ELEM(deficiente, i, j) = MATRIX_ELEM(H, i, (j == k - 1) ? 0 : j);
+            }
+        }
+        falhas += testeConfere("matrixZFEm  posto incompleto devolve -1", matrixZFEm(W, deficiente) == -1, "residuo %.2e", 0.0f);
+
+        freeComplexMatrix(deficiente);
+        freeComplexMatrix(W);
+        freeComplexMatrix(WH);
+        freeComplexMatrix(G);
+        freeComplexMatrix(GW);
+        freeComplexMatrix(Hh);
+    }
+
+    /* Singular and not positive definite inputs */
+    {
+        complexMatrix singular = allocateComplexMatrix(n, n);
+
+        //! A with a zero column
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                MATRIX_ELEM(singular, i, j) = MATRIX_ELEM(A, i, j);
+            }
+            MATRIX_ELEM(singular, i, 2).Re = 0.0f;
+            MATRIX_ELEM(singular, i, 2).Im = 0.0f;
+        }
+        falhas += testeConfere("matrixLUEm  singular devolve -1", matrixLUEm(F, pivos, singular) == -1, NULL);
+        falhas += testeConfere("matrixSolveEm  singular devolve -1", matrixSolveEm(X, singular, B) == -1, NULL);
+        falhas += testeConfere("matrixInversaEm  singular devolve -1", matrixInversaEm(F, singular) == -1, NULL);
+
+        //! S - 100 I is Hermitian but not positive definite
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                MATRIX_ELEM(singular, i, j) = MATRIX_ELEM(S, i, j);
+            }
+            MATRIX_ELEM(singular, i, i).Re -= 100.0f;
+        }
+        falhas += testeConfere("matrixCholeskyEm  nao PD devolve -1", matrixCholeskyEm(F, singular) == -1, NULL);
+        falhas += testeConfere("matrixCholeskyEm  dimensoes devolve -1", matrixCholeskyEm(X, S) == -1, "residuo %.2e", 0.0f);
+
+        freeComplexMatrix(singular);
+    }
+
+    /* Batched versions: every lane against the serial result; one lane of the Cholesky batch is not positive definite */
+    {
+        const int lote = 19, ruim = 5;
+        complexMatrixLote LA = allocateComplexMatrixLote(lote, n, n);
+        complexMatrixLote LS = allocateComplexMatrixLote(lote, n, n);
+        complexMatrixLote LB = allocateComplexMatrixLote(lote, n, 3);
+        complexMatrixLote LH = allocateComplexMatrixLote(lote, m, k);
+        complexMatrixLote LF = allocateComplexMatrixLote(lote, n, n);
+        complexMatrixLote LX = allocateComplexMatrixLote(lote, n, 3);
+        complexMatrixLote LQ = allocateComplexMatrixLote(lote, m, k);
+        complexMatrixLote LR = allocateComplexMatrixLote(lote, k, k);
+        complexMatrixLote LW = allocateComplexMatrixLote(lote, k, m);
+        int *lpivos = (int *)malloc((size_t)n * LA.passo * sizeof(int));
+        complexMatrix a = allocateComplexMatrix(n, n);
+        complexMatrix s = allocateComplexMatrix(n, n);
+        complexMatrix h = allocateComplexMatrix(m, k);
+        complexMatrix q = allocateComplexMatrix(m, k);
+        complexMatrix r = allocateComplexMatrix(k, k);
+        complexMatrix w = allocateComplexMatrix(k, m);
+        float erro[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+        int finitos = 1, ruimNaoFinito = 0;
+
+        if (lpivos == NULL)
+        {
+            printf("Falha na alocacao de memoria\n");
+            exit(1);
+        }
+
+        for (int b = 0; b < lote; b++)
+        {
+            testePreenche(a, 100 + (unsigned)b);
+            testePreenche(M, 200 + (unsigned)b);
+            testePreenche(h, 300 + (unsigned)b);
+            testePreenche(B, 400 + (unsigned)b);
+            matrixGramEm(s, M);
+            for (int i = 0; i < n; i++)
+            {
+                MATRIX_ELEM(s, i, i).Re += (b == ruim) ? -100.0f : 1.0f;
+            }
+            loteCarregaMatrix(LA, b, a);
+            loteCarregaMatrix(LS, b, s);
+            loteCarregaMatrix(LH, b, h);
+            loteCarregaMatrix(LB, b, B);
+        }
+
+        int statusLote = loteLUEm(LF, lpivos, LA);
+        statusLote |= loteQREm(LQ, LR, LH);
+        int statusSolve = 0;
+
+        for (int b = 0; b < lote; b++)
+        {
+            loteExtraiMatrix(a, LA, b);
+            loteExtraiMatrix(s, LS, b);
+            loteExtraiMatrix(h, LH, b);
+            loteExtraiMatrix(B, LB, b);
+
+            matrixLUEm(F, pivos, a);
+            erro[1] = fmaxf(erro[1], testeFatoracaoDiferencaLane(LF, b, F));
+
+            matrixQREm(q, r, h);
+            erro[2] = fmaxf(erro[2], fmaxf(testeFatoracaoDiferencaLane(LQ, b, q), testeFatoracaoDiferencaLane(LR, b, r)));
+        }
+
+        statusSolve |= loteLUSolveEm(LX, LF, lpivos, LB);
+        for (int b = 0; b < lote; b++)
+        {
+            loteExtraiMatrix(a, LA, b);
+            loteExtraiMatrix(B, LB, b);
+            matrixSolveEm(X, a, B);
+            erro[3] = fmaxf(erro[3], testeFatoracaoDiferencaLane(LX, b, X));
+        }
+
+        statusSolve |= loteSolveEm(LX, LA, LB);
+        for (int b = 0; b < lote; b++)
+        {
+            loteExtraiMatrix(a, LA, b);
+            loteExtraiMatrix(B, LB, b);
+            matrixSolveEm(X, a, B);
+            erro[3] = fmaxf(erro[3], testeFatoracaoDiferencaLane(LX, b, X));
+        }
+
+        statusSolve |= loteMMSEEm(LW, LH, 0.1f);
+        for (int b = 0; b < lote; b++)
+        {
+            loteExtraiMatrix(h, LH, b);
+            matrixMMSEEm(w, h, 0.1f);
+            erro[4] = fmaxf(erro[4], testeFatoracaoDiferencaLane(LW, b, w));
+        }
+
+        //! Cholesky and its solver: the bad lane must be non-finite, every other lane must match the serial result
+        statusLote |= loteCholeskyEm(LF, LS);
+        statusSolve |= loteCholeskySolveEm(LX, LF, LB);
+        for (int b = 0; b < lote; b++)
+        {
+            int laneFinita = 1;
+
+            for (long e = 0; e < (long)n * n; e++)
+            {
+                laneFinita &= isfinite(LF.Re[e * LF.passo + b]) && isfinite(LF.Im[e * LF.passo + b]);
+            }
+
+            if (b == ruim)
+            {
+                ruimNaoFinito = !laneFinita;
+                continue;
+            }
+
+            finitos &= laneFinita;
+            loteExtraiMatrix(s, LS, b);
+            loteExtraiMatrix(B, LB, b);
+            matrixCholeskyEm(F, s);
+            erro[0] = fmaxf(erro[0], testeFatoracaoDiferencaLane(LF, b, F));
+            matrixCholeskySolveEm(X, F, B);
+            erro[5] = fmaxf(erro[5], testeFatoracaoDiferencaLane(LX, b, X));
+        }
+
+        falhas += testeConfere("loteCholeskyEm  = serial", statusLote == 0 && finitos && erro[0] < tolerancia, "residuo %.2e", erro[0]);
+        falhas += testeConfere("loteCholeskyEm  lane nao PD isolada", ruimNaoFinito, NULL);
+        falhas += testeConfere("loteCholeskySolveEm  = serial", statusSolve == 0 && erro[5] < tolerancia, "residuo %.2e", erro[5]);
+        falhas += testeConfere("loteLUEm  = serial", statusLote == 0 && erro[1] < tolerancia, "residuo %.2e", erro[1]);
+        falhas += testeConfere("loteQREm  = serial", statusLote == 0 && erro[2] < tolerancia, "residuo %.2e", erro[2]);
+        falhas += testeConfere("loteLUSolveEm / loteSolveEm  = serial", erro[3] < tolerancia, "residuo %.2e", erro[3]);
+        falhas += testeConfere("loteMMSEEm  = serial", erro[4] < tolerancia, "residuo %.2e", erro[4]);
+        falhas += testeConfere("loteCholeskyEm  dimensoes devolve -1", loteCholeskyEm(LX, LS) == -1, "residuo %.2e", 0.0f);
+
+        free(lpivos);
+        freeComplexMatrixLote(LA);
+        freeComplexMatrixLote(LS);
+        freeComplexMatrixLote(LB);
+        freeComplexMatrixLote(LH);
+        freeComplexMatrixLote(LF);
+        freeComplexMatrixLote(LX);
+        freeComplexMatrixLote(LQ);
+        freeComplexMatrixLote(LR);
+        freeComplexMatrixLote(LW);
+        freeComplexMatrix(a);
+        freeComplexMatrix(s);
+        freeComplexMatrix(h);
+        freeComplexMatrix(q);
+        freeComplexMatrix(r);
+        freeComplexMatrix(w);
+    }
+
+    freeComplexMatrix(A);
+    freeComplexMatrix(M);
+    freeComplexMatrix(H);
+    freeComplexMatrix(B);
+    freeComplexMatrix(Bm);
+    freeComplexMatrix(X);
+    freeComplexMatrix(AX);
+    freeComplexMatrix(F);
+    freeComplexMatrix(T);
+    freeComplexMatrix(I);
+    freeComplexMatrix(Ik);
+    freeComplexMatrix(S);
+
+    return falhas;
+}
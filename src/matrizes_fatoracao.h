@@ -0,0 +1,143 @@
+/**
+ * @file matrizes_fatoracao.h
+ * @brief Header file for the complex factorizations (Cholesky, LU, QR), linear solvers and ZF/MMSE filters.
+ */
+
+#ifndef MATRIZES_FATORACAO_H
+#define MATRIZES_FATORACAO_H
+#include "matrizes.h"
+
+///****************************************** FACTORIZATIONS ****************************************************/
+///
+///-----> Single precision throughout, on the complexMatrix storage (no GSL round trip).
+///-----> 0 is returned on success and -1 when the dimensions do not agree or the factorization breaks down.
+///
+
+/**
+ * @brief Cholesky factorization A = L L^H of a Hermitian positive definite matrix.
+ *
+ * Only the lower triangle of matrix is read. L gets a real positive diagonal and zeros above it.
+ *
+ * @param L The complexMatrix that receives the factor (n x n); may be matrix.
+ * @param matrix The Hermitian positive definite complexMatrix (n x n).
+ * @return 0 on success, -1 if the dimensions do not agree or the matrix is not positive definite.
+ */
+int matrixCholeskyEm(complexMatrix L, complexMatrix matrix);
+
+/**
+ * @brief LU factorization with partial pivoting, P A = L U.
+ *
+ * LU receives U on and above the diagonal and the multipliers of the unit lower triangular L below it.
+ * Row k was exchanged with row pivos[k] at step k (LAPACK convention).
+ *
+ * @param LU The complexMatrix that receives the factors (n x n); may be matrix.
+ * @param pivos Array of n ints that receives the pivot rows.
+ * @param matrix The square complexMatrix (n x n).
+ * @return 0 on success, -1 if the dimensions do not agree or the matrix is singular.
+ */
+int matrixLUEm(complexMatrix LU, int *pivos, complexMatrix matrix);
+
+/**
+ * @brief Thin QR factorization A = Q R by Householder reflections, for m >= n.
+ *
+ * Q has orthonormal columns; R is upper triangular. A rank deficient matrix gives zeros on the
+ * diagonal of R (it is not an error here).
+ *
+ * @param Q The complexMatrix that receives Q (m x n); must not overlap matrix.
+ * @param R The complexMatrix that receives R (n x n).
+ * @param matrix The complexMatrix A (m x n, m >= n), left untouched.
+ * @return 0 on success, -1 if the dimensions do not agree or m < n.
+ */
+int matrixQREm(complexMatrix Q, complexMatrix R, complexMatrix matrix);
+
+///****************************************** SOLVERS ****************************************************/
+///
+///-----> X may be B in every solver: the right-hand sides are copied to X and solved in place.
+///
+
+/**
+ * @brief Solves A X = B from the factors of matrixLUEm.
+ *
+ * @param X The complexMatrix that receives the solution (n x k).
+ * @param LU The factors returned by matrixLUEm (n x n).
+ * @param pivos The pivot rows returned by matrixLUEm.
+ * @param B The right-hand sides (n x k).
+ * @return 0 on success, -1 if the dimensions do not agree or U has a zero on the diagonal.
+ */
+int matrixLUSolveEm(complexMatrix X, complexMatrix LU, const int *pivos, complexMatrix B);
+
+/**
+ * @brief Solves L L^H X = B from the factor of matrixCholeskyEm.
+ *
+ * @param X The complexMatrix that receives the solution (n x k).
+ * @param L The factor returned by matrixCholeskyEm (n x n).
+ * @param B The right-hand sides (n x k).
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixCholeskySolveEm(complexMatrix X, complexMatrix L, complexMatrix B);
+
+/**
+ * @brief Least-squares solution of A X = B from the factors of matrixQREm: X = R^-1 Q^H B.
+ *
+ * @param X The complexMatrix that receives the solution (n x k); must not overlap B or Q.
+ * @param Q The factor Q (m x n).
+ * @param R The factor R (n x n).
+ * @param B The right-hand sides (m x k).
+ * @return 0 on success, -1 if the dimensions do not agree or R is singular.
+ */
+int matrixQRSolveEm(complexMatrix X, complexMatrix Q, complexMatrix R, complexMatrix B);
+
+/**
+ * @brief Solves the square system A X = B (LU with partial pivoting).
+ *
+ * @param X The complexMatrix that receives the solution (n x k); may be B.
+ * @param A The square complexMatrix (n x n), left untouched.
+ * @param B The right-hand sides (n x k).
+ * @return 0 on success, -1 if the dimensions do not agree or A is singular.
+ */
+int matrixSolveEm(complexMatrix X, complexMatrix A, complexMatrix B);
+
+/**
+ * @brief Writes the inverse of a square matrix into destino (LU with partial pivoting).
+ *
+ * @param destino The complexMatrix that receives the inverse (n x n); may be matrix.
+ * @param matrix The square complexMatrix (n x n).
+ * @return 0 on success, -1 if the dimensions do not agree or the matrix is singular.
+ */
+int matrixInversaEm(complexMatrix destino, complexMatrix matrix);
+
+///****************************************** EQUALIZATION FILTERS ****************************************************/
+
+/**
+ * @brief Zero-forcing filter W = (H^H H)^-1 H^H = R^-1 Q^H, through the QR factorization of H.
+ *
+ * @param W The complexMatrix that receives the filter (n x m).
+ * @param H The channel complexMatrix (m x n, m >= n).
+ * @return 0 on success, -1 if the dimensions do not agree or H does not have full column rank.
+ */
+int matrixZFEm(complexMatrix W, complexMatrix H);
+
+/**
+ * @brief MMSE filter W = (H^H H + sigma2 I)^-1 H^H, through the Cholesky factorization of the regularized Gram matrix.
+ *
+ * @param W The complexMatrix that receives the filter (n x m).
+ * @param H The channel complexMatrix (m x n).
+ * @param sigma2 Noise variance (with sigma2 = 0 this is the zero-forcing filter).
+ * @return 0 on success, -1 if the dimensions do not agree or H^H H + sigma2 I is not positive definite.
+ */
+int matrixMMSEEm(complexMatrix W, complexMatrix H, float sigma2);
+
+///****************************************** TESTS ****************************************************/
+
+/**
+ * @brief Checks the factorizations, solvers and filters (and their batched versions) through their residuals.
+ *
+ * Prints one OK/FALHOU line per check: ||L L^H - A||, ||Q R - A||, ||W H - I|| and the like, the -1
+ * returns of singular, not positive definite and rank deficient inputs, and every lane of the batched
+ * versions against the serial result.
+ *
+ * @return The number of failed checks.
+ */
+int teste_fatoracao(void);
+
+#endif
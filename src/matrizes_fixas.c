@@ -0,0 +1,889 @@
+/**
+ * @file matrizes_fixas.c
+ * @brief Implementation file for the fixed-size kernels of the usual MIMO shapes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+
+/// including the files where the structures are contained
+#include "matrizes_fixas.h"
+#include "matrizes.h"
+#include "matrizes_fatoracao.h"
+#include "teste.h"
+
+/*
+ * The kernels are written once, as cores that take their dimensions as arguments, and are forced
+ * inline into one wrapper per shape generated by the X-macros of matrizes_fixas.h. Inside each
+ * wrapper the dimensions are constants, so the loops are unrolled completely and the operands,
+ * copied to local arrays, can live in registers. The generic fallbacks inline the same cores
+ * with run-time dimensions.
+ */
+#if defined(__GNUC__)
+#define FIXA_INLINE static inline __attribute__((always_inline))
+#define FIXA_DESENROLA _Pragma("GCC unroll 8")
+#else
+#define FIXA_INLINE static inline
+#define FIXA_DESENROLA
+#endif
+
+/*
+ * Maximum number of Jacobi sweeps of the fixed-size SVD (the same bound as calc_svd).
+ */
+#define FIXA_SVD_MAX_VARREDURAS 60
+
+/************************************* COMPLEX ARITHMETIC ***************************************/
+
+FIXA_INLINE complex cMul(complex a, complex b)
+{
+    complex r = {a.Re * b.Re - a.Im * b.Im, a.Re * b.Im + a.Im * b.Re};
+    return r;
+}
+
+FIXA_INLINE complex cMulSub(complex c, complex a, complex b) //!< c - a*b
+{
+    complex r = {c.Re - (a.Re * b.Re - a.Im * b.Im), c.Im - (a.Re * b.Im + a.Im * b.Re)};
+    return r;
+}
+
+FIXA_INLINE complex cInverso(complex a) //!< 1 / a = conj(a) / |a|^2
+{
+    const float modulo2 = a.Re * a.Re + a.Im * a.Im;
+    complex r = {a.Re / modulo2, -a.Im / modulo2};
+    return r;
+}
+
+FIXA_INLINE float cModulo2(complex a)
+{
+    return a.Re * a.Re + a.Im * a.Im;
+}
+
+/**
+ * @brief Copies a linhas x colunas matrix to a dense local array (leading dimension = colunas).
+ */
+FIXA_INLINE void fixaCarrega(complex *local, complexMatrix matrix, int linhas, int colunas)
+{
+    FIXA_DESENROLA
+    for (int i = 0; i < linhas; i++)
+    {
+        const complex *linha = matrixLinha(matrix, i);
+
+        FIXA_DESENROLA
+        for (int j = 0; j < colunas; j++)
+        {
+            local[i * colunas + j] = linha[j];
+        }
+    }
+}
+
+/**
+ * @brief Copies a dense local array back to a linhas x colunas matrix.
+ */
+FIXA_INLINE void fixaGuarda(complexMatrix matrix, const complex *local, int linhas, int colunas)
+{
+    FIXA_DESENROLA
+    for (int i = 0; i < linhas; i++)
+    {
+        complex *linha = matrixLinha(matrix, i);
+
+        FIXA_DESENROLA
+        for (int j = 0; j < colunas; j++)
+        {
+            linha[j] = local[i * colunas + j];
+        }
+    }
+}
+
+/************************************* CORES ***************************************/
+
+/**
+ * @brief C = A * B on dense local arrays (A is m x k, B is k x n).
+ */
+FIXA_INLINE void fixaProdutoNucleo(complex *C, const complex *A, const complex *B, int m, int k, int n)
+{
+    FIXA_DESENROLA
+    for (int i = 0; i < m; i++)
+    {
+        FIXA_DESENROLA
+        for (int j = 0; j < n; j++)
+        {
+            complex acc = {0.0f, 0.0f};
+
+            FIXA_DESENROLA
+            for (int l = 0; l < k; l++)
+            {
+                acc.Re += A[i * k + l].Re * B[l * n + j].Re - A[i * k + l].Im * B[l * n + j].Im;
+                acc.Im += A[i * k + l].Re * B[l * n + j].Im + A[i * k + l].Im * B[l * n + j].Re;
+            }
+
+            C[i * n + j] = acc;
+        }
+    }
+}
+
+/**
+ * @brief Determinant of the n x n dense array W, which is overwritten by its elimination.
+ */
+FIXA_INLINE complex fixaDeterminanteNucleo(complex *W, int n)
+{
+    if (n == 2)
+    {
+        //! Closed form: ad - bc
+        return cMulSub(cMul(W[0], W[3]), W[1], W[2]);
+    }
+
+    complex det = {1.0f, 0.0f};
+
+    FIXA_DESENROLA
+    for (int k = 0; k < n; k++)
+    {
+        int pivo = k;
+
+        for (int r = k + 1; r < n; r++)
+        {
+            if (cModulo2(W[r * n + k]) > cModulo2(W[pivo * n + k]))
+            {
+                pivo = r;
+            }
+        }
+
+        if (cModulo2(W[pivo * n + k]) == 0.0f)
+        {
+            complex zero = {0.0f, 0.0f};
+            return zero;
+        }
+
+        //! Each row exchange flips the sign of the determinant
+        if (pivo != k)
+        {
+            for (int c = k; c < n; c++)
+            {
+                const complex t = W[k * n + c];
+                W[k * n + c] = W[pivo * n + c];
+                W[pivo * n + c] = t;
+            }
+            det.Re = -det.Re;
+            det.Im = -det.Im;
+        }
+
+        det = cMul(det, W[k * n + k]);
+
+        const complex inverso = cInverso(W[k * n + k]);
+
+        FIXA_DESENROLA
+        for (int r = k + 1; r < n; r++)
+        {
+            const complex f = cMul(W[r * n + k], inverso);
+
+            FIXA_DESENROLA
+            for (int c = k + 1; c < n; c++)
+            {
+                W[r * n + c] = cMulSub(W[r * n + c], f, W[k * n + c]);
+            }
+        }
+    }
+
+    return det;
+}
+
+/**
+ * @brief Inverse of the n x n matrix held in the left half of the n x 2n dense array W.
+ *
+ * On return the right half of W holds the inverse.
+ *
+ * @return 0 on success, -1 if the matrix is singular.
+ */
+FIXA_INLINE int fixaInversaNucleo(complex *W, int n)
+{
+    const int largura = 2 * n;
+
+    if (n == 2)
+    {
+        //! Closed form: [d -b; -c a] / (ad - bc)
+        const complex a = W[0], b = W[1], c = W[4], d = W[5];
+        const complex det = cMulSub(cMul(a, d), b, c);
+
+        if (cModulo2(det) == 0.0f)
+        {
+            return -1;
+        }
+
+        const complex inv = cInverso(det);
+        const complex menosInv = {-inv.Re, -inv.Im};
+
+        W[2] = cMul(d, inv);
+        W[3] = cMul(b, menosInv);
+        W[6] = cMul(c, menosInv);
+        W[7] = cMul(a, inv);
+        return 0;
+    }
+
+    FIXA_DESENROLA
+    for (int i = 0; i < n; i++)
+    {
+        FIXA_DESENROLA
+        for (int j = 0; j < n; j++)
+        {
+            W[i * largura + n + j].Re = (i == j) ? 1.0f : 0.0f;
+            W[i * largura + n + j].Im = 0.0f;
+        }
+    }
+
+    FIXA_DESENROLA
+    for (int k = 0; k < n; k++)
+    {
+        int pivo = k;
+
+        for (int r = k + 1; r < n; r++)
+        {
+            if (cModulo2(W[r * largura + k]) > cModulo2(W[pivo * largura + k]))
+            {
+                pivo = r;
+            }
+        }
+
+        if (cModulo2(W[pivo * largura + k]) == 0.0f)
+        {
+            return -1;
+        }
+
+        if (pivo != k)
+        {
+            for (int c = k; c < largura; c++)
+            {
+                const complex t = W[k * largura + c];
+                W[k * largura + c] = W[pivo * largura + c];
+                W[pivo * largura + c] = t;
+            }
+        }
+
+        const complex inverso = cInverso(W[k * largura + k]);
+
+        FIXA_DESENROLA
+        for (int c = k; c < largura; c++)
+        {
+            W[k * largura + c] = cMul(W[k * largura + c], inverso);
+        }
+
+        FIXA_DESENROLA
+        for (int r = 0; r < n; r++)
+        {
+            if (r == k)
+            {
+                continue;
+            }
+
+            const complex f = W[r * largura + k];
+
+            FIXA_DESENROLA
+            for (int c = k; c < largura; c++)
+            {
+                W[r * largura + c] = cMulSub(W[r * largura + c], f, W[k * largura + c]);
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief One-sided Jacobi on the rows of the k x L dense array X, accumulating the rotations in Q (k x k).
+ *
+ * Same formulation as calc_svd: on return the rows of X are orthonormal (or zero), S holds their
+ * original norms in decreasing order and Q the accumulated rotations.
+ */
+FIXA_INLINE void fixaSvdNucleo(complex *X, complex *Q, float *S, int k, int L)
+{
+    const float tolerancia = FLT_EPSILON * (L > 16 ? (float)L : 16.0f);
+
+    FIXA_DESENROLA
+    for (int i = 0; i < k; i++)
+    {
+        FIXA_DESENROLA
+        for (int j = 0; j < k; j++)
+        {
+            Q[i * k + j].Re = (i == j) ? 1.0f : 0.0f;
+            Q[i * k + j].Im = 0.0f;
+        }
+    }
+
+    for (int varredura = 0; varredura < FIXA_SVD_MAX_VARREDURAS; varredura++)
+    {
+        int rotacoes = 0;
+
+        for (int p = 0; p < k - 1; p++)
+        {
+            for (int q = p + 1; q < k; q++)
+            {
+                float alpha = 0.0f, beta = 0.0f;
+                complex gama = {0.0f, 0.0f};
+
+                FIXA_DESENROLA
+                for (int c = 0; c < L; c++)
+                {
+                    const complex x = X[p * L + c], y = X[q * L + c];
+
+                    alpha += x.Re * x.Re + x.Im * x.Im;
+                    beta += y.Re * y.Re + y.Im * y.Im;
+                    gama.Re += x.Re * y.Re + x.Im * y.Im;
+                    gama.Im += x.Im * y.Re - x.Re * y.Im;
+                }
+
+                const float modulo = sqrtf(cModulo2(gama));
+
+                if (modulo <= tolerancia * sqrtf(alpha * beta) || modulo < FLT_MIN)
+                {
+                    continue;
+                }
+
+                const float zeta = (beta - alpha) / (2.0f * modulo);
+                const float t = (zeta >= 0.0f ? 1.0f : -1.0f) / (fabsf(zeta) + sqrtf(1.0f + zeta * zeta));
+                const float cs = 1.0f / sqrtf(1.0f + t * t);
+                const float s = cs * t / modulo;
+                const complex w = {s * gama.Re, s * gama.Im};
+                const complex menosWConj = {-w.Re, w.Im}; //!< -conj(w)
+
+                //! p <- c p - w q, q <- conj(w) p + c q, on X and on Q
+                FIXA_DESENROLA
+                for (int c = 0; c < L; c++)
+                {
+                    const complex x = X[p * L + c], y = X[q * L + c];
+                    const complex cx = {cs * x.Re, cs * x.Im}, cy = {cs * y.Re, cs * y.Im};
+
+                    X[p * L + c] = cMulSub(cx, w, y);
+                    X[q * L + c] = cMulSub(cy, menosWConj, x);
+                }
+
+                FIXA_DESENROLA
+                for (int c = 0; c < k; c++)
+                {
+                    const complex x = Q[p * k + c], y = Q[q * k + c];
+                    const complex cx = {cs * x.Re, cs * x.Im}, cy = {cs * y.Re, cs * y.Im};
+
+                    Q[p * k + c] = cMulSub(cx, w, y);
+                    Q[q * k + c] = cMulSub(cy, menosWConj, x);
+                }
+                rotacoes++;
+            }
+        }
+
+        if (rotacoes == 0)
+        {
+            break;
+        }
+    }
+
+    FIXA_DESENROLA
+    for (int i = 0; i < k; i++)
+    {
+        float norma2 = 0.0f;
+
+        FIXA_DESENROLA
+        for (int c = 0; c < L; c++)
+        {
+            norma2 += cModulo2(X[i * L + c]);
+        }
+        S[i] = sqrtf(norma2);
+    }
+
+    //! Selection sort by decreasing singular value, moving the rows of X and Q together
+    for (int i = 0; i < k - 1; i++)
+    {
+        int maior = i;
+
+        for (int j = i + 1; j < k; j++)
+        {
+            if (S[j] > S[maior])
+            {
+                maior = j;
+            }
+        }
+
+        if (maior != i)
+        {
+            const float ts = S[i];
+            S[i] = S[maior];
+            S[maior] = ts;
+
+            for (int c = 0; c < L; c++)
+            {
+                const complex t = X[i * L + c];
+                X[i * L + c] = X[maior * L + c];
+                X[maior * L + c] = t;
+            }
+            for (int c = 0; c < k; c++)
+            {
+                const complex t = Q[i * k + c];
+                Q[i * k + c] = Q[maior * k + c];
+                Q[maior * k + c] = t;
+            }
+        }
+    }
+
+    FIXA_DESENROLA
+    for (int i = 0; i < k; i++)
+    {
+        const float inv = (S[i] > FLT_MIN) ? 1.0f / S[i] : 0.0f;
+
+        if (S[i] <= FLT_MIN)
+        {
+            S[i] = 0.0f;
+        }
+
+        FIXA_DESENROLA
+        for (int c = 0; c < L; c++)
+        {
+            X[i * L + c].Re *= inv;
+            X[i * L + c].Im *= inv;
+        }
+    }
+}
+
+/************************************* FIXED-SIZE KERNELS ***************************************/
+
+/*
+ * For every shape M x N: the product by an N x N matrix.
+ */
+#define FIXA_DEFINE_PRODUTO(M, N)                                                               \
+    static void fixaProduto##M##x##N(complexMatrix destino, complexMatrix a, complexMatrix b)  \
+    {                                                                                           \
+        complex A[M * N], B[N * N], C[M * N];                                                   \
+                                                                                                \
+        fixaCarrega(A, a, M, N);                                                                \
+        fixaCarrega(B, b, N, N);                                                                \
+        fixaProdutoNucleo(C, A, B, M, N, N);                                                    \
+        fixaGuarda(destino, C, M, N);                                                           \
+    }
+
+MATRIX_FORMAS_FIXAS(FIXA_DEFINE_PRODUTO)
+
+/*
+ * For every shape M x N of the SVD list: the SVD (all the shapes are tall or square, so the rows of
+ * A^H are orthogonalized: U = X^H and Vh = Q, as in calc_svd).
+ */
+#define FIXA_DEFINE_SVD(M, N)                                                                   \
+    static void fixaSvd##M##x##N(complexMatrix matrix, complexMatrix U, float *S, complexMatrix Vh) \
+    {                                                                                           \
+        complex X[N * M], Q[N * N];                                                             \
+                                                                                                \
+        FIXA_DESENROLA                                                                          \
+        for (int i = 0; i < M; i++)                                                             \
+        {                                                                                       \
+            FIXA_DESENROLA                                                                      \
+            for (int j = 0; j < N; j++)                                                         \
+            {                                                                                   \
+                X[j * M + i].Re = MATRIX_ELEM(matrix, i, j).Re;                                 \
+                X[j * M + i].Im = -MATRIX_ELEM(matrix, i, j).Im;                                \
+            }                                                                                   \
+        }                                                                                       \
+                                                                                                \
+        fixaSvdNucleo(X, Q, S, N, M);                                                           \
+                                                                                                \
+        FIXA_DESENROLA                                                                          \
+        for (int i = 0; i < M; i++)                                                             \
+        {                                                                                       \
+            FIXA_DESENROLA                                                                      \
+            for (int j = 0; j < N; j++)                                                         \
+            {                                                                                   \
+                MATRIX_ELEM(U, i, j).Re = X[j * M + i].Re;                                      \
+                MATRIX_ELEM(U, i, j).Im = -X[j * M + i].Im;                                     \
+            }                                                                                   \
+        }                                                                                       \
+        fixaGuarda(Vh, Q, N, N);                                                                \
+    }
+
+MATRIX_FORMAS_SVD_FIXAS(FIXA_DEFINE_SVD)
+
+/*
+ * For every square order N: the determinant and the inverse.
+ */
+#define FIXA_DEFINE_ORDEM(N)                                                                    \
+    static complex fixaDeterminante##N(complexMatrix matrix)                                   \
+    {                                                                                           \
+        complex W[N * N];                                                                       \
+                                                                                                \
+        fixaCarrega(W, matrix, N, N);                                                           \
+        return fixaDeterminanteNucleo(W, N);                                                    \
+    }                                                                                           \
+                                                                                                \
+    static int fixaInversa##N(complexMatrix destino, complexMatrix matrix)                     \
+    {                                                                                           \
+        complex W[N * 2 * N];                                                                   \
+                                                                                                \
+        FIXA_DESENROLA                                                                          \
+        for (int i = 0; i < N; i++)                                                             \
+        {                                                                                       \
+            FIXA_DESENROLA                                                                      \
+            for (int j = 0; j < N; j++)                                                         \
+            {                                                                                   \
+                W[i * 2 * N + j] = MATRIX_ELEM(matrix, i, j);                                   \
+            }                                                                                   \
+        }                                                                                       \
+                                                                                                \
+        if (fixaInversaNucleo(W, N) != 0)                                                       \
+        {                                                                                       \
+            return -1;                                                                          \
+        }                                                                                       \
+                                                                                                \
+        FIXA_DESENROLA                                                                          \
+        for (int i = 0; i < N; i++)                                                             \
+        {                                                                                       \
+            FIXA_DESENROLA                                                                      \
+            for (int j = 0; j < N; j++)                                                         \
+            {                                                                                   \
+                MATRIX_ELEM(destino, i, j) = W[i * 2 * N + N + j];                              \
+            }                                                                                   \
+        }                                                                                       \
+        return 0;                                                                               \
+    }
+
+MATRIX_ORDENS_FIXAS(FIXA_DEFINE_ORDEM)
+
+/************************************* DISPATCHERS ***************************************/
+
+/**
+ * @param[out] destino The product (m x n)
+ * @param[in] matrix1 The first matrix (m x k)
+ * @param[in] matrix2 The second matrix (k x n)
+ *
+ * @brief Uses the unrolled kernel when matrix1 has one of the fixed shapes and matrix2 is square; matrixProdutoEm otherwise.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixProdutoFixoEm(complexMatrix destino, complexMatrix matrix1, complexMatrix matrix2)
+{
+    if (matrix1.colunas != matrix2.linhas || destino.linhas != matrix1.linhas || destino.colunas != matrix2.colunas)
+    {
+        return -1;
+    }
+
+#define FIXA_DESPACHA_PRODUTO(M, N)                                                   \
+    if (matrix1.linhas == M && matrix1.colunas == N && matrix2.colunas == N)           \
+    {                                                                                 \
+        fixaProduto##M##x##N(destino, matrix1, matrix2);                             \
+        return 0;                                                                     \
+    }
+
+    MATRIX_FORMAS_FIXAS(FIXA_DESPACHA_PRODUTO)
+#undef FIXA_DESPACHA_PRODUTO
+
+    return matrixProdutoEm(destino, matrix1, matrix2);
+}
+
+/**
+ * @param[in] matrix The square matrix
+ *
+ * @brief Uses the unrolled kernel for the fixed orders; the same elimination on a heap copy otherwise.
+ *
+ * @return The determinant.
+ */
+complex matrixDeterminanteFixo(complexMatrix matrix)
+{
+    if (matrix.linhas != matrix.colunas)
+    {
+        printf("Dimensoes incompativeis para a operacao determinante\n");
+        exit(1);
+    }
+
+#define FIXA_DESPACHA_DETERMINANTE(N) \
+    if (matrix.linhas == N)           \
+    {                                 \
+        return fixaDeterminante##N(matrix); \
+    }
+
+    MATRIX_ORDENS_FIXAS(FIXA_DESPACHA_DETERMINANTE)
+#undef FIXA_DESPACHA_DETERMINANTE
+
+    const int n = matrix.linhas;
+    complex *W = (complex *)malloc((size_t)n * n * sizeof(complex));
+
+    if (W == NULL)
+    {
+        printf("Falha na alocacao de memoria\n");
+        exit(1);
+    }
+
+    fixaCarrega(W, matrix, n, n);
+    const complex det = fixaDeterminanteNucleo(W, n);
+
+    free(W);
+    return det;
+}
+
+/**
+ * @param[out] destino The inverse (may be matrix)
+ * @param[in] matrix The square matrix
+ *
+ * @brief Uses the unrolled kernel for the fixed orders; the same Gauss-Jordan on a heap buffer otherwise.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree or the matrix is singular.
+ */
+int matrixInversaFixaEm(complexMatrix destino, complexMatrix matrix)
+{
+    if (matrix.linhas != matrix.colunas || destino.linhas != matrix.linhas || destino.colunas != matrix.colunas)
+    {
+        return -1;
+    }
+
+#define FIXA_DESPACHA_INVERSA(N)                  \
+    if (matrix.linhas == N)                       \
+    {                                             \
+        return fixaInversa##N(destino, matrix);   \
+    }
+
+    MATRIX_ORDENS_FIXAS(FIXA_DESPACHA_INVERSA)
+#undef FIXA_DESPACHA_INVERSA
+
+    const int n = matrix.linhas;
+    complex *W = (complex *)malloc((size_t)n * 2 * n * sizeof(complex));
+
+    if (W == NULL)
+    {
+        printf("Falha na alocacao de memoria\n");
+        exit(1);
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            W[i * 2 * n + j] = MATRIX_ELEM(matrix, i, j);
+        }
+    }
+
+    const int resultado = fixaInversaNucleo(W, n);
+
+    if (resultado == 0)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                MATRIX_ELEM(destino, i, j) = W[i * 2 * n + n + j];
+            }
+        }
+    }
+
+    free(W);
+    return resultado;
+}
+
+/**
+ * @param[in] matrix The matrix to be decomposed (m x n)
+ * @param[out] U The left singular vectors (m x k)
+ * @param[out] S The k singular values, in decreasing order
+ * @param[out] Vh V^H (k x n)
+ *
+ * @brief Uses the unrolled kernel for the shapes of MATRIX_FORMAS_SVD_FIXAS, calc_svd otherwise.
+ *
+ * @return 0 on success, -1 if the dimensions of the outputs do not agree.
+ */
+int calc_svd_fixo(complexMatrix matrix, complexMatrix U, float *S, complexMatrix Vh)
+{
+    const int k = (matrix.linhas < matrix.colunas) ? matrix.linhas : matrix.colunas;
+
+    if (U.linhas != matrix.linhas || U.colunas != k || Vh.linhas != k || Vh.colunas != matrix.colunas)
+    {
+        return -1;
+    }
+
+#define FIXA_DESPACHA_SVD(M, N)                   \
+    if (matrix.linhas == M && matrix.colunas == N) \
+    {                                             \
+        fixaSvd##M##x##N(matrix, U, S, Vh);       \
+        return 0;                                 \
+    }
+
+    MATRIX_FORMAS_SVD_FIXAS(FIXA_DESPACHA_SVD)
+#undef FIXA_DESPACHA_SVD
+
+    return calc_svd(matrix, U, S, Vh);
+}
+
+/************************************* TESTS ***************************************/
+
+/**
+ * @brief Adds 'valor' to the diagonal of a square matrix, so the random test matrices are well conditioned.
+ */
+static void testeFixasReforcaDiagonal(complexMatrix matrix, float valor)
+{
+    for (int i = 0; i < matrix.linhas; i++)
+    {
+        MATRIX_ELEM(matrix, i, i).Re += valor;
+    }
+}
+
+/**
+ * @brief Determinant from the LU factorization of fatoracao: product of the diagonal of U, negated once per row exchange.
+ */
+static complex testeFixasDeterminanteLU(complexMatrix matrix)
+{
+    const int n = matrix.linhas;
+    complexMatrix LU = allocateComplexMatrix(n, n);
+    int *pivos = (int *)malloc((size_t)n * sizeof(int));
+    complex det = {1.0f, 0.0f};
+
+    if (pivos == NULL)
+    {
+        printf("Falha na alocacao de memoria\n");
+        exit(1);
+    }
+
+    if (matrixLUEm(LU, pivos, matrix) != 0)
+    {
+        det.Re = 0.0f;
+    }
+    else
+    {
+        for (int k = 0; k < n; k++)
+        {
+            const complex u = MATRIX_ELEM(LU, k, k);
+            const complex produto = {det.Re * u.Re - det.Im * u.Im, det.Re * u.Im + det.Im * u.Re};
+
+            det = produto;
+            if (pivos[k] != k)
+            {
+                det.Re = -det.Re;
+                det.Im = -det.Im;
+            }
+        }
+    }
+
+    free(pivos);
+    freeComplexMatrix(LU);
+    return det;
+}
+
+/**
+ * @brief Largest difference between U diag(S) Vh and the decomposed matrix.
+ */
+static float testeFixasReconstrucao(complexMatrix matrix, complexMatrix U, const float *S, complexMatrix Vh)
+{
+    float maxima = 0.0f;
+
+    for (int i = 0; i < matrix.linhas; i++)
+    {
+        for (int j = 0; j < matrix.colunas; j++)
+        {
+            float re = 0.0f, im = 0.0f;
+
+            for (int p = 0; p < U.colunas; p++)
+            {
+                const complex u = MATRIX_ELEM(U, i, p), v = MATRIX_ELEM(Vh, p, j);
+                re += S[p] * (u.Re * v.Re - u.Im * v.Im);
+                im += S[p] * (u.Re * v.Im + u.Im * v.Re);
+            }
+
+            maxima = fmaxf(maxima, fmaxf(fabsf(re - MATRIX_ELEM(matrix, i, j).Re), fabsf(im - MATRIX_ELEM(matrix, i, j).Im)));
+        }
+    }
+
+    return maxima;
+}
+
+/**
+ * @brief Checks every unrolled kernel against the generic path of the same operation.
+ *
+ * For each fixed shape: the product against matrixProdutoEm, the inverse against matrixInversaEm, the
+ * determinant against the one read from matrixLUEm, and the SVD against calc_svd (singular values, and
+ * U diag(S) Vh against the matrix, since the singular vectors are only defined up to a phase). Order 3,
+ * which has no unrolled kernel, checks the run-time fallback, and matrices with a zero column check
+ * that the inverse reports a singular matrix with -1.
+ *
+ * @return The number of failed checks.
+ */
+int teste_fixas(void)
+{
+    const float tolerancia = 1e-4f;
+    int falhas = 0;
+    char nome[64];
+
+    printf("\n  ============ Teste dos kernels de tamanho fixo ============ \n\n");
+
+#define TESTE_FIXAS_PRODUTO(M, N)                                                                                         \
+    {                                                                                                                     \
+        complexMatrix a = allocateComplexMatrix(M, N), b = allocateComplexMatrix(N, N);                                   \
+        complexMatrix fixo = allocateComplexMatrix(M, N), generico = allocateComplexMatrix(M, N);                         \
+        testePreenche(a, 10 * M + N);                                                                                     \
+        testePreenche(b, 10 * M + N + 1);                                                                                 \
+        const int status = matrixProdutoFixoEm(fixo, a, b);                                                               \
+        matrixProdutoEm(generico, a, b);                                                                                  \
+        const float diferenca = testeDiferenca(fixo, generico);                                                           \
+        snprintf(nome, sizeof(nome), "matrixProdutoFixoEm  %dx%d * %dx%d", M, N, N, N);                                   \
+        falhas += testeConfere(nome, status == 0 && diferenca < tolerancia, "diferenca %.2e", diferenca);                 \
+        freeComplexMatrix(a);                                                                                             \
+        freeComplexMatrix(b);                                                                                             \
+        freeComplexMatrix(fixo);                                                                                          \
+        freeComplexMatrix(generico);                                                                                      \
+    }
+
+    MATRIX_FORMAS_FIXAS(TESTE_FIXAS_PRODUTO)
+#undef TESTE_FIXAS_PRODUTO
+
+#define TESTE_FIXAS_QUADRADA(N)                                                                                           \
+    {                                                                                                                     \
+        complexMatrix a = allocateComplexMatrix(N, N);                                                                    \
+        complexMatrix fixo = allocateComplexMatrix(N, N), generico = allocateComplexMatrix(N, N);                         \
+        testePreenche(a, 100 + N);                                                                                        \
+        testeFixasReforcaDiagonal(a, (float)N);                                                                           \
+        int status = matrixInversaFixaEm(fixo, a);                                                                        \
+        status |= matrixInversaEm(generico, a);                                                                           \
+        float diferenca = testeDiferenca(fixo, generico);                                                                 \
+        snprintf(nome, sizeof(nome), "matrixInversaFixaEm  %dx%d", N, N);                                                 \
+        falhas += testeConfere(nome, status == 0 && diferenca < tolerancia, "diferenca %.2e", diferenca);                 \
+        const complex det = matrixDeterminanteFixo(a), detLU = testeFixasDeterminanteLU(a);                               \
+        diferenca = sqrtf(((det.Re - detLU.Re) * (det.Re - detLU.Re) + (det.Im - detLU.Im) * (det.Im - detLU.Im)) /      \
+                          (detLU.Re * detLU.Re + detLU.Im * detLU.Im));                                                   \
+        snprintf(nome, sizeof(nome), "matrixDeterminanteFixo  %dx%d", N, N);                                              \
+        falhas += testeConfere(nome, diferenca < tolerancia, "diferenca relativa %.2e", diferenca);                       \
+        for (int i = 0; i < N; i++)                                                                                       \
+        {                                                                                                                 \
+            MATRIX_ELEM(a, i, N / 2).Re = 0.0f;                                                                           \
+            MATRIX_ELEM(a, i, N / 2).Im = 0.0f;                                                                           \
+        }                                                                                                                 \
+        snprintf(nome, sizeof(nome), "matrixInversaFixaEm  %dx%d singular devolve -1", N, N);                             \
+        falhas += testeConfere(nome, matrixInversaFixaEm(fixo, a) == -1, NULL);                                           \
+        const complex detSingular = matrixDeterminanteFixo(a);                                                            \
+        snprintf(nome, sizeof(nome), "matrixDeterminanteFixo  %dx%d singular = 0", N, N);                                 \
+        falhas += testeConfere(nome, detSingular.Re == 0.0f && detSingular.Im == 0.0f, NULL);                             \
+        freeComplexMatrix(a);                                                                                             \
+        freeComplexMatrix(fixo);                                                                                          \
+        freeComplexMatrix(generico);                                                                                      \
+    }
+
+    MATRIX_ORDENS_FIXAS(TESTE_FIXAS_QUADRADA)
+    TESTE_FIXAS_QUADRADA(3)
+#undef TESTE_FIXAS_QUADRADA
+
+#define TESTE_FIXAS_SVD(M, N)                                                                                             \
+    {                                                                                                                     \
+        const int k = (M < N) ? M : N;                                                                                    \
+        complexMatrix a = allocateComplexMatrix(M, N);                                                                    \
+        complexMatrix U = allocateComplexMatrix(M, k), Vh = allocateComplexMatrix(k, N);                                  \
+        complexMatrix Ug = allocateComplexMatrix(M, k), Vhg = allocateComplexMatrix(k, N);                                \
+        float S[8], Sg[8];                                                                                                \
+        testePreenche(a, 1000 + 10 * M + N);                                                                              \
+        const int status = calc_svd_fixo(a, U, S, Vh);                                                                    \
+        calc_svd(a, Ug, Sg, Vhg);                                                                                         \
+        float diferenca = 0.0f;                                                                                           \
+        for (int i = 0; i < k; i++)                                                                                       \
+        {                                                                                                                 \
+            diferenca = fmaxf(diferenca, fabsf(S[i] - Sg[i]));                                                            \
+        }                                                                                                                 \
+        diferenca = fmaxf(diferenca, testeFixasReconstrucao(a, U, S, Vh));                                                \
+        snprintf(nome, sizeof(nome), "calc_svd_fixo  %dx%d", M, N);                                                       \
+        falhas += testeConfere(nome, status == 0 && diferenca < tolerancia, "diferenca %.2e", diferenca);                 \
+        freeComplexMatrix(a);                                                                                             \
+        freeComplexMatrix(U);                                                                                             \
+        freeComplexMatrix(Vh);                                                                                            \
+        freeComplexMatrix(Ug);                                                                                            \
+        freeComplexMatrix(Vhg);                                                                                           \
+    }
+
+    MATRIX_FORMAS_SVD_FIXAS(TESTE_FIXAS_SVD)
+#undef TESTE_FIXAS_SVD
+
+    return falhas;
+}
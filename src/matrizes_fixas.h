@@ -0,0 +1,85 @@
+/**
+ * @file matrizes_fixas.h
+ * @brief Header file for the fixed-size kernels of the usual MIMO shapes (2x2, 4x2, 4x3, 4x4 and 8x8).
+ */
+
+#ifndef MATRIZES_FIXAS_H
+#define MATRIZES_FIXAS_H
+#include "matrizes.h"
+
+/*!
+* @brief Shapes (linhas, colunas) that have an unrolled product by an N x N matrix, as an X-macro.
+*/
+#define MATRIX_FORMAS_FIXAS(X) X(2, 2) X(4, 2) X(4, 3) X(4, 4) X(8, 8)
+
+/*!
+* @brief Shapes (linhas, colunas) that have an unrolled SVD, as an X-macro.
+*
+* 8x8 is left out on purpose: at that size the vectorized row kernels of calc_svd are faster than
+* the unrolled scalar rotations.
+*/
+#define MATRIX_FORMAS_SVD_FIXAS(X) X(2, 2) X(4, 2) X(4, 3) X(4, 4)
+
+/*!
+* @brief Orders of the square shapes that have an unrolled determinant and inverse, as an X-macro.
+*/
+#define MATRIX_ORDENS_FIXAS(X) X(2) X(4) X(8)
+
+///****************************************** DISPATCHERS ****************************************************/
+///
+///-----> Each function checks the shape at run time: the fixed-size kernel is used when there is one,
+///-----> the generic path otherwise (matrizes.c, or the same core with run-time dimensions for the
+///-----> determinant and the inverse). Results and return codes are the same either way.
+///
+
+/**
+ * @brief Writes matrix1 * matrix2 into destino (same contract as matrixProdutoEm).
+ *
+ * @param destino The complexMatrix that receives the product; must not overlap the operands.
+ * @param matrix1 The first complexMatrix.
+ * @param matrix2 The second complexMatrix.
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixProdutoFixoEm(complexMatrix destino, complexMatrix matrix1, complexMatrix matrix2);
+
+/**
+ * @brief Computes the determinant of a square matrix (LU with partial pivoting, closed form for 2x2).
+ *
+ * If the matrix is not square, an error message is printed and the program terminates.
+ *
+ * @param matrix The square complexMatrix.
+ * @return The determinant.
+ */
+complex matrixDeterminanteFixo(complexMatrix matrix);
+
+/**
+ * @brief Writes the inverse of a square matrix into destino (Gauss-Jordan with partial pivoting, closed form for 2x2).
+ *
+ * @param destino The complexMatrix that receives the inverse (may be matrix).
+ * @param matrix The square complexMatrix.
+ * @return 0 on success, -1 if the dimensions do not agree or the matrix is singular.
+ */
+int matrixInversaFixaEm(complexMatrix destino, complexMatrix matrix);
+
+/**
+ * @brief Thin complex SVD with the same contract as calc_svd.
+ *
+ * @param matrix The m x n complexMatrix to be decomposed (left untouched).
+ * @param U The m x k complexMatrix of left singular vectors, k = min(m, n).
+ * @param S Array of k floats that receives the singular values, in decreasing order.
+ * @param Vh The k x n complexMatrix that receives V^H.
+ * @return 0 on success, -1 if the dimensions of the outputs do not agree.
+ */
+int calc_svd_fixo(complexMatrix matrix, complexMatrix U, float *S, complexMatrix Vh);
+
+///****************************************** TESTS ****************************************************/
+
+/**
+ * @brief Checks the unrolled product, determinant, inverse and SVD of every fixed shape against the generic
+ * path of the same operation, and the -1 of the inverse of a singular matrix.
+ *
+ * @return The number of failed checks.
+ */
+int teste_fixas(void);
+
+#endif
@@ -0,0 +1,1652 @@
+/**
+ * @file matrizes_lote.c
+ * @brief Implementation file for batches of small complex matrices (one matrix per SIMD lane).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+/// including the files where the structures are contained
+#include "matrizes_lote.h"
+#include "matrizes.h"
+#include "teste.h"
+
+/*
+ * Number of matrices processed together by the kernels: one AVX register of floats.
+ */
+#define LOTE_LANES MATRIX_LOTE_LANES
+
+/*
+ * Maximum number of Jacobi sweeps of loteSVDEm (the same bound as calc_svd).
+ */
+#define LOTE_SVD_MAX_VARREDURAS 60
+
+/************************************* LANE VECTORS ***************************************/
+
+/*
+ * The kernels are written once, on LOTE_LANES-wide vectors: an __m256 with AVX2, a plain array
+ * otherwise. Comparisons return masks that are only consumed by vEscolhe and vAlgum.
+ */
+#if defined(__AVX2__) && defined(__FMA__)
+typedef __m256 loteVetor;
+
+static inline loteVetor vCarrega(const float *p) { return _mm256_loadu_ps(p); }
+static inline void vGuarda(float *p, loteVetor a) { _mm256_storeu_ps(p, a); }
+static inline loteVetor vConst(float x) { return _mm256_set1_ps(x); }
+static inline loteVetor vSoma(loteVetor a, loteVetor b) { return _mm256_add_ps(a, b); }
+static inline loteVetor vSub(loteVetor a, loteVetor b) { return _mm256_sub_ps(a, b); }
+static inline loteVetor vMul(loteVetor a, loteVetor b) { return _mm256_mul_ps(a, b); }
+static inline loteVetor vDiv(loteVetor a, loteVetor b) { return _mm256_div_ps(a, b); }
+static inline loteVetor vMulSoma(loteVetor a, loteVetor b, loteVetor c) { return _mm256_fmadd_ps(a, b, c); }  //!< c + a*b
+static inline loteVetor vMulSub(loteVetor a, loteVetor b, loteVetor c) { return _mm256_fnmadd_ps(a, b, c); }  //!< c - a*b
+static inline loteVetor vSqrt(loteVetor a) { return _mm256_sqrt_ps(a); }
+static inline loteVetor vNeg(loteVetor a) { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+static inline loteVetor vAbs(loteVetor a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+static inline loteVetor vMaior(loteVetor a, loteVetor b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+static inline loteVetor vIgual(loteVetor a, loteVetor b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+static inline loteVetor vE(loteVetor m1, loteVetor m2) { return _mm256_and_ps(m1, m2); }
+static inline loteVetor vEscolhe(loteVetor m, loteVetor a, loteVetor b) { return _mm256_blendv_ps(a, b, m); } //!< m ? b : a
+static inline int vAlgum(loteVetor m) { return _mm256_movemask_ps(m) != 0; }
+#else
+typedef struct
+{
+    float v[LOTE_LANES];
+} loteVetor;
+
+#define LOTE_LACO(expr)                    \
+    loteVetor r;                           \
+    for (int l = 0; l < LOTE_LANES; l++)   \
+    {                                      \
+        r.v[l] = (expr);                   \
+    }                                      \
+    return r
+
+static inline loteVetor vCarrega(const float *p) { LOTE_LACO(p[l]); }
+static inline void vGuarda(float *p, loteVetor a) { memcpy(p, a.v, sizeof(a.v)); }
+static inline loteVetor vConst(float x) { LOTE_LACO(x); }
+static inline loteVetor vSoma(loteVetor a, loteVetor b) { LOTE_LACO(a.v[l] + b.v[l]); }
+static inline loteVetor vSub(loteVetor a, loteVetor b) { LOTE_LACO(a.v[l] - b.v[l]); }
+static inline loteVetor vMul(loteVetor a, loteVetor b) { LOTE_LACO(a.v[l] * b.v[l]); }
+static inline loteVetor vDiv(loteVetor a, loteVetor b) { LOTE_LACO(a.v[l] / b.v[l]); }
+static inline loteVetor vMulSoma(loteVetor a, loteVetor b, loteVetor c) { LOTE_LACO(c.v[l] + a.v[l] * b.v[l]); }
+static inline loteVetor vMulSub(loteVetor a, loteVetor b, loteVetor c) { LOTE_LACO(c.v[l] - a.v[l] * b.v[l]); }
+static inline loteVetor vSqrt(loteVetor a) { LOTE_LACO(sqrtf(a.v[l])); }
+static inline loteVetor vNeg(loteVetor a) { LOTE_LACO(-a.v[l]); }
+static inline loteVetor vAbs(loteVetor a) { LOTE_LACO(fabsf(a.v[l])); }
+static inline loteVetor vMaior(loteVetor a, loteVetor b) { LOTE_LACO(a.v[l] > b.v[l] ? 1.0f : 0.0f); }
+static inline loteVetor vIgual(loteVetor a, loteVetor b) { LOTE_LACO(a.v[l] == b.v[l] ? 1.0f : 0.0f); }
+static inline loteVetor vE(loteVetor m1, loteVetor m2) { LOTE_LACO((m1.v[l] != 0.0f && m2.v[l] != 0.0f) ? 1.0f : 0.0f); }
+static inline loteVetor vEscolhe(loteVetor m, loteVetor a, loteVetor b) { LOTE_LACO(m.v[l] != 0.0f ? b.v[l] : a.v[l]); }
+
+static inline int vAlgum(loteVetor m)
+{
+    for (int l = 0; l < LOTE_LANES; l++)
+    {
+        if (m.v[l] != 0.0f)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+#endif
+
+/*!
+* @brief LOTE_LANES consecutive matrices of a batch, or of a work buffer: element e is at Re[e * passo].
+*/
+typedef struct
+{
+    float *Re, *Im;
+    int passo;
+} loteFatia;
+
+/**
+ * @brief Fatia of the matrices b0 .. b0 + LOTE_LANES - 1 of a batch.
+ */
+static inline loteFatia loteFatiaDe(complexMatrixLote matrix, int b0)
+{
+    loteFatia fatia = {matrix.Re + b0, matrix.Im + b0, matrix.passo};
+    return fatia;
+}
+
+static inline loteVetor fRe(loteFatia f, int e) { return vCarrega(f.Re + (size_t)e * f.passo); }
+static inline loteVetor fIm(loteFatia f, int e) { return vCarrega(f.Im + (size_t)e * f.passo); }
+
+static inline void fEscreve(loteFatia f, int e, loteVetor re, loteVetor im)
+{
+    vGuarda(f.Re + (size_t)e * f.passo, re);
+    vGuarda(f.Im + (size_t)e * f.passo, im);
+}
+
+/**
+ * @brief Number of lanes the kernels sweep: the batch rounded up to whole vectors (never past 'passo').
+ */
+static inline int loteLanes(complexMatrixLote matrix)
+{
+    return (matrix.lote + LOTE_LANES - 1) / LOTE_LANES * LOTE_LANES;
+}
+
+/**
+ * @brief Work buffer of 'elementos' complex lane vectors (both planes in one aligned block).
+ */
+static loteFatia loteFatiaTrabalho(int elementos)
+{
+    size_t bytesPlano = (size_t)elementos * LOTE_LANES * sizeof(float);
+    float *bloco = (float *)matrixAlignedAlloc(2 * bytesPlano);
+
+    if (bloco == NULL)
+    {
+        printf("Falha na alocacao de memoria\n");
+        exit(1);
+    }
+
+    loteFatia fatia = {bloco, (float *)((char *)bloco + bytesPlano), LOTE_LANES};
+    return fatia;
+}
+
+/************************************* ALLOCATION AND CONVERSION ***************************************/
+
+/**
+ * @param[in] lote Number of matrices
+ * @param[in] linhas Number of rows of each matrix
+ * @param[in] colunas Number of columns of each matrix
+ *
+ * @brief Allocates both planes of the batch in a single aligned block and zeroes it.
+ *
+ * If the allocation fails, an error message is printed and the program terminates.
+ *
+ * @return The allocated complexMatrixLote.
+ */
+complexMatrixLote allocateComplexMatrixLote(int lote, int linhas, int colunas)
+{
+    complexMatrixLote matrix;
+    const int porLinha = MATRIX_ALINHAMENTO / (int)sizeof(float);
+
+    matrix.lote = lote;
+    matrix.linhas = linhas;
+    matrix.colunas = colunas;
+    matrix.passo = (lote + porLinha - 1) / porLinha * porLinha;
+
+    size_t bytesPlano = (size_t)linhas * colunas * matrix.passo * sizeof(float);
+    matrix.bloco = matrixAlignedAlloc(2 * bytesPlano);
+
+    if (matrix.bloco == NULL)
+    {
+        printf("Falha na alocacao de memoria\n");
+        exit(1);
+    }
+
+    //! Zeroing the padding lanes as well, so the kernels never see garbage there
+    memset(matrix.bloco, 0, 2 * bytesPlano);
+
+    matrix.Re = (float *)matrix.bloco;
+    matrix.Im = (float *)((char *)matrix.bloco + bytesPlano);
+
+    return matrix;
+}
+
+/**
+ * @brief Frees the block of a batch.
+ */
+void freeComplexMatrixLote(complexMatrixLote matrix)
+{
+    matrixAlignedFree(matrix.bloco);
+}
+
+/**
+ * @brief Nonzero if the lanes a kernel sweeps on the view, [b0, b0 + loteLanes(view)), stay inside the view or
+ * in the padding of the batch.
+ *
+ * The kernels round 'lote' up to whole vectors, so a view whose size is not a multiple of LOTE_LANES is only
+ * valid if it ends at the last matrix of the batch: anywhere else its last vector would overwrite the matrices
+ * that follow it.
+ */
+static int loteViewValida(complexMatrixLote matrix, int b0, int quantidade)
+{
+    return b0 >= 0 && b0 % LOTE_LANES == 0 && quantidade >= 0 && b0 + quantidade <= matrix.lote &&
+           (quantidade % LOTE_LANES == 0 || b0 + quantidade == matrix.lote);
+}
+
+/**
+ * @param[in] matrix The batch
+ * @param[in] b0 Index of the first matrix of the view (multiple of MATRIX_LOTE_LANES)
+ * @param[in] quantidade Number of matrices of the view (multiple of MATRIX_LOTE_LANES, unless the view ends at
+ * the last matrix of the batch)
+ *
+ * @brief Points the planes of the view at lane b0 of the batch; the element stride is unchanged.
+ *
+ * @return The view.
+ */
+complexMatrixLote loteView(complexMatrixLote matrix, int b0, int quantidade)
+{
+    if (!loteViewValida(matrix, b0, quantidade))
+    {
+        printf("Fatia invalida do lote\n");
+        exit(1);
+    }
+
+    complexMatrixLote view = matrix;
+
+    view.lote = quantidade;
+    view.Re = matrix.Re + b0;
+    view.Im = matrix.Im + b0;
+    view.bloco = NULL;
+
+    return view;
+}
+
+/**
+ * @param[out] destino The batch
+ * @param[in] b Index of the matrix in the batch
+ * @param[in] origem The matrix to be copied
+ *
+ * @brief Scatters the elements of origem into lane b of the batch.
+ *
+ * @return 0 on success, -1 if the dimensions or the index do not agree.
+ */
+int loteCarregaMatrix(complexMatrixLote destino, int b, complexMatrix origem)
+{
+    if (b < 0 || b >= destino.lote || destino.linhas != origem.linhas || destino.colunas != origem.colunas)
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < origem.linhas; i++)
+    {
+        const complex *linha = matrixLinha(origem, i);
+
+        for (int j = 0; j < origem.colunas; j++)
+        {
+            const size_t e = ((size_t)i * origem.colunas + j) * destino.passo + b;
+
+            destino.Re[e] = linha[j].Re;
+            destino.Im[e] = linha[j].Im;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @param[out] destino The matrix that receives the copy
+ * @param[in] origem The batch
+ * @param[in] b Index of the matrix in the batch
+ *
+ * @brief Gathers lane b of the batch into destino.
+ *
+ * @return 0 on success, -1 if the dimensions or the index do not agree.
+ */
+int loteExtraiMatrix(complexMatrix destino, complexMatrixLote origem, int b)
+{
+    if (b < 0 || b >= origem.lote || destino.linhas != origem.linhas || destino.colunas != origem.colunas)
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < destino.linhas; i++)
+    {
+        complex *linha = matrixLinha(destino, i);
+
+        for (int j = 0; j < destino.colunas; j++)
+        {
+            const size_t e = ((size_t)i * destino.colunas + j) * origem.passo + b;
+
+            linha[j].Re = origem.Re[e];
+            linha[j].Im = origem.Im[e];
+        }
+    }
+
+    return 0;
+}
+
+/************************************* BATCHED OPERATIONS ***************************************/
+
+/**
+ * @brief Checks that two batches hold the same number of matrices.
+ */
+static int loteMesmoLote(complexMatrixLote a, complexMatrixLote b)
+{
+    return a.lote == b.lote && a.passo == b.passo;
+}
+
+/**
+ * @param[out] destino The batch of sums
+ * @param[in] matrix1 The first batch
+ * @param[in] matrix2 The second batch
+ *
+ * @brief Adds two batches, element by element, one lane vector at a time.
+ *
+ * @return 0 on success, -1 if the shapes or batch sizes do not agree.
+ */
+int loteSomaEm(complexMatrixLote destino, complexMatrixLote matrix1, complexMatrixLote matrix2)
+{
+    if (!loteMesmoLote(destino, matrix1) || !loteMesmoLote(destino, matrix2) ||
+        matrix1.linhas != matrix2.linhas || matrix1.colunas != matrix2.colunas ||
+        destino.linhas != matrix1.linhas || destino.colunas != matrix1.colunas)
+    {
+        return -1;
+    }
+
+    const int elementos = destino.linhas * destino.colunas;
+
+    for (int e = 0; e < elementos; e++)
+    {
+        const size_t base = (size_t)e * destino.passo;
+
+        for (int b0 = 0; b0 < loteLanes(destino); b0 += LOTE_LANES)
+        {
+            const size_t i = base + b0;
+
+            vGuarda(destino.Re + i, vSoma(vCarrega(matrix1.Re + i), vCarrega(matrix2.Re + i)));
+            vGuarda(destino.Im + i, vSoma(vCarrega(matrix1.Im + i), vCarrega(matrix2.Im + i)));
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @param[out] destino The batch of products (m x n)
+ * @param[in] matrix1 The first batch (m x k)
+ * @param[in] matrix2 The second batch (k x n)
+ *
+ * @brief Multiplies the matrices of two batches, LOTE_LANES pairs at a time.
+ *
+ * @return 0 on success, -1 if the shapes or batch sizes do not agree.
+ */
+int loteProdutoEm(complexMatrixLote destino, complexMatrixLote matrix1, complexMatrixLote matrix2)
+{
+    if (!loteMesmoLote(destino, matrix1) || !loteMesmoLote(destino, matrix2) ||
+        matrix1.colunas != matrix2.linhas || destino.linhas != matrix1.linhas || destino.colunas != matrix2.colunas)
+    {
+        return -1;
+    }
+
+    const int m = matrix1.linhas, k = matrix1.colunas, n = matrix2.colunas;
+
+    for (int b0 = 0; b0 < loteLanes(destino); b0 += LOTE_LANES)
+    {
+        const loteFatia A = loteFatiaDe(matrix1, b0);
+        const loteFatia B = loteFatiaDe(matrix2, b0);
+        const loteFatia C = loteFatiaDe(destino, b0);
+
+        for (int i = 0; i < m; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                loteVetor re = vConst(0.0f), im = vConst(0.0f);
+
+                for (int l = 0; l < k; l++)
+                {
+                    const loteVetor ar = fRe(A, i * k + l), ai = fIm(A, i * k + l);
+                    const loteVetor br = fRe(B, l * n + j), bi = fIm(B, l * n + j);
+
+                    re = vMulSub(ai, bi, vMulSoma(ar, br, re));
+                    im = vMulSoma(ai, br, vMulSoma(ar, bi, im));
+                }
+
+                fEscreve(C, i * n + j, re, im);
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @param[out] destino The batch of conjugate transposes (n x m)
+ * @param[in] matrix The original batch (m x n)
+ *
+ * @brief Conjugate transpose of every matrix: each element moves as a whole lane vector.
+ *
+ * @return 0 on success, -1 if the shapes or batch sizes do not agree.
+ */
+int loteHermitianaEm(complexMatrixLote destino, complexMatrixLote matrix)
+{
+    if (!loteMesmoLote(destino, matrix) || destino.linhas != matrix.colunas || destino.colunas != matrix.linhas)
+    {
+        return -1;
+    }
+
+    for (int b0 = 0; b0 < loteLanes(destino); b0 += LOTE_LANES)
+    {
+        const loteFatia A = loteFatiaDe(matrix, b0);
+        const loteFatia H = loteFatiaDe(destino, b0);
+
+        for (int i = 0; i < matrix.linhas; i++)
+        {
+            for (int j = 0; j < matrix.colunas; j++)
+            {
+                const int e = i * matrix.colunas + j;
+                fEscreve(H, j * matrix.linhas + i, fRe(A, e), vNeg(fIm(A, e)));
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @param[out] destino The batch of Gram matrices (n x n)
+ * @param[in] matrix The original batch (m x n)
+ *
+ * @brief Computes matrix[b]^H matrix[b]; only the upper triangle is accumulated, the rest is mirrored.
+ *
+ * @return 0 on success, -1 if the shapes or batch sizes do not agree.
+ */
+int loteGramEm(complexMatrixLote destino, complexMatrixLote matrix)
+{
+    if (!loteMesmoLote(destino, matrix) || destino.linhas != matrix.colunas || destino.colunas != matrix.colunas)
+    {
+        return -1;
+    }
+
+    const int m = matrix.linhas, n = matrix.colunas;
+
+    for (int b0 = 0; b0 < loteLanes(destino); b0 += LOTE_LANES)
+    {
+        const loteFatia A = loteFatiaDe(matrix, b0);
+        const loteFatia G = loteFatiaDe(destino, b0);
+
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = i; j < n; j++)
+            {
+                loteVetor re = vConst(0.0f), im = vConst(0.0f);
+
+                for (int l = 0; l < m; l++)
+                {
+                    const loteVetor ar = fRe(A, l * n + i), ai = fIm(A, l * n + i);
+                    const loteVetor br = fRe(A, l * n + j), bi = fIm(A, l * n + j);
+
+                    //! conj(a) * b
+                    re = vMulSoma(ai, bi, vMulSoma(ar, br, re));
+                    im = vMulSub(ai, br, vMulSoma(ar, bi, im));
+                }
+
+                if (i == j)
+                {
+                    fEscreve(G, i * n + i, re, vConst(0.0f));
+                }
+                else
+                {
+                    fEscreve(G, i * n + j, re, im);
+                    fEscreve(G, j * n + i, re, vNeg(im));
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @param[out] destino The batch of inverses (may be matrix)
+ * @param[in] matrix The batch of square matrices
+ *
+ * @brief Gauss-Jordan elimination on [A | I], with partial pivoting chosen independently in every lane.
+ *
+ * The pivot search keeps, per lane, the largest |a(r, k)|^2 and its row; the row exchange is then a
+ * masked swap, so lanes that pivot differently never diverge in control flow.
+ *
+ * @return 0 on success, -1 if the shapes or batch sizes do not agree.
+ */
+int loteInversaEm(complexMatrixLote destino, complexMatrixLote matrix)
+{
+    if (!loteMesmoLote(destino, matrix) || matrix.linhas != matrix.colunas ||
+        destino.linhas != matrix.linhas || destino.colunas != matrix.colunas)
+    {
+        return -1;
+    }
+
+    const int n = matrix.linhas;
+    const int largura = 2 * n;
+    loteFatia W = loteFatiaTrabalho(n * largura);
+
+    for (int b0 = 0; b0 < loteLanes(destino); b0 += LOTE_LANES)
+    {
+        const loteFatia A = loteFatiaDe(matrix, b0);
+        const loteFatia D = loteFatiaDe(destino, b0);
+
+        //! Building [A | I]
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                fEscreve(W, i * largura + j, fRe(A, i * n + j), fIm(A, i * n + j));
+                fEscreve(W, i * largura + n + j, vConst(i == j ? 1.0f : 0.0f), vConst(0.0f));
+            }
+        }
+
+        for (int k = 0; k < n; k++)
+        {
+            //! Pivot search, lane by lane
+            loteVetor pr = fRe(W, k * largura + k), pi = fIm(W, k * largura + k);
+            loteVetor melhor = vMulSoma(pi, pi, vMul(pr, pr));
+            loteVetor pivo = vConst((float)k);
+
+            for (int r = k + 1; r < n; r++)
+            {
+                const loteVetor xr = fRe(W, r * largura + k), xi = fIm(W, r * largura + k);
+                const loteVetor valor = vMulSoma(xi, xi, vMul(xr, xr));
+                const loteVetor maior = vMaior(valor, melhor);
+
+                melhor = vEscolhe(maior, melhor, valor);
+                pivo = vEscolhe(maior, pivo, vConst((float)r));
+            }
+
+            //! Masked exchange of row k with the pivot row of each lane (columns before k are already zero)
+            for (int r = k + 1; r < n; r++)
+            {
+                const loteVetor troca = vIgual(pivo, vConst((float)r));
+
+                if (!vAlgum(troca))
+                {
+                    continue;
+                }
+
+                for (int c = k; c < largura; c++)
+                {
+                    const loteVetor kr = fRe(W, k * largura + c), ki = fIm(W, k * largura + c);
+                    const loteVetor rr = fRe(W, r * largura + c), ri = fIm(W, r * largura + c);
+
+                    fEscreve(W, k * largura + c, vEscolhe(troca, kr, rr), vEscolhe(troca, ki, ri));
+                    fEscreve(W, r * largura + c, vEscolhe(troca, rr, kr), vEscolhe(troca, ri, ki));
+                }
+            }
+
+            //! Scaling row k by 1 / pivot = conj(pivot) / |pivot|^2
+            pr = fRe(W, k * largura + k);
+            pi = fIm(W, k * largura + k);
+
+            const loteVetor modulo2 = vMulSoma(pi, pi, vMul(pr, pr));
+            const loteVetor invRe = vDiv(pr, modulo2);
+            const loteVetor invIm = vNeg(vDiv(pi, modulo2));
+
+            for (int c = k; c < largura; c++)
+            {
+                const loteVetor xr = fRe(W, k * largura + c), xi = fIm(W, k * largura + c);
+
+                fEscreve(W, k * largura + c, vMulSub(xi, invIm, vMul(xr, invRe)), vMulSoma(xi, invRe, vMul(xr, invIm)));
+            }
+
+            //! Eliminating column k from every other row
+            for (int r = 0; r < n; r++)
+            {
+                if (r == k)
+                {
+                    continue;
+                }
+
+                const loteVetor fr = fRe(W, r * largura + k), fi = fIm(W, r * largura + k);
+
+                for (int c = k; c < largura; c++)
+                {
+                    const loteVetor xr = fRe(W, k * largura + c), xi = fIm(W, k * largura + c);
+                    loteVetor re = fRe(W, r * largura + c), im = fIm(W, r * largura + c);
+
+                    //! row_r -= f * row_k
+                    re = vMulSoma(fi, xi, vMulSub(fr, xr, re));
+                    im = vMulSub(fi, xr, vMulSub(fr, xi, im));
+                    fEscreve(W, r * largura + c, re, im);
+                }
+            }
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                fEscreve(D, i * n + j, fRe(W, i * largura + n + j), fIm(W, i * largura + n + j));
+            }
+        }
+    }
+
+    matrixAlignedFree(W.Re);
+
+    return 0;
+}
+
+/**
+ * @brief Lane-wise |p|^2, |q|^2 and sum p conj(q) of rows p and q (length n) of a work buffer.
+ */
+static void loteSvdProdutos(loteFatia X, int n, int p, int q, loteVetor *alpha, loteVetor *beta, loteVetor *gRe, loteVetor *gIm)
+{
+    loteVetor aa = vConst(0.0f), bb = vConst(0.0f), gr = vConst(0.0f), gi = vConst(0.0f);
+
+    for (int c = 0; c < n; c++)
+    {
+        const loteVetor pr = fRe(X, p * n + c), pi = fIm(X, p * n + c);
+        const loteVetor qr = fRe(X, q * n + c), qi = fIm(X, q * n + c);
+
+        aa = vMulSoma(pi, pi, vMulSoma(pr, pr, aa));
+        bb = vMulSoma(qi, qi, vMulSoma(qr, qr, bb));
+        gr = vMulSoma(pi, qi, vMulSoma(pr, qr, gr));
+        gi = vMulSub(pr, qi, vMulSoma(pi, qr, gi));
+    }
+
+    *alpha = aa;
+    *beta = bb;
+    *gRe = gr;
+    *gIm = gi;
+}
+
+/**
+ * @brief Lane-wise rotation p <- c p - w q, q <- conj(w) p + c q of rows p and q (length n).
+ */
+static void loteSvdRotaciona(loteFatia X, int n, int p, int q, loteVetor c, loteVetor wr, loteVetor wi)
+{
+    for (int k = 0; k < n; k++)
+    {
+        const loteVetor pr = fRe(X, p * n + k), pi = fIm(X, p * n + k);
+        const loteVetor qr = fRe(X, q * n + k), qi = fIm(X, q * n + k);
+
+        fEscreve(X, p * n + k,
+                 vMulSoma(wi, qi, vMulSub(wr, qr, vMul(c, pr))),
+                 vMulSub(wi, qr, vMulSub(wr, qi, vMul(c, pi))));
+        fEscreve(X, q * n + k,
+                 vMulSoma(wi, pi, vMulSoma(wr, pr, vMul(c, qr))),
+                 vMulSub(wi, pr, vMulSoma(wr, pi, vMul(c, qi))));
+    }
+}
+
+/**
+ * @brief Lane-wise masked swap of rows p and q (length n).
+ */
+static void loteSvdTroca(loteFatia X, int n, int p, int q, loteVetor troca)
+{
+    for (int k = 0; k < n; k++)
+    {
+        const loteVetor pr = fRe(X, p * n + k), pi = fIm(X, p * n + k);
+        const loteVetor qr = fRe(X, q * n + k), qi = fIm(X, q * n + k);
+
+        fEscreve(X, p * n + k, vEscolhe(troca, pr, qr), vEscolhe(troca, pi, qi));
+        fEscreve(X, q * n + k, vEscolhe(troca, qr, pr), vEscolhe(troca, qi, pi));
+    }
+}
+
+/**
+ * @param[out] U The batch of left singular vectors (m x k)
+ * @param[out] S The singular values, S[i * matrix.passo + b]
+ * @param[out] Vh The batch of V^H (k x n)
+ * @param[in] matrix The batch to be decomposed (m x n)
+ *
+ * @brief One-sided Jacobi SVD of every matrix of the batch, with the same row formulation as calc_svd.
+ *
+ * Every lane computes its own rotation; lanes that have already converged get the identity rotation
+ * (c = 1, w = 0) through a mask, and a sweep that rotates no lane at all ends the iteration.
+ *
+ * @return 0 on success, -1 if the shapes or batch sizes do not agree.
+ */
+int loteSVDEm(complexMatrixLote U, float *S, complexMatrixLote Vh, complexMatrixLote matrix)
+{
+    const int m = matrix.linhas;
+    const int n = matrix.colunas;
+    const int k = (m < n) ? m : n;
+    const int L = (m < n) ? n : m; //!< Length of the rows being orthogonalized
+    const int larga = (m < n);
+
+    if (!loteMesmoLote(U, matrix) || !loteMesmoLote(Vh, matrix) ||
+        U.linhas != m || U.colunas != k || Vh.linhas != k || Vh.colunas != n)
+    {
+        return -1;
+    }
+
+    const loteVetor tolerancia = vConst(FLT_EPSILON * (L > 16 ? (float)L : 16.0f));
+    const loteVetor minimo = vConst(FLT_MIN);
+    const loteVetor um = vConst(1.0f), zero = vConst(0.0f);
+
+    loteFatia X = loteFatiaTrabalho(k * L);
+    loteFatia Q = loteFatiaTrabalho(k * k);
+
+    for (int b0 = 0; b0 < loteLanes(matrix); b0 += LOTE_LANES)
+    {
+        const loteFatia A = loteFatiaDe(matrix, b0);
+
+        //! Wide matrices: X = A; tall ones: X = A^H. Q starts as the identity.
+        for (int r = 0; r < k; r++)
+        {
+            for (int c = 0; c < L; c++)
+            {
+                if (larga)
+                {
+                    fEscreve(X, r * L + c, fRe(A, r * n + c), fIm(A, r * n + c));
+                }
+                else
+                {
+                    fEscreve(X, r * L + c, fRe(A, c * n + r), vNeg(fIm(A, c * n + r)));
+                }
+            }
+            for (int c = 0; c < k; c++)
+            {
+                fEscreve(Q, r * k + c, vConst(r == c ? 1.0f : 0.0f), zero);
+            }
+        }
+
+        for (int varredura = 0; varredura < LOTE_SVD_MAX_VARREDURAS; varredura++)
+        {
+            int rotacoes = 0;
+
+            for (int p = 0; p < k - 1; p++)
+            {
+                for (int q = p + 1; q < k; q++)
+                {
+                    loteVetor alpha, beta, gRe, gIm;
+
+                    loteSvdProdutos(X, L, p, q, &alpha, &beta, &gRe, &gIm);
+
+                    const loteVetor modulo = vSqrt(vMulSoma(gIm, gIm, vMul(gRe, gRe)));
+                    const loteVetor ativo = vE(vMaior(modulo, vMul(tolerancia, vSqrt(vMul(alpha, beta)))),
+                                               vMaior(modulo, minimo));
+
+                    if (!vAlgum(ativo))
+                    {
+                        continue;
+                    }
+
+                    //! Same rotation as calc_svd, computed in every lane; inactive lanes use a safe modulus
+                    const loteVetor mod = vEscolhe(ativo, um, modulo);
+                    const loteVetor zeta = vDiv(vSub(beta, alpha), vMul(vConst(2.0f), mod));
+                    const loteVetor sinal = vEscolhe(vMaior(zero, zeta), um, vConst(-1.0f));
+                    const loteVetor t = vDiv(sinal, vSoma(vAbs(zeta), vSqrt(vMulSoma(zeta, zeta, um))));
+                    const loteVetor c = vDiv(um, vSqrt(vMulSoma(t, t, um)));
+                    const loteVetor s = vDiv(vMul(c, t), mod);
+
+                    const loteVetor cc = vEscolhe(ativo, um, c);
+                    const loteVetor wr = vEscolhe(ativo, zero, vMul(s, gRe));
+                    const loteVetor wi = vEscolhe(ativo, zero, vMul(s, gIm));
+
+                    loteSvdRotaciona(X, L, p, q, cc, wr, wi);
+                    loteSvdRotaciona(Q, k, p, q, cc, wr, wi);
+                    rotacoes++;
+                }
+            }
+
+            if (rotacoes == 0)
+            {
+                break;
+            }
+        }
+
+        //! Singular values are the row norms; they are kept in the output array while sorting
+        for (int i = 0; i < k; i++)
+        {
+            loteVetor alpha, beta, gRe, gIm;
+
+            loteSvdProdutos(X, L, i, i, &alpha, &beta, &gRe, &gIm);
+            vGuarda(S + (size_t)i * matrix.passo + b0, vSqrt(alpha));
+        }
+
+        //! Compare-exchange sort, by decreasing singular value, lane by lane
+        for (int i = 0; i < k - 1; i++)
+        {
+            for (int j = i + 1; j < k; j++)
+            {
+                const loteVetor si = vCarrega(S + (size_t)i * matrix.passo + b0);
+                const loteVetor sj = vCarrega(S + (size_t)j * matrix.passo + b0);
+                const loteVetor troca = vMaior(sj, si);
+
+                if (!vAlgum(troca))
+                {
+                    continue;
+                }
+
+                vGuarda(S + (size_t)i * matrix.passo + b0, vEscolhe(troca, si, sj));
+                vGuarda(S + (size_t)j * matrix.passo + b0, vEscolhe(troca, sj, si));
+                loteSvdTroca(X, L, i, j, troca);
+                loteSvdTroca(Q, k, i, j, troca);
+            }
+        }
+
+        //! Normalizing the rows; rows of null singular values are left as zero
+        for (int i = 0; i < k; i++)
+        {
+            const loteVetor sigma = vCarrega(S + (size_t)i * matrix.passo + b0);
+            const loteVetor util = vMaior(sigma, minimo);
+            const loteVetor inv = vEscolhe(util, zero, vDiv(um, vEscolhe(util, um, sigma)));
+
+            vGuarda(S + (size_t)i * matrix.passo + b0, vEscolhe(util, zero, sigma));
+
+            for (int c = 0; c < L; c++)
+            {
+                fEscreve(X, i * L + c, vMul(fRe(X, i * L + c), inv), vMul(fIm(X, i * L + c), inv));
+            }
+        }
+
+        //! Wide: Vh = X, U = Q^H. Tall: U = X^H, Vh = Q.
+        const loteFatia FU = loteFatiaDe(U, b0);
+        const loteFatia FV = loteFatiaDe(Vh, b0);
+        const loteFatia linhasSaida = larga ? FV : FU;
+        const loteFatia quadrada = larga ? FU : FV;
+
+        for (int r = 0; r < k; r++)
+        {
+            for (int c = 0; c < L; c++)
+            {
+                if (larga)
+                {
+                    fEscreve(linhasSaida, r * n + c, fRe(X, r * L + c), fIm(X, r * L + c));
+                }
+                else
+                {
+                    fEscreve(linhasSaida, c * k + r, fRe(X, r * L + c), vNeg(fIm(X, r * L + c)));
+                }
+            }
+            for (int c = 0; c < k; c++)
+            {
+                if (larga)
+                {
+                    fEscreve(quadrada, c * k + r, fRe(Q, r * k + c), vNeg(fIm(Q, r * k + c)));
+                }
+                else
+                {
+                    fEscreve(quadrada, r * k + c, fRe(Q, r * k + c), fIm(Q, r * k + c));
+                }
+            }
+        }
+    }
+
+    matrixAlignedFree(X.Re);
+    matrixAlignedFree(Q.Re);
+
+    return 0;
+}
+
+/************************************* FACTORIZATIONS AND SOLVERS ***************************************/
+
+/*
+ * The cores below work on one group of LOTE_LANES matrices (a loteFatia of the batch or of a work
+ * buffer) and follow the single-matrix kernels of matrizes_fatoracao.c step by step. Nothing
+ * branches on the data: pivots and breakdowns are handled per lane, and a lane that breaks down
+ * (singular or not positive definite) only fills its own slot with non-finite values.
+ */
+
+/**
+ * @brief (re, im) -= (fr + i fi) * (xr + i xi), lane-wise.
+ */
+static inline void loteCMulSub(loteVetor *re, loteVetor *im, loteVetor fr, loteVetor fi, loteVetor xr, loteVetor xi)
+{
+    *re = vMulSoma(fi, xi, vMulSub(fr, xr, *re));
+    *im = vMulSub(fi, xr, vMulSub(fr, xi, *im));
+}
+
+/**
+ * @brief Copies 'elementos' lane vectors from origem to destino, unless they are the same storage.
+ */
+static void loteCopiaFatia(loteFatia destino, loteFatia origem, int elementos)
+{
+    if (destino.Re == origem.Re)
+    {
+        return;
+    }
+
+    for (int e = 0; e < elementos; e++)
+    {
+        fEscreve(destino, e, fRe(origem, e), fIm(origem, e));
+    }
+}
+
+/**
+ * @brief Lane-wise masked swap of rows p and q of an n-column fatia.
+ */
+static void loteTrocaLinhas(loteFatia X, int n, int p, int q, loteVetor troca)
+{
+    for (int c = 0; c < n; c++)
+    {
+        const loteVetor pr = fRe(X, p * n + c), pi = fIm(X, p * n + c);
+        const loteVetor qr = fRe(X, q * n + c), qi = fIm(X, q * n + c);
+
+        fEscreve(X, p * n + c, vEscolhe(troca, pr, qr), vEscolhe(troca, pi, qi));
+        fEscreve(X, q * n + c, vEscolhe(troca, qr, pr), vEscolhe(troca, qi, pi));
+    }
+}
+
+/**
+ * @brief In-place Cholesky of the n x n fatia L (lower triangle read, zeros written above the diagonal).
+ */
+static void loteCholeskyNucleo(loteFatia L, int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j <= i; j++)
+        {
+            loteVetor sr = fRe(L, i * n + j), si = fIm(L, i * n + j);
+
+            //! s -= l(i, p) conj(l(j, p))
+            for (int p = 0; p < j; p++)
+            {
+                const loteVetor ar = fRe(L, i * n + p), ai = fIm(L, i * n + p);
+                const loteVetor br = fRe(L, j * n + p), bi = fIm(L, j * n + p);
+
+                sr = vMulSub(ai, bi, vMulSub(ar, br, sr));
+                si = vMulSoma(ar, bi, vMulSub(ai, br, si));
+            }
+
+            if (j == i)
+            {
+                fEscreve(L, i * n + i, vSqrt(sr), vConst(0.0f));
+            }
+            else
+            {
+                const loteVetor inverso = vDiv(vConst(1.0f), fRe(L, j * n + j));
+                fEscreve(L, i * n + j, vMul(sr, inverso), vMul(si, inverso));
+            }
+        }
+
+        for (int j = i + 1; j < n; j++)
+        {
+            fEscreve(L, i * n + j, vConst(0.0f), vConst(0.0f));
+        }
+    }
+}
+
+/**
+ * @brief Solves L L^H X = X in place (X is n x nrhs).
+ */
+static void loteCholeskySolveNucleo(loteFatia L, int n, loteFatia X, int nrhs)
+{
+    for (int i = 0; i < n; i++)
+    {
+        const loteVetor inverso = vDiv(vConst(1.0f), fRe(L, i * n + i));
+
+        for (int c = 0; c < nrhs; c++)
+        {
+            loteVetor re = fRe(X, i * nrhs + c), im = fIm(X, i * nrhs + c);
+
+            for (int p = 0; p < i; p++)
+            {
+                loteCMulSub(&re, &im, fRe(L, i * n + p), fIm(L, i * n + p), fRe(X, p * nrhs + c), fIm(X, p * nrhs + c));
+            }
+
+            fEscreve(X, i * nrhs + c, vMul(re, inverso), vMul(im, inverso));
+        }
+    }
+
+    //! L^H(i, p) = conj(L(p, i))
+    for (int i = n - 1; i >= 0; i--)
+    {
+        const loteVetor inverso = vDiv(vConst(1.0f), fRe(L, i * n + i));
+
+        for (int c = 0; c < nrhs; c++)
+        {
+            loteVetor re = fRe(X, i * nrhs + c), im = fIm(X, i * nrhs + c);
+
+            for (int p = i + 1; p < n; p++)
+            {
+                loteCMulSub(&re, &im, fRe(L, p * n + i), vNeg(fIm(L, p * n + i)), fRe(X, p * nrhs + c), fIm(X, p * nrhs + c));
+            }
+
+            fEscreve(X, i * nrhs + c, vMul(re, inverso), vMul(im, inverso));
+        }
+    }
+}
+
+/**
+ * @brief In-place LU with lane-wise partial pivoting of the n x n fatia W; pivot rows go to P.Re[k * P.passo].
+ */
+static void loteLUNucleo(loteFatia W, int n, loteFatia P)
+{
+    for (int k = 0; k < n; k++)
+    {
+        loteVetor pr = fRe(W, k * n + k), pi = fIm(W, k * n + k);
+        loteVetor melhor = vMulSoma(pi, pi, vMul(pr, pr));
+        loteVetor pivo = vConst((float)k);
+
+        for (int r = k + 1; r < n; r++)
+        {
+            const loteVetor xr = fRe(W, r * n + k), xi = fIm(W, r * n + k);
+            const loteVetor valor = vMulSoma(xi, xi, vMul(xr, xr));
+            const loteVetor maior = vMaior(valor, melhor);
+
+            melhor = vEscolhe(maior, melhor, valor);
+            pivo = vEscolhe(maior, pivo, vConst((float)r));
+        }
+
+        vGuarda(P.Re + (size_t)k * P.passo, pivo);
+
+        //! Whole rows are exchanged, multipliers included (LAPACK convention)
+        for (int r = k + 1; r < n; r++)
+        {
+            const loteVetor troca = vIgual(pivo, vConst((float)r));
+
+            if (vAlgum(troca))
+            {
+                loteTrocaLinhas(W, n, k, r, troca);
+            }
+        }
+
+        pr = fRe(W, k * n + k);
+        pi = fIm(W, k * n + k);
+
+        const loteVetor modulo2 = vMulSoma(pi, pi, vMul(pr, pr));
+        const loteVetor invRe = vDiv(pr, modulo2);
+        const loteVetor invIm = vNeg(vDiv(pi, modulo2));
+
+        for (int r = k + 1; r < n; r++)
+        {
+            const loteVetor xr = fRe(W, r * n + k), xi = fIm(W, r * n + k);
+            const loteVetor fr = vMulSub(xi, invIm, vMul(xr, invRe));
+            const loteVetor fi = vMulSoma(xi, invRe, vMul(xr, invIm));
+
+            fEscreve(W, r * n + k, fr, fi);
+
+            for (int c = k + 1; c < n; c++)
+            {
+                loteVetor re = fRe(W, r * n + c), im = fIm(W, r * n + c);
+
+                loteCMulSub(&re, &im, fr, fi, fRe(W, k * n + c), fIm(W, k * n + c));
+                fEscreve(W, r * n + c, re, im);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Solves A X = X in place from the factors of loteLUNucleo (X is n x nrhs).
+ */
+static void loteLUSolveNucleo(loteFatia LU, int n, loteFatia P, loteFatia X, int nrhs)
+{
+    for (int k = 0; k < n; k++)
+    {
+        const loteVetor pivo = vCarrega(P.Re + (size_t)k * P.passo);
+
+        for (int r = k + 1; r < n; r++)
+        {
+            const loteVetor troca = vIgual(pivo, vConst((float)r));
+
+            if (vAlgum(troca))
+            {
+                loteTrocaLinhas(X, nrhs, k, r, troca);
+            }
+        }
+    }
+
+    for (int i = 1; i < n; i++)
+    {
+        for (int c = 0; c < nrhs; c++)
+        {
+            loteVetor re = fRe(X, i * nrhs + c), im = fIm(X, i * nrhs + c);
+
+            for (int p = 0; p < i; p++)
+            {
+                loteCMulSub(&re, &im, fRe(LU, i * n + p), fIm(LU, i * n + p), fRe(X, p * nrhs + c), fIm(X, p * nrhs + c));
+            }
+
+            fEscreve(X, i * nrhs + c, re, im);
+        }
+    }
+
+    for (int i = n - 1; i >= 0; i--)
+    {
+        const loteVetor dr = fRe(LU, i * n + i), di = fIm(LU, i * n + i);
+        const loteVetor modulo2 = vMulSoma(di, di, vMul(dr, dr));
+        const loteVetor invRe = vDiv(dr, modulo2);
+        const loteVetor invIm = vNeg(vDiv(di, modulo2));
+
+        for (int c = 0; c < nrhs; c++)
+        {
+            loteVetor re = fRe(X, i * nrhs + c), im = fIm(X, i * nrhs + c);
+
+            for (int p = i + 1; p < n; p++)
+            {
+                loteCMulSub(&re, &im, fRe(LU, i * n + p), fIm(LU, i * n + p), fRe(X, p * nrhs + c), fIm(X, p * nrhs + c));
+            }
+
+            fEscreve(X, i * nrhs + c, vMulSub(im, invIm, vMul(re, invRe)), vMulSoma(im, invRe, vMul(re, invIm)));
+        }
+    }
+}
+
+/**
+ * @brief Applies H = I - v v^H (v in column k, rows k .. m - 1 of Q) to the columns k + 1 .. n - 1 of Q.
+ */
+static void loteQRReflete(loteFatia Q, int m, int n, int k, loteFatia w)
+{
+    for (int j = k + 1; j < n; j++)
+    {
+        loteVetor sr = vConst(0.0f), si = vConst(0.0f);
+
+        //! s = v^H q_j
+        for (int r = k; r < m; r++)
+        {
+            const loteVetor vr = fRe(Q, r * n + k), vi = fIm(Q, r * n + k);
+            const loteVetor qr = fRe(Q, r * n + j), qi = fIm(Q, r * n + j);
+
+            sr = vMulSoma(vi, qi, vMulSoma(vr, qr, sr));
+            si = vMulSub(vi, qr, vMulSoma(vr, qi, si));
+        }
+
+        fEscreve(w, 0, sr, si);
+
+        for (int r = k; r < m; r++)
+        {
+            loteVetor re = fRe(Q, r * n + j), im = fIm(Q, r * n + j);
+
+            loteCMulSub(&re, &im, fRe(Q, r * n + k), fIm(Q, r * n + k), sr, si);
+            fEscreve(Q, r * n + j, re, im);
+        }
+    }
+}
+
+/**
+ * @brief Householder QR of the m x n fatia Q (m >= n), same steps as matrixQREm; R is n x n.
+ */
+static void loteQRNucleo(loteFatia Q, loteFatia R, int m, int n, loteFatia w)
+{
+    const loteVetor um = vConst(1.0f), zero = vConst(0.0f);
+
+    for (int k = 0; k < n; k++)
+    {
+        loteVetor norma2 = zero;
+
+        for (int r = k; r < m; r++)
+        {
+            const loteVetor xr = fRe(Q, r * n + k), xi = fIm(Q, r * n + k);
+            norma2 = vMulSoma(xi, xi, vMulSoma(xr, xr, norma2));
+        }
+
+        const loteVetor norma = vSqrt(norma2);
+        const loteVetor x0r = fRe(Q, k * n + k), x0i = fIm(Q, k * n + k);
+        const loteVetor modulo0 = vSqrt(vMulSoma(x0i, x0i, vMul(x0r, x0r)));
+
+        //! Phase of x0 (1 where x0 = 0); scale 0 where the column is null, so that v = 0 and H = I
+        const loteVetor temFase = vMaior(modulo0, zero);
+        const loteVetor divisor = vEscolhe(temFase, um, modulo0);
+        const loteVetor faseRe = vEscolhe(temFase, um, vDiv(x0r, divisor));
+        const loteVetor faseIm = vEscolhe(temFase, zero, vDiv(x0i, divisor));
+
+        const loteVetor util = vMaior(norma, zero);
+        const loteVetor produto = vEscolhe(util, um, vMul(norma, vSoma(norma, modulo0)));
+        const loteVetor escala = vEscolhe(util, zero, vDiv(um, vSqrt(produto)));
+
+        for (int j = 0; j < k; j++)
+        {
+            fEscreve(R, k * n + j, zero, zero);
+        }
+
+        fEscreve(R, k * n + k, vNeg(vMul(faseRe, norma)), vNeg(vMul(faseIm, norma)));
+        fEscreve(Q, k * n + k, vMul(vMulSoma(faseRe, norma, x0r), escala), vMul(vMulSoma(faseIm, norma, x0i), escala));
+
+        for (int r = k + 1; r < m; r++)
+        {
+            fEscreve(Q, r * n + k, vMul(fRe(Q, r * n + k), escala), vMul(fIm(Q, r * n + k), escala));
+        }
+
+        loteQRReflete(Q, m, n, k, w);
+
+        for (int j = k + 1; j < n; j++)
+        {
+            fEscreve(R, k * n + j, fRe(Q, k * n + j), fIm(Q, k * n + j));
+        }
+    }
+
+    //! Q = H_0 ... H_(n-1) [I; 0], from the last reflection to the first
+    for (int k = n - 1; k >= 0; k--)
+    {
+        loteQRReflete(Q, m, n, k, w);
+
+        //! Column k becomes e_k - v conj(v0)
+        const loteVetor v0r = fRe(Q, k * n + k), v0i = fIm(Q, k * n + k);
+
+        for (int r = k + 1; r < m; r++)
+        {
+            const loteVetor vr = fRe(Q, r * n + k), vi = fIm(Q, r * n + k);
+
+            //! -(vr + i vi)(v0r - i v0i)
+            fEscreve(Q, r * n + k, vNeg(vMulSoma(vi, v0i, vMul(vr, v0r))), vNeg(vMulSub(vr, v0i, vMul(vi, v0r))));
+        }
+
+        fEscreve(Q, k * n + k, vSub(um, vMulSoma(v0i, v0i, vMul(v0r, v0r))), zero);
+
+        for (int r = 0; r < k; r++)
+        {
+            fEscreve(Q, r * n + k, zero, zero);
+        }
+    }
+}
+
+/**
+ * @param[out] L The batch of lower triangular factors (may be matrix)
+ * @param[in] matrix The batch of Hermitian positive definite matrices
+ *
+ * @brief Lane-wise Cholesky factorization.
+ *
+ * @return 0 on success, -1 if the shapes or batch sizes do not agree.
+ */
+int loteCholeskyEm(complexMatrixLote L, complexMatrixLote matrix)
+{
+    if (!loteMesmoLote(L, matrix) || matrix.linhas != matrix.colunas ||
+        L.linhas != matrix.linhas || L.colunas != matrix.colunas)
+    {
+        return -1;
+    }
+
+    const int n = matrix.linhas;
+
+    for (int b0 = 0; b0 < loteLanes(matrix); b0 += LOTE_LANES)
+    {
+        const loteFatia F = loteFatiaDe(L, b0);
+
+        loteCopiaFatia(F, loteFatiaDe(matrix, b0), n * n);
+        loteCholeskyNucleo(F, n);
+    }
+
+    return 0;
+}
+
+/**
+ * @param[out] LU The batch of factors (may be matrix)
+ * @param[out] pivos The pivot rows, pivos[k * matrix.passo + b]
+ * @param[in] matrix The batch of square matrices
+ *
+ * @brief Lane-wise LU with partial pivoting.
+ *
+ * @return 0 on success, -1 if the shapes or batch sizes do not agree.
+ */
+int loteLUEm(complexMatrixLote LU, int *pivos, complexMatrixLote matrix)
+{
+    if (!loteMesmoLote(LU, matrix) || matrix.linhas != matrix.colunas ||
+        LU.linhas != matrix.linhas || LU.colunas != matrix.colunas)
+    {
+        return -1;
+    }
+
+    const int n = matrix.linhas;
+    loteFatia P = loteFatiaTrabalho(n);
+
+    for (int b0 = 0; b0 < loteLanes(matrix); b0 += LOTE_LANES)
+    {
+        const loteFatia F = loteFatiaDe(LU, b0);
+
+        loteCopiaFatia(F, loteFatiaDe(matrix, b0), n * n);
+        loteLUNucleo(F, n, P);
+
+        for (int k = 0; k < n; k++)
+        {
+            for (int l = 0; l < LOTE_LANES; l++)
+            {
+                pivos[(size_t)k * matrix.passo + b0 + l] = (int)P.Re[(size_t)k * P.passo + l];
+            }
+        }
+    }
+
+    matrixAlignedFree(P.Re);
+
+    return 0;
+}
+
+/**
+ * @param[out] X The batch of solutions (may be B)
+ * @param[in] LU The factors of loteLUEm
+ * @param[in] pivos The pivot rows of loteLUEm
+ * @param[in] B The batch of right-hand sides
+ *
+ * @brief Lane-wise solution of A X = B from the LU factors.
+ *
+ * @return 0 on success, -1 if the shapes or batch sizes do not agree.
+ */
+int loteLUSolveEm(complexMatrixLote X, complexMatrixLote LU, const int *pivos, complexMatrixLote B)
+{
+    const int n = LU.linhas;
+
+    if (!loteMesmoLote(X, LU) || !loteMesmoLote(B, LU) || LU.colunas != n ||
+        B.linhas != n || X.linhas != n || X.colunas != B.colunas)
+    {
+        return -1;
+    }
+
+    const int nrhs = B.colunas;
+    loteFatia P = loteFatiaTrabalho(n);
+
+    for (int b0 = 0; b0 < loteLanes(LU); b0 += LOTE_LANES)
+    {
+        for (int k = 0; k < n; k++)
+        {
+            for (int l = 0; l < LOTE_LANES; l++)
+            {
+                P.Re[(size_t)k * P.passo + l] = (float)pivos[(size_t)k * LU.passo + b0 + l];
+            }
+        }
+
+        const loteFatia FX = loteFatiaDe(X, b0);
+
+        loteCopiaFatia(FX, loteFatiaDe(B, b0), n * nrhs);
+        loteLUSolveNucleo(loteFatiaDe(LU, b0), n, P, FX, nrhs);
+    }
+
+    matrixAlignedFree(P.Re);
+
+    return 0;
+}
+
+/**
+ * @param[out] X The batch of solutions (may be B)
+ * @param[in] L The factors of loteCholeskyEm
+ * @param[in] B The batch of right-hand sides
+ *
+ * @brief Lane-wise solution of L L^H X = B.
+ *
+ * @return 0 on success, -1 if the shapes or batch sizes do not agree.
+ */
+int loteCholeskySolveEm(complexMatrixLote X, complexMatrixLote L, complexMatrixLote B)
+{
+    const int n = L.linhas;
+
+    if (!loteMesmoLote(X, L) || !loteMesmoLote(B, L) || L.colunas != n ||
+        B.linhas != n || X.linhas != n || X.colunas != B.colunas)
+    {
+        return -1;
+    }
+
+    for (int b0 = 0; b0 < loteLanes(L); b0 += LOTE_LANES)
+    {
+        const loteFatia FX = loteFatiaDe(X, b0);
+
+        loteCopiaFatia(FX, loteFatiaDe(B, b0), n * B.colunas);
+        loteCholeskySolveNucleo(loteFatiaDe(L, b0), n, FX, B.colunas);
+    }
+
+    return 0;
+}
+
+/**
+ * @param[out] Q The batch of m x n factors with orthonormal columns
+ * @param[out] R The batch of n x n upper triangular factors
+ * @param[in] matrix The batch of m x n matrices (m >= n)
+ *
+ * @brief Lane-wise Householder QR.
+ *
+ * @return 0 on success, -1 if the shapes or batch sizes do not agree or m < n.
+ */
+int loteQREm(complexMatrixLote Q, complexMatrixLote R, complexMatrixLote matrix)
+{
+    const int m = matrix.linhas, n = matrix.colunas;
+
+    if (!loteMesmoLote(Q, matrix) || !loteMesmoLote(R, matrix) || m < n ||
+        Q.linhas != m || Q.colunas != n || R.linhas != n || R.colunas != n)
+    {
+        return -1;
+    }
+
+    loteFatia w = loteFatiaTrabalho(1);
+
+    for (int b0 = 0; b0 < loteLanes(matrix); b0 += LOTE_LANES)
+    {
+        const loteFatia FQ = loteFatiaDe(Q, b0);
+
+        loteCopiaFatia(FQ, loteFatiaDe(matrix, b0), m * n);
+        loteQRNucleo(FQ, loteFatiaDe(R, b0), m, n, w);
+    }
+
+    matrixAlignedFree(w.Re);
+
+    return 0;
+}
+
+/**
+ * @param[out] X The batch of solutions (may be B)
+ * @param[in] A The batch of square matrices
+ * @param[in] B The batch of right-hand sides
+ *
+ * @brief Lane-wise LU of A in a work buffer, then the solution in place on X.
+ *
+ * @return 0 on success, -1 if the shapes or batch sizes do not agree.
+ */
+int loteSolveEm(complexMatrixLote X, complexMatrixLote A, complexMatrixLote B)
+{
+    const int n = A.linhas;
+
+    if (!loteMesmoLote(X, A) || !loteMesmoLote(B, A) || A.colunas != n ||
+        B.linhas != n || X.linhas != n || X.colunas != B.colunas)
+    {
+        return -1;
+    }
+
+    loteFatia W = loteFatiaTrabalho(n * n);
+    loteFatia P = loteFatiaTrabalho(n);
+
+    for (int b0 = 0; b0 < loteLanes(A); b0 += LOTE_LANES)
+    {
+        const loteFatia FX = loteFatiaDe(X, b0);
+
+        loteCopiaFatia(W, loteFatiaDe(A, b0), n * n);
+        loteLUNucleo(W, n, P);
+        loteCopiaFatia(FX, loteFatiaDe(B, b0), n * B.colunas);
+        loteLUSolveNucleo(W, n, P, FX, B.colunas);
+    }
+
+    matrixAlignedFree(W.Re);
+    matrixAlignedFree(P.Re);
+
+    return 0;
+}
+
+/**
+ * @param[out] W The batch of MMSE filters (n x m)
+ * @param[in] H The batch of channels (m x n)
+ * @param[in] sigma2 The noise variance
+ *
+ * @brief Lane-wise W = (H^H H + sigma2 I)^-1 H^H: Gram matrix and Cholesky in a work buffer, then the
+ * solution in place on W = H^H.
+ *
+ * @return 0 on success, -1 if the shapes or batch sizes do not agree.
+ */
+int loteMMSEEm(complexMatrixLote W, complexMatrixLote H, float sigma2)
+{
+    const int m = H.linhas, n = H.colunas;
+
+    if (!loteMesmoLote(W, H) || W.linhas != n || W.colunas != m)
+    {
+        return -1;
+    }
+
+    loteFatia G = loteFatiaTrabalho(n * n);
+
+    for (int b0 = 0; b0 < loteLanes(H); b0 += LOTE_LANES)
+    {
+        const loteFatia A = loteFatiaDe(H, b0);
+        const loteFatia FW = loteFatiaDe(W, b0);
+
+        //! Lower triangle of G = A^H A + sigma2 I (the only part the Cholesky core reads)
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j <= i; j++)
+            {
+                loteVetor gr = vConst(i == j ? sigma2 : 0.0f), gi = vConst(0.0f);
+
+                for (int r = 0; r < m; r++)
+                {
+                    const loteVetor ar = fRe(A, r * n + i), ai = fIm(A, r * n + i);
+                    const loteVetor br = fRe(A, r * n + j), bi = fIm(A, r * n + j);
+
+                    gr = vMulSoma(ai, bi, vMulSoma(ar, br, gr));
+                    gi = vMulSub(ai, br, vMulSoma(ar, bi, gi));
+                }
+
+                fEscreve(G, i * n + j, gr, gi);
+            }
+        }
+
+        loteCholeskyNucleo(G, n);
+
+        for (int i = 0; i < n; i++)
+        {
+            for (int r = 0; r < m; r++)
+            {
+                fEscreve(FW, i * m + r, fRe(A, r * n + i), vNeg(fIm(A, r * n + i)));
+            }
+        }
+
+        loteCholeskySolveNucleo(G, n, FW, m);
+    }
+
+    matrixAlignedFree(G.Re);
+
+    return 0;
+}
+
+/************************************* TESTS ***************************************/
+
+//! Value written to every lane of a destination before a kernel runs on a view of it
+#define TESTE_LOTE_SENTINELA 7.0f
+
+/**
+ * @brief Fills every lane of both planes of a batch, padding included, with the sentinel.
+ */
+static void testeLoteSentinela(complexMatrixLote matrix)
+{
+    const size_t floats = (size_t)matrix.linhas * matrix.colunas * matrix.passo;
+
+    for (size_t i = 0; i < floats; i++)
+    {
+        matrix.Re[i] = TESTE_LOTE_SENTINELA;
+        matrix.Im[i] = TESTE_LOTE_SENTINELA;
+    }
+}
+
+/**
+ * @brief Counts the matrices of a batch that are wrong after a kernel ran on the view [b0, b0 + quantidade):
+ * inside the view they must match the reference bit for bit, outside it they must still hold the sentinel.
+ */
+static int testeLoteErradas(complexMatrixLote destino, complexMatrixLote referencia, int b0, int quantidade)
+{
+    const int elementos = destino.linhas * destino.colunas;
+    int erradas = 0;
+
+    for (int b = 0; b < destino.lote; b++)
+    {
+        const int naView = (b >= b0) && (b < b0 + quantidade);
+        int errada = 0;
+
+        for (int e = 0; e < elementos; e++)
+        {
+            const size_t i = (size_t)e * destino.passo + b;
+
+            if (naView)
+            {
+                errada |= memcmp(destino.Re + i, referencia.Re + i, sizeof(float)) != 0;
+                errada |= memcmp(destino.Im + i, referencia.Im + i, sizeof(float)) != 0;
+            }
+            else
+            {
+                errada |= (destino.Re[i] != TESTE_LOTE_SENTINELA) || (destino.Im[i] != TESTE_LOTE_SENTINELA);
+            }
+        }
+
+        erradas += errada;
+    }
+
+    return erradas;
+}
+
+/**
+ * @brief Checks that the batched kernels run on a view write only the matrices of the view.
+ *
+ * A batch of 37 matrices has a view in the middle (8 .. 23) and a view at its end whose size is not a multiple
+ * of MATRIX_LOTE_LANES (32 .. 36). Each kernel runs on the views of a destination filled with a sentinel; the
+ * matrices of the view must equal those of the same kernel run on the whole batch, and every other matrix must
+ * keep the sentinel. The views that would let the last vector run into the matrices that follow must be rejected.
+ *
+ * @return The number of failed checks.
+ */
+int teste_lote(void)
+{
+    const int lote = 37;
+    const int views[][2] = {{8, 16}, {32, 5}};
+    int falhas = 0;
+
+    printf("\n  ============ Teste das views de lote ============ \n\n");
+
+    complexMatrixLote H = allocateComplexMatrixLote(lote, 4, 3);
+    complexMatrixLote G = allocateComplexMatrixLote(lote, 3, 4);
+    complexMatrixLote Q = allocateComplexMatrixLote(lote, 4, 4);
+    complexMatrixLote soma = allocateComplexMatrixLote(lote, 4, 3);
+    complexMatrixLote produto = allocateComplexMatrixLote(lote, 4, 4);
+    complexMatrixLote hermitiana = allocateComplexMatrixLote(lote, 3, 4);
+    complexMatrixLote inversa = allocateComplexMatrixLote(lote, 4, 4);
+    complexMatrixLote destino43 = allocateComplexMatrixLote(lote, 4, 3);
+    complexMatrixLote destino44 = allocateComplexMatrixLote(lote, 4, 4);
+    complexMatrixLote destino34 = allocateComplexMatrixLote(lote, 3, 4);
+
+    {
+        complexMatrix h = allocateComplexMatrix(4, 3);
+        complexMatrix g = allocateComplexMatrix(3, 4);
+        complexMatrix q = allocateComplexMatrix(4, 4);
+
+        for (int b = 0; b < lote; b++)
+        {
+            testePreenche(h, 10 + 3 * (unsigned)b);
+            testePreenche(g, 11 + 3 * (unsigned)b);
+            testePreenche(q, 12 + 3 * (unsigned)b);
+            loteCarregaMatrix(H, b, h);
+            loteCarregaMatrix(G, b, g);
+            loteCarregaMatrix(Q, b, q);
+        }
+
+        freeComplexMatrix(h);
+        freeComplexMatrix(g);
+        freeComplexMatrix(q);
+    }
+
+    loteSomaEm(soma, H, H);
+    loteProdutoEm(produto, H, G);
+    loteHermitianaEm(hermitiana, H);
+    loteInversaEm(inversa, Q);
+
+    for (int v = 0; v < 2; v++)
+    {
+        const int b0 = views[v][0], quantidade = views[v][1];
+        const complexMatrixLote h = loteView(H, b0, quantidade);
+        const complexMatrixLote g = loteView(G, b0, quantidade);
+        const complexMatrixLote q = loteView(Q, b0, quantidade);
+        char nome[64];
+        int status, erradas;
+
+        testeLoteSentinela(destino43);
+        status = loteSomaEm(loteView(destino43, b0, quantidade), h, h);
+        erradas = testeLoteErradas(destino43, soma, b0, quantidade);
+        snprintf(nome, sizeof(nome), "loteSomaEm  view [%d, %d)", b0, b0 + quantidade);
+        falhas += testeConfere(nome, status == 0 && erradas == 0, "%d matrizes erradas", erradas);
+
+        testeLoteSentinela(destino44);
+        status = loteProdutoEm(loteView(destino44, b0, quantidade), h, g);
+        erradas = testeLoteErradas(destino44, produto, b0, quantidade);
+        snprintf(nome, sizeof(nome), "loteProdutoEm  view [%d, %d)", b0, b0 + quantidade);
+        falhas += testeConfere(nome, status == 0 && erradas == 0, "%d matrizes erradas", erradas);
+
+        testeLoteSentinela(destino34);
+        status = loteHermitianaEm(loteView(destino34, b0, quantidade), h);
+        erradas = testeLoteErradas(destino34, hermitiana, b0, quantidade);
+        snprintf(nome, sizeof(nome), "loteHermitianaEm  view [%d, %d)", b0, b0 + quantidade);
+        falhas += testeConfere(nome, status == 0 && erradas == 0, "%d matrizes erradas", erradas);
+
+        testeLoteSentinela(destino44);
+        status = loteInversaEm(loteView(destino44, b0, quantidade), q);
+        erradas = testeLoteErradas(destino44, inversa, b0, quantidade);
+        snprintf(nome, sizeof(nome), "loteInversaEm  view [%d, %d)", b0, b0 + quantidade);
+        falhas += testeConfere(nome, status == 0 && erradas == 0, "%d matrizes erradas", erradas);
+    }
+
+    falhas += testeConfere("loteView  tamanho parcial no meio recusada", !loteViewValida(H, 8, 5), NULL);
+    falhas += testeConfere("loteView  b0 fora do vetor recusada", !loteViewValida(H, 4, 8), NULL);
+    falhas += testeConfere("loteView  parcial no fim aceita", loteViewValida(H, 32, 5), NULL);
+
+    freeComplexMatrixLote(H);
+    freeComplexMatrixLote(G);
+    freeComplexMatrixLote(Q);
+    freeComplexMatrixLote(soma);
+    freeComplexMatrixLote(produto);
+    freeComplexMatrixLote(hermitiana);
+    freeComplexMatrixLote(inversa);
+    freeComplexMatrixLote(destino43);
+    freeComplexMatrixLote(destino44);
+    freeComplexMatrixLote(destino34);
+
+    return falhas;
+}
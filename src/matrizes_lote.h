@@ -0,0 +1,197 @@
+/**
+ * @file matrizes_lote.h
+ * @brief Header file for batches of small complex matrices (one matrix per SIMD lane).
+ */
+
+#ifndef MATRIZES_LOTE_H
+#define MATRIZES_LOTE_H
+#include "matrizes.h"
+
+/*!
+* @brief Batch of 'lote' complex matrices of the same shape (for example one channel per subcarrier).
+*
+* The batch index is the innermost one: element (i, j) of matrix b is Re[(i * colunas + j) * passo + b]
+* + i Im[(i * colunas + j) * passo + b]. Each element is therefore a contiguous vector across the batch,
+* and the kernels run the scalar algorithm of a single matrix with one SIMD lane per matrix, so even a
+* 4x3 channel keeps the whole vector unit busy. 'passo' is 'lote' rounded up to a cache line of floats
+* (views keep the 'passo' of their batch); the padding lanes are zero on allocation and carry no meaning.
+*/
+typedef struct
+{
+    int lote;            /*!< Number of matrices in the batch */
+    int linhas, colunas; /*!< Shape of every matrix of the batch */
+    int passo;           /*!< Floats between the vectors of two consecutive elements ('lote' rounded up to 16) */
+    float *Re;           /*!< Real parts, element-major and batch-minor */
+    float *Im;           /*!< Imaginary parts, same layout as Re */
+    void *bloco;         /*!< Block owned by the batch (NULL for views) */
+} complexMatrixLote;
+
+/*!
+* @brief Number of matrices processed together by the batched kernels (one AVX register of floats).
+*
+* Sub-batches taken with loteView must start at a multiple of this value.
+*/
+#define MATRIX_LOTE_LANES 8
+
+///****************************************** ALLOCATION AND CONVERSION ****************************************************/
+
+/**
+ * @brief Allocates a zeroed batch of complex matrices (both planes in a single aligned block).
+ *
+ * @param lote Number of matrices.
+ * @param linhas Number of rows of each matrix.
+ * @param colunas Number of columns of each matrix.
+ * @return The allocated complexMatrixLote.
+ */
+complexMatrixLote allocateComplexMatrixLote(int lote, int linhas, int colunas);
+
+/**
+ * @brief Frees the memory owned by a batch.
+ *
+ * @param matrix The complexMatrixLote object to be freed.
+ */
+void freeComplexMatrixLote(complexMatrixLote matrix);
+
+/**
+ * @brief Returns a view of the matrices b0 .. b0 + quantidade - 1 of a batch (nothing is copied).
+ *
+ * The view shares the planes and the 'passo' of the batch, so the batched operations can work on a
+ * slice (for example one slice per thread). The kernels work on whole vectors of MATRIX_LOTE_LANES
+ * matrices, so b0 must be a multiple of MATRIX_LOTE_LANES and so must quantidade, unless the view ends at
+ * the last matrix of the batch (its last vector then runs into the padding lanes, which belong to the
+ * batch). Otherwise, or if the range does not fit in the batch, an error message is printed and the
+ * program terminates.
+ *
+ * @param matrix The batch.
+ * @param b0 Index of the first matrix of the view.
+ * @param quantidade Number of matrices of the view.
+ * @return The view, which owns nothing.
+ */
+complexMatrixLote loteView(complexMatrixLote matrix, int b0, int quantidade);
+
+/**
+ * @brief Copies a complexMatrix into position b of a batch.
+ *
+ * @param destino The batch.
+ * @param b Index of the matrix in the batch.
+ * @param origem The complexMatrix (same shape as the batch).
+ * @return 0 on success, -1 if the dimensions or the index do not agree.
+ */
+int loteCarregaMatrix(complexMatrixLote destino, int b, complexMatrix origem);
+
+/**
+ * @brief Copies the matrix at position b of a batch into a complexMatrix.
+ *
+ * @param destino The complexMatrix (same shape as the batch).
+ * @param origem The batch.
+ * @param b Index of the matrix in the batch.
+ * @return 0 on success, -1 if the dimensions or the index do not agree.
+ */
+int loteExtraiMatrix(complexMatrix destino, complexMatrixLote origem, int b);
+
+///****************************************** BATCHED OPERATIONS ****************************************************/
+///
+///-----> Same conventions as the *Em functions of matrizes.h, applied to every matrix of the batch:
+///-----> the result goes to 'destino', 0 is returned on success and -1 when the shapes or batch sizes do not agree.
+///
+
+/**
+ * @brief Writes matrix1[b] + matrix2[b] into destino[b] (destino may be an operand).
+ */
+int loteSomaEm(complexMatrixLote destino, complexMatrixLote matrix1, complexMatrixLote matrix2);
+
+/**
+ * @brief Writes the product matrix1[b] * matrix2[b] into destino[b]; destino must not overlap the operands.
+ */
+int loteProdutoEm(complexMatrixLote destino, complexMatrixLote matrix1, complexMatrixLote matrix2);
+
+/**
+ * @brief Writes the conjugate transpose of matrix[b] into destino[b]; destino must not overlap matrix.
+ */
+int loteHermitianaEm(complexMatrixLote destino, complexMatrixLote matrix);
+
+/**
+ * @brief Writes the Gram matrix matrix[b]^H * matrix[b] into destino[b]; destino must not overlap matrix.
+ */
+int loteGramEm(complexMatrixLote destino, complexMatrixLote matrix);
+
+/**
+ * @brief Writes the inverse of every square matrix[b] into destino[b] (Gauss-Jordan with partial pivoting).
+ *
+ * Each lane chooses its own pivots. A singular matrix gives non-finite values in its own slot only.
+ * destino may be matrix.
+ */
+int loteInversaEm(complexMatrixLote destino, complexMatrixLote matrix);
+
+/**
+ * @brief Computes the thin SVD matrix[b] = U[b] diag(S[b]) Vh[b] of every matrix of the batch.
+ *
+ * Same algorithm and conventions as calc_svd, run lane-wise.
+ *
+ * @param U The batch of m x k left singular vectors, k = min(m, n).
+ * @param S Array of k * matrix.passo floats; singular value i of matrix b goes to S[i * matrix.passo + b].
+ * @param Vh The batch of k x n matrices V^H.
+ * @param matrix The batch of m x n matrices to be decomposed (left untouched).
+ * @return 0 on success, -1 if the shapes or batch sizes do not agree.
+ */
+int loteSVDEm(complexMatrixLote U, float *S, complexMatrixLote Vh, complexMatrixLote matrix);
+
+///****************************************** BATCHED FACTORIZATIONS AND SOLVERS ****************************************************/
+///
+///-----> Lane-wise versions of matrizes_fatoracao.h. The -1 return only reports shapes or batch sizes
+///-----> that do not agree: a lane that breaks down (singular, not positive definite) gets non-finite
+///-----> values in its own slot, as in loteInversaEm.
+///
+
+/**
+ * @brief Cholesky factorization matrix[b] = L[b] L[b]^H (lower triangle read); L may be matrix.
+ */
+int loteCholeskyEm(complexMatrixLote L, complexMatrixLote matrix);
+
+/**
+ * @brief LU factorization with partial pivoting of every matrix[b], as matrixLUEm; LU may be matrix.
+ *
+ * @param LU The batch that receives the factors.
+ * @param pivos Array of n * matrix.passo ints; pivot row k of matrix b goes to pivos[k * matrix.passo + b].
+ * @param matrix The batch of n x n matrices.
+ * @return 0 on success, -1 if the shapes or batch sizes do not agree.
+ */
+int loteLUEm(complexMatrixLote LU, int *pivos, complexMatrixLote matrix);
+
+/**
+ * @brief Solves A[b] X[b] = B[b] from the factors of loteLUEm; X may be B.
+ */
+int loteLUSolveEm(complexMatrixLote X, complexMatrixLote LU, const int *pivos, complexMatrixLote B);
+
+/**
+ * @brief Solves L[b] L[b]^H X[b] = B[b] from the factors of loteCholeskyEm; X may be B.
+ */
+int loteCholeskySolveEm(complexMatrixLote X, complexMatrixLote L, complexMatrixLote B);
+
+/**
+ * @brief Thin Householder QR matrix[b] = Q[b] R[b] for m >= n; Q must not overlap matrix.
+ */
+int loteQREm(complexMatrixLote Q, complexMatrixLote R, complexMatrixLote matrix);
+
+/**
+ * @brief Solves the square systems A[b] X[b] = B[b] (LU with partial pivoting); X may be B.
+ */
+int loteSolveEm(complexMatrixLote X, complexMatrixLote A, complexMatrixLote B);
+
+/**
+ * @brief MMSE filters W[b] = (H[b]^H H[b] + sigma2 I)^-1 H[b]^H (n x m), through Cholesky.
+ */
+int loteMMSEEm(complexMatrixLote W, complexMatrixLote H, float sigma2);
+
+///****************************************** TESTS ****************************************************/
+
+/**
+ * @brief Checks that the batched kernels run on a loteView write only the matrices of the view, for a view
+ * in the middle of a batch and for a view of partial size at its end, and that loteView rejects the views
+ * whose last vector would overwrite the matrices that follow them.
+ *
+ * @return The number of failed checks.
+ */
+int teste_lote(void);
+
+#endif
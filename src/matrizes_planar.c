@@ -0,0 +1,542 @@
+/**
+ * @file matrizes_planar.c
+ * @brief Implementation file for complex matrices in planar (split-complex) layout.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+/// including the files where the structures are contained
+#include "matrizes_planar.h"
+#include "matrizes.h"
+
+/************************************* ALLOCATION AND CONVERSION ***************************************/
+
+/**
+ * @param[in] linhas Number of rows
+ * @param[in] colunas Number of columns
+ *
+ * @brief Allocates both planes of the matrix in a single aligned block.
+ *
+ * The leading dimension is rounded up to a multiple of 16 floats (64 bytes), so every row of both planes
+ * starts on a cache line. If the allocation fails, an error message is printed and the program terminates.
+ *
+ * @return The allocated complexMatrixPlanar.
+ */
+complexMatrixPlanar allocateComplexMatrixPlanar(int linhas, int colunas)
+{
+    complexMatrixPlanar matrix;
+    const int porLinha = MATRIX_ALINHAMENTO / (int)sizeof(float);
+
+    matrix.linhas = linhas;
+    matrix.colunas = colunas;
+    matrix.ld = (colunas + porLinha - 1) / porLinha * porLinha;
+
+    size_t bytesPlano = (size_t)linhas * matrix.ld * sizeof(float);
+    matrix.bloco = matrixAlignedAlloc(2 * bytesPlano);
+
+    if (matrix.bloco == NULL)
+    {
+        printf("Falha na alocacao de memoria\n");
+        exit(1);
+    }
+
+    matrix.Re = (float *)matrix.bloco;
+    matrix.Im = (float *)((char *)matrix.bloco + bytesPlano);
+
+    return matrix;
+}
+
+/**
+ * @brief Frees the block of a planar complex matrix.
+ */
+void freeComplexMatrixPlanar(complexMatrixPlanar matrix)
+{
+    matrixAlignedFree(matrix.bloco);
+}
+
+/**
+ * @param[out] destino The planar matrix
+ * @param[in] origem The interleaved matrix
+ *
+ * @brief Splits every row of origem into its real and imaginary planes.
+ *
+ * With AVX2, eight complex numbers are deinterleaved at a time with two shuffles and a lane permutation.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixParaPlanar(complexMatrixPlanar destino, complexMatrix origem)
+{
+    if (destino.linhas != origem.linhas || destino.colunas != origem.colunas)
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < origem.linhas; i++)
+    {
+        const complex *linha = matrixLinha(origem, i);
+        float *re = destino.Re + (size_t)i * destino.ld;
+        float *im = destino.Im + (size_t)i * destino.ld;
+        int j = 0;
+
+#if defined(__AVX2__) && defined(__FMA__)
+        for (; j + 8 <= origem.colunas; j += 8)
+        {
+            //! a = r0 i0 r1 i1 | r2 i2 r3 i3, b = r4 i4 r5 i5 | r6 i6 r7 i7
+            const __m256 a = _mm256_loadu_ps(&linha[j].Re);
+            const __m256 b = _mm256_loadu_ps(&linha[j + 4].Re);
+
+            //! Even slots give r0 r1 r4 r5 | r2 r3 r6 r7; the permutation puts them back in order
+            const __m256 pares = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m256 impares = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+
+            _mm256_storeu_ps(re + j, _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(pares), _MM_SHUFFLE(3, 1, 2, 0))));
+            _mm256_storeu_ps(im + j, _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(impares), _MM_SHUFFLE(3, 1, 2, 0))));
+        }
+#endif
+        for (; j < origem.colunas; j++)
+        {
+            re[j] = linha[j].Re;
+            im[j] = linha[j].Im;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @param[out] destino The interleaved matrix
+ * @param[in] origem The planar matrix
+ *
+ * @brief Interleaves the real and imaginary planes of every row of origem.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int planarParaMatrix(complexMatrix destino, complexMatrixPlanar origem)
+{
+    if (destino.linhas != origem.linhas || destino.colunas != origem.colunas)
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < origem.linhas; i++)
+    {
+        complex *linha = matrixLinha(destino, i);
+        const float *re = origem.Re + (size_t)i * origem.ld;
+        const float *im = origem.Im + (size_t)i * origem.ld;
+        int j = 0;
+
+#if defined(__AVX2__) && defined(__FMA__)
+        for (; j + 8 <= origem.colunas; j += 8)
+        {
+            const __m256 r = _mm256_loadu_ps(re + j);
+            const __m256 m = _mm256_loadu_ps(im + j);
+
+            //! baixo = r0 i0 r1 i1 | r4 i4 r5 i5, alto = r2 i2 r3 i3 | r6 i6 r7 i7
+            const __m256 baixo = _mm256_unpacklo_ps(r, m);
+            const __m256 alto = _mm256_unpackhi_ps(r, m);
+
+            _mm256_storeu_ps(&linha[j].Re, _mm256_permute2f128_ps(baixo, alto, 0x20));
+            _mm256_storeu_ps(&linha[j + 4].Re, _mm256_permute2f128_ps(baixo, alto, 0x31));
+        }
+#endif
+        for (; j < origem.colunas; j++)
+        {
+            linha[j].Re = re[j];
+            linha[j].Im = im[j];
+        }
+    }
+
+    return 0;
+}
+
+/************************************* ELEMENT-WISE OPERATIONS ***************************************/
+/*
+ * With the parts in separate planes, every element-wise operation is plain vertical arithmetic over
+ * contiguous floats, which the compiler turns into full-width SIMD code without any shuffle.
+ */
+
+/**
+ * @brief Checks that two planar matrices have the same number of rows and columns.
+ */
+static int planarMesmaForma(complexMatrixPlanar a, complexMatrixPlanar b)
+{
+    return a.linhas == b.linhas && a.colunas == b.colunas;
+}
+
+/**
+ * @brief Writes matrix1 + matrix2 into destino.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int planarSomaEm(complexMatrixPlanar destino, complexMatrixPlanar matrix1, complexMatrixPlanar matrix2)
+{
+    if (!planarMesmaForma(destino, matrix1) || !planarMesmaForma(matrix1, matrix2))
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < destino.linhas; i++)
+    {
+        const size_t d = (size_t)i * destino.ld, a = (size_t)i * matrix1.ld, b = (size_t)i * matrix2.ld;
+
+        for (int j = 0; j < destino.colunas; j++)
+        {
+            destino.Re[d + j] = matrix1.Re[a + j] + matrix2.Re[b + j];
+            destino.Im[d + j] = matrix1.Im[a + j] + matrix2.Im[b + j];
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Writes matrix1 - matrix2 into destino.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int planarSubtracaoEm(complexMatrixPlanar destino, complexMatrixPlanar matrix1, complexMatrixPlanar matrix2)
+{
+    if (!planarMesmaForma(destino, matrix1) || !planarMesmaForma(matrix1, matrix2))
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < destino.linhas; i++)
+    {
+        const size_t d = (size_t)i * destino.ld, a = (size_t)i * matrix1.ld, b = (size_t)i * matrix2.ld;
+
+        for (int j = 0; j < destino.colunas; j++)
+        {
+            destino.Re[d + j] = matrix1.Re[a + j] - matrix2.Re[b + j];
+            destino.Im[d + j] = matrix1.Im[a + j] - matrix2.Im[b + j];
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Writes num * matrix into destino.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int planar_produtoEscalarEm(complexMatrixPlanar destino, complexMatrixPlanar matrix, float num)
+{
+    if (!planarMesmaForma(destino, matrix))
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < destino.linhas; i++)
+    {
+        const size_t d = (size_t)i * destino.ld, a = (size_t)i * matrix.ld;
+
+        for (int j = 0; j < destino.colunas; j++)
+        {
+            destino.Re[d + j] = matrix.Re[a + j] * num;
+            destino.Im[d + j] = matrix.Im[a + j] * num;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Writes the conjugate of matrix into destino.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int planarConjugadaEm(complexMatrixPlanar destino, complexMatrixPlanar matrix)
+{
+    if (!planarMesmaForma(destino, matrix))
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < destino.linhas; i++)
+    {
+        const size_t d = (size_t)i * destino.ld, a = (size_t)i * matrix.ld;
+
+        for (int j = 0; j < destino.colunas; j++)
+        {
+            destino.Re[d + j] = matrix.Re[a + j];
+            destino.Im[d + j] = -matrix.Im[a + j];
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Writes the element-wise complex product of matrix1 and matrix2 into destino.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int planarProdutoElementoEm(complexMatrixPlanar destino, complexMatrixPlanar matrix1, complexMatrixPlanar matrix2)
+{
+    if (!planarMesmaForma(destino, matrix1) || !planarMesmaForma(matrix1, matrix2))
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < destino.linhas; i++)
+    {
+        const size_t d = (size_t)i * destino.ld, a = (size_t)i * matrix1.ld, b = (size_t)i * matrix2.ld;
+
+        for (int j = 0; j < destino.colunas; j++)
+        {
+            const float ar = matrix1.Re[a + j], ai = matrix1.Im[a + j];
+            const float br = matrix2.Re[b + j], bi = matrix2.Im[b + j];
+
+            destino.Re[d + j] = ar * br - ai * bi;
+            destino.Im[d + j] = ar * bi + ai * br;
+        }
+    }
+
+    return 0;
+}
+
+/************************************* MATRIX MULTIPLICATION (GEMM) ***************************************/
+
+/*
+ * Blocking parameters of the planar GEMM. A KC x NC block of B is packed into panels of PLANAR_NR columns
+ * (eight real parts followed by eight imaginary parts per k), so the micro-kernel reads it sequentially
+ * instead of jumping one leading dimension per k, and the block is reused by every 4-row strip of A.
+ */
+#define PLANAR_MR 4    /*!< Rows of C computed by the micro-kernel */
+#define PLANAR_NR 8    /*!< Columns of C computed by the micro-kernel (one __m256 per plane) */
+#define PLANAR_KC 256  /*!< Depth of a block */
+#define PLANAR_NC 128  /*!< Columns of a block */
+
+#if defined(__AVX2__) && defined(__FMA__)
+/**
+ * @brief AVX2/FMA micro-kernel: C[4][8] += A(4 x kc) * B(kc x 8), all in planar layout.
+ *
+ * For every k, the parts of A are broadcast and multiplied by eight real and eight imaginary parts of B:
+ * cr += ar*br - ai*bi and ci += ar*bi + ai*br, four FMAs for eight complex products and no shuffle.
+ */
+static void planarMicroKernel(int kc, const float *const *ar, const float *const *ai,
+                              const float *pacote, float *const *cr, float *const *ci)
+{
+    __m256 r0 = _mm256_loadu_ps(cr[0]), m0 = _mm256_loadu_ps(ci[0]);
+    __m256 r1 = _mm256_loadu_ps(cr[1]), m1 = _mm256_loadu_ps(ci[1]);
+    __m256 r2 = _mm256_loadu_ps(cr[2]), m2 = _mm256_loadu_ps(ci[2]);
+    __m256 r3 = _mm256_loadu_ps(cr[3]), m3 = _mm256_loadu_ps(ci[3]);
+
+    for (int k = 0; k < kc; k++)
+    {
+        const __m256 vbr = _mm256_load_ps(pacote);
+        const __m256 vbi = _mm256_load_ps(pacote + PLANAR_NR);
+        __m256 xr, xi;
+
+        xr = _mm256_broadcast_ss(ar[0] + k);
+        xi = _mm256_broadcast_ss(ai[0] + k);
+        r0 = _mm256_fnmadd_ps(xi, vbi, _mm256_fmadd_ps(xr, vbr, r0));
+        m0 = _mm256_fmadd_ps(xi, vbr, _mm256_fmadd_ps(xr, vbi, m0));
+
+        xr = _mm256_broadcast_ss(ar[1] + k);
+        xi = _mm256_broadcast_ss(ai[1] + k);
+        r1 = _mm256_fnmadd_ps(xi, vbi, _mm256_fmadd_ps(xr, vbr, r1));
+        m1 = _mm256_fmadd_ps(xi, vbr, _mm256_fmadd_ps(xr, vbi, m1));
+
+        xr = _mm256_broadcast_ss(ar[2] + k);
+        xi = _mm256_broadcast_ss(ai[2] + k);
+        r2 = _mm256_fnmadd_ps(xi, vbi, _mm256_fmadd_ps(xr, vbr, r2));
+        m2 = _mm256_fmadd_ps(xi, vbr, _mm256_fmadd_ps(xr, vbi, m2));
+
+        xr = _mm256_broadcast_ss(ar[3] + k);
+        xi = _mm256_broadcast_ss(ai[3] + k);
+        r3 = _mm256_fnmadd_ps(xi, vbi, _mm256_fmadd_ps(xr, vbr, r3));
+        m3 = _mm256_fmadd_ps(xi, vbr, _mm256_fmadd_ps(xr, vbi, m3));
+
+        pacote += 2 * PLANAR_NR;
+    }
+
+    _mm256_storeu_ps(cr[0], r0); _mm256_storeu_ps(ci[0], m0);
+    _mm256_storeu_ps(cr[1], r1); _mm256_storeu_ps(ci[1], m1);
+    _mm256_storeu_ps(cr[2], r2); _mm256_storeu_ps(ci[2], m2);
+    _mm256_storeu_ps(cr[3], r3); _mm256_storeu_ps(ci[3], m3);
+}
+#else
+/**
+ * @brief Portable micro-kernel: C[4][8] += A(4 x kc) * B(kc x 8), all in planar layout.
+ */
+static void planarMicroKernel(int kc, const float *const *ar, const float *const *ai,
+                              const float *pacote, float *const *cr, float *const *ci)
+{
+    for (int r = 0; r < PLANAR_MR; r++)
+    {
+        for (int k = 0; k < kc; k++)
+        {
+            const float xr = ar[r][k], xi = ai[r][k];
+            const float *vbr = pacote + (size_t)k * 2 * PLANAR_NR;
+            const float *vbi = vbr + PLANAR_NR;
+
+            for (int j = 0; j < PLANAR_NR; j++)
+            {
+                cr[r][j] += xr * vbr[j] - xi * vbi[j];
+                ci[r][j] += xr * vbi[j] + xi * vbr[j];
+            }
+        }
+    }
+}
+#endif
+
+//! Key that owns the packing buffer of each thread; its destructor frees the buffer when the thread exits
+static pthread_key_t planarChavePacote;
+static pthread_once_t planarChaveCriada = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Creates planarChavePacote (called once, through pthread_once).
+ */
+static void planarCriaChave(void)
+{
+    if (pthread_key_create(&planarChavePacote, matrixAlignedFree) != 0)
+    {
+        printf("Falha na criacao da chave de thread\n");
+        exit(1);
+    }
+}
+
+/**
+ * @brief Packs a kc x nc block of B (nc a multiple of PLANAR_NR) into consecutive panels of PLANAR_NR columns.
+ */
+static void planarEmpacotaB(float *pacote, complexMatrixPlanar matrix2, int k0, int j0, int kc, int nc)
+{
+    for (int jr = 0; jr < nc; jr += PLANAR_NR)
+    {
+        for (int k = 0; k < kc; k++)
+        {
+            const float *br = matrix2.Re + (size_t)(k0 + k) * matrix2.ld + j0 + jr;
+            const float *bi = matrix2.Im + (size_t)(k0 + k) * matrix2.ld + j0 + jr;
+
+            for (int j = 0; j < PLANAR_NR; j++)
+            {
+                pacote[j] = br[j];
+                pacote[PLANAR_NR + j] = bi[j];
+            }
+            pacote += 2 * PLANAR_NR;
+        }
+    }
+}
+
+/**
+ * @param[out] destino The planar product matrix (m x n)
+ * @param[in] matrix1 The first planar matrix (m x k)
+ * @param[in] matrix2 The second planar matrix (k x n)
+ *
+ * @brief Cache-blocked complex product in planar layout.
+ *
+ * Full 4 x 8 tiles go through the micro-kernel. Missing rows of the last strip read a row of zeros and
+ * write to a scratch row, and the last columns (n not a multiple of 8) are handled by a scalar loop.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int planarProdutoEm(complexMatrixPlanar destino, complexMatrixPlanar matrix1, complexMatrixPlanar matrix2)
+{
+    const int m = matrix1.linhas;
+    const int n = matrix2.colunas;
+    const int kTotal = matrix1.colunas;
+
+    if (kTotal != matrix2.linhas || destino.linhas != m || destino.colunas != n)
+    {
+        return -1;
+    }
+
+    //! Row of zeros read in place of the missing rows of A, and scratch row written in place of the missing rows of C
+    static const float zeros[PLANAR_KC];
+    float descarte[2][PLANAR_NR] = {{0.0f}};
+
+    //! Packing buffer, allocated on the first product of each thread, reused, and freed when the thread exits
+    static _Thread_local float *pacote = NULL;
+    if (pacote == NULL)
+    {
+        pthread_once(&planarChaveCriada, planarCriaChave);
+        pacote = (float *)matrixAlignedAlloc((size_t)PLANAR_KC * PLANAR_NC * 2 * sizeof(float));
+        if (pacote == NULL || pthread_setspecific(planarChavePacote, pacote) != 0)
+        {
+            printf("Falha na alocacao de memoria\n");
+            exit(1);
+        }
+    }
+
+    const int nCheio = n / PLANAR_NR * PLANAR_NR;
+
+    for (int i = 0; i < m; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            destino.Re[(size_t)i * destino.ld + j] = 0.0f;
+            destino.Im[(size_t)i * destino.ld + j] = 0.0f;
+        }
+    }
+
+    for (int jc = 0; jc < nCheio; jc += PLANAR_NC)
+    {
+        const int nc = (nCheio - jc < PLANAR_NC) ? nCheio - jc : PLANAR_NC;
+
+        for (int pc = 0; pc < kTotal; pc += PLANAR_KC)
+        {
+            const int kc = (kTotal - pc < PLANAR_KC) ? kTotal - pc : PLANAR_KC;
+
+            planarEmpacotaB(pacote, matrix2, pc, jc, kc, nc);
+
+            for (int ic = 0; ic < m; ic += PLANAR_MR)
+            {
+                const float *ar[PLANAR_MR], *ai[PLANAR_MR];
+                int valida[PLANAR_MR];
+
+                for (int r = 0; r < PLANAR_MR; r++)
+                {
+                    valida[r] = ic + r < m;
+                    ar[r] = valida[r] ? matrix1.Re + (size_t)(ic + r) * matrix1.ld + pc : zeros;
+                    ai[r] = valida[r] ? matrix1.Im + (size_t)(ic + r) * matrix1.ld + pc : zeros;
+                }
+
+                for (int jr = jc; jr < jc + nc; jr += PLANAR_NR)
+                {
+                    float *cr[PLANAR_MR], *ci[PLANAR_MR];
+
+                    for (int r = 0; r < PLANAR_MR; r++)
+                    {
+                        cr[r] = valida[r] ? destino.Re + (size_t)(ic + r) * destino.ld + jr : descarte[0];
+                        ci[r] = valida[r] ? destino.Im + (size_t)(ic + r) * destino.ld + jr : descarte[1];
+                    }
+
+                    planarMicroKernel(kc, ar, ai, pacote + (size_t)(jr - jc) / PLANAR_NR * kc * 2 * PLANAR_NR, cr, ci);
+                }
+            }
+        }
+    }
+
+    //! Remaining columns (fewer than PLANAR_NR), computed row by row
+    if (nCheio < n)
+    {
+        for (int i = 0; i < m; i++)
+        {
+            float *cr = destino.Re + (size_t)i * destino.ld;
+            float *ci = destino.Im + (size_t)i * destino.ld;
+
+            for (int k = 0; k < kTotal; k++)
+            {
+                const float xr = matrix1.Re[(size_t)i * matrix1.ld + k];
+                const float xi = matrix1.Im[(size_t)i * matrix1.ld + k];
+                const float *br = matrix2.Re + (size_t)k * matrix2.ld;
+                const float *bi = matrix2.Im + (size_t)k * matrix2.ld;
+
+                for (int j = nCheio; j < n; j++)
+                {
+                    cr[j] += xr * br[j] - xi * bi[j];
+                    ci[j] += xr * bi[j] + xi * br[j];
+                }
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file matrizes_planar.h
+ * @brief Header file for complex matrices in planar (split-complex) layout.
+ */
+
+#ifndef MATRIZES_PLANAR_H
+#define MATRIZES_PLANAR_H
+#include "matrizes.h"
+
+/*!
+* @brief Complex matrix stored as two separate planes, one for the real parts and one for the imaginary parts.
+*
+* Element (i, j) is Re[i * ld + j] + i Im[i * ld + j]. With the parts split, a complex product is plain
+* vertical arithmetic on SIMD registers (no shuffles), which is what the vectorized kernels want.
+* The leading dimension is rounded up to a whole cache line, so every row of both planes is 64-byte aligned.
+*/
+typedef struct
+{
+    int linhas, colunas; /*!< Fields to store the number of rows and columns */
+    int ld;              /*!< Leading dimension of both planes, in floats */
+    float *Re;           /*!< Plane of the real parts */
+    float *Im;           /*!< Plane of the imaginary parts */
+    void *bloco;         /*!< Block owned by the matrix (NULL for views) */
+} complexMatrixPlanar;
+
+///****************************************** ALLOCATION AND CONVERSION ****************************************************/
+
+/**
+ * @brief Allocates a planar complex matrix (both planes in a single aligned block).
+ *
+ * @param linhas Number of rows.
+ * @param colunas Number of columns.
+ * @return The allocated complexMatrixPlanar.
+ */
+complexMatrixPlanar allocateComplexMatrixPlanar(int linhas, int colunas);
+
+/**
+ * @brief Frees the memory owned by a planar complex matrix.
+ *
+ * @param matrix The complexMatrixPlanar object to be freed.
+ */
+void freeComplexMatrixPlanar(complexMatrixPlanar matrix);
+
+/**
+ * @brief Converts an interleaved matrix to the planar layout.
+ *
+ * @param destino The planar matrix that receives the elements (same shape as origem).
+ * @param origem The interleaved complexMatrix.
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixParaPlanar(complexMatrixPlanar destino, complexMatrix origem);
+
+/**
+ * @brief Converts a planar matrix back to the interleaved layout.
+ *
+ * @param destino The interleaved complexMatrix that receives the elements (same shape as origem).
+ * @param origem The planar matrix.
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int planarParaMatrix(complexMatrix destino, complexMatrixPlanar origem);
+
+///****************************************** OPERATIONS ****************************************************/
+///
+///-----> Same conventions as the *Em functions of matrizes.h: the result goes to 'destino',
+///-----> 0 is returned on success and -1 when the dimensions do not agree.
+///
+
+/**
+ * @brief Writes matrix1 + matrix2 into destino (destino may be an operand).
+ */
+int planarSomaEm(complexMatrixPlanar destino, complexMatrixPlanar matrix1, complexMatrixPlanar matrix2);
+
+/**
+ * @brief Writes matrix1 - matrix2 into destino (destino may be an operand).
+ */
+int planarSubtracaoEm(complexMatrixPlanar destino, complexMatrixPlanar matrix1, complexMatrixPlanar matrix2);
+
+/**
+ * @brief Writes num * matrix into destino (destino may be matrix).
+ */
+int planar_produtoEscalarEm(complexMatrixPlanar destino, complexMatrixPlanar matrix, float num);
+
+/**
+ * @brief Writes the conjugate of matrix into destino (destino may be matrix).
+ */
+int planarConjugadaEm(complexMatrixPlanar destino, complexMatrixPlanar matrix);
+
+/**
+ * @brief Writes the element-wise complex product of matrix1 and matrix2 into destino (destino may be an operand).
+ */
+int planarProdutoElementoEm(complexMatrixPlanar destino, complexMatrixPlanar matrix1, complexMatrixPlanar matrix2);
+
+/**
+ * @brief Writes the complex matrix product matrix1 * matrix2 into destino.
+ *
+ * @param destino The planar matrix that receives the product (m x n); must not overlap the operands.
+ * @param matrix1 The first planar matrix (m x k).
+ * @param matrix2 The second planar matrix (k x n).
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int planarProdutoEm(complexMatrixPlanar destino, complexMatrixPlanar matrix1, complexMatrixPlanar matrix2);
+
+#endif
@@ -0,0 +1,360 @@
+/**
+ * @file memoria.c
+ * @brief Implementation file for the frame arena and the matrix pool.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/// including the files where the structures are contained
+#include "memoria.h"
+#include "matrizes.h"
+#include "teste.h"
+
+/*
+ * Rounds a size up to a whole number of cache lines, so every block carved from the arena is aligned.
+ */
+#define ARENA_ARREDONDA(bytes) (((bytes) + MATRIX_ALINHAMENTO - 1) / MATRIX_ALINHAMENTO * MATRIX_ALINHAMENTO)
+
+/************************************* ARENA ***************************************/
+
+/**
+ * @param[out] arena The arena to be initialized
+ * @param[in] capacidade Size of the arena, in bytes
+ *
+ * @brief Allocates the single block of the arena.
+ *
+ * @return 0 on success, -1 if the block could not be allocated.
+ */
+int arenaInit(matrixArena *arena, size_t capacidade)
+{
+    arena->capacidade = ARENA_ARREDONDA(capacidade);
+    arena->topo = 0;
+    arena->base = (char *)matrixAlignedAlloc(arena->capacidade);
+
+    if (arena->base == NULL)
+    {
+        arena->capacidade = 0;
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @param[in] arena The arena to be released
+ *
+ * @brief Releases the block of the arena.
+ */
+void arenaFree(matrixArena *arena)
+{
+    matrixAlignedFree(arena->base);
+    arena->base = NULL;
+    arena->capacidade = 0;
+    arena->topo = 0;
+}
+
+/**
+ * @param[in] arena The arena
+ * @param[in] bytes Number of bytes requested
+ *
+ * @brief Carves a block by bumping the top of the arena.
+ *
+ * @return Pointer to the block, or NULL if the arena is exhausted.
+ */
+void *arenaAlloc(matrixArena *arena, size_t bytes)
+{
+    size_t tamanho = ARENA_ARREDONDA(bytes);
+
+    if (tamanho > arena->capacidade - arena->topo)
+    {
+        return NULL;
+    }
+
+    void *bloco = arena->base + arena->topo;
+    arena->topo += tamanho;
+
+    return bloco;
+}
+
+/**
+ * @brief Returns the current top of the arena.
+ */
+size_t arenaMarca(const matrixArena *arena)
+{
+    return arena->topo;
+}
+
+/**
+ * @brief Moves the top of the arena back to a previous mark.
+ */
+void arenaLibera(matrixArena *arena, size_t marca)
+{
+    if (marca <= arena->topo)
+    {
+        arena->topo = marca;
+    }
+}
+
+/**
+ * @brief Releases everything carved from the arena.
+ */
+void arenaReset(matrixArena *arena)
+{
+    arena->topo = 0;
+}
+
+/**
+ * @param[in] arena The arena
+ * @param[in] linhas Number of rows
+ * @param[in] colunas Number of columns
+ *
+ * @brief Carves a complex matrix, with the same layout as allocateComplexMatrix, from the arena.
+ *
+ * @return The complexMatrix, which does not own its block.
+ */
+complexMatrix arenaComplexMatrix(matrixArena *arena, int linhas, int colunas)
+{
+    void *bloco = arenaAlloc(arena, matrixTamanhoBloco(linhas, colunas));
+
+    //! Handling an exhausted arena the same way as a failed allocation
+    if (bloco == NULL)
+    {
+        printf("Memoria da arena esgotada\n");
+        exit(1);
+    }
+
+    complexMatrix matrix = matrixSobreBloco(bloco, linhas, colunas);
+
+    //! The block belongs to the arena, so freeComplexMatrix must not release it
+    matrix.bloco = NULL;
+
+    return matrix;
+}
+
+/**
+ * @param[in] arena The arena
+ * @param[in] tamanho Number of complex elements
+ *
+ * @brief Carves a vector of complex numbers from the arena.
+ *
+ * @return Pointer to the vector.
+ */
+complex *arenaComplexVector(matrixArena *arena, long int tamanho)
+{
+    complex *vetor = (complex *)arenaAlloc(arena, (size_t)tamanho * sizeof(complex));
+
+    if (vetor == NULL)
+    {
+        printf("Memoria da arena esgotada\n");
+        exit(1);
+    }
+
+    return vetor;
+}
+
+/************************************* POOL ***************************************/
+
+/**
+ * @brief Initializes an empty pool.
+ */
+void poolInit(matrixPool *pool)
+{
+    pool->numClasses = 0;
+}
+
+/**
+ * @brief Releases every free block kept by the pool.
+ */
+void poolFree(matrixPool *pool)
+{
+    for (int i = 0; i < pool->numClasses; i++)
+    {
+        void *bloco = pool->classes[i].livres;
+
+        while (bloco != NULL)
+        {
+            void *proximo = *(void **)bloco;
+            matrixAlignedFree(bloco);
+            bloco = proximo;
+        }
+    }
+    pool->numClasses = 0;
+}
+
+/**
+ * @brief Finds the class of a shape, creating it if there is room.
+ *
+ * @return The class, or NULL if the shape is new and the pool is full.
+ */
+static matrixPoolClasse *poolClasse(matrixPool *pool, int linhas, int colunas)
+{
+    for (int i = 0; i < pool->numClasses; i++)
+    {
+        if (pool->classes[i].linhas == linhas && pool->classes[i].colunas == colunas)
+        {
+            return &pool->classes[i];
+        }
+    }
+
+    if (pool->numClasses == MATRIX_POOL_CLASSES)
+    {
+        return NULL;
+    }
+
+    matrixPoolClasse *classe = &pool->classes[pool->numClasses++];
+    classe->linhas = linhas;
+    classe->colunas = colunas;
+    classe->livres = NULL;
+
+    return classe;
+}
+
+/**
+ * @param[in] pool The pool
+ * @param[in] linhas Number of rows
+ * @param[in] colunas Number of columns
+ *
+ * @brief Pops a free block of the shape, or allocates a new matrix if there is none.
+ *
+ * @return The complexMatrix.
+ */
+complexMatrix poolObtem(matrixPool *pool, int linhas, int colunas)
+{
+    matrixPoolClasse *classe = poolClasse(pool, linhas, colunas);
+
+    if (classe == NULL || classe->livres == NULL)
+    {
+        return allocateComplexMatrix(linhas, colunas);
+    }
+
+    void *bloco = classe->livres;
+    classe->livres = *(void **)bloco;
+
+    //! The link overwrote the first row pointer, so the layout is rebuilt (no allocation involved)
+    return matrixSobreBloco(bloco, linhas, colunas);
+}
+
+/**
+ * @param[in] pool The pool
+ * @param[in] matrix The matrix given back
+ *
+ * @brief Pushes the block of the matrix on the free list of its shape.
+ *
+ * Views and arena matrices own no block and are ignored. If the shape is new and the pool is full,
+ * the block is simply freed.
+ */
+void poolDevolve(matrixPool *pool, complexMatrix matrix)
+{
+    if (matrix.bloco == NULL)
+    {
+        return;
+    }
+
+    matrixPoolClasse *classe = poolClasse(pool, matrix.linhas, matrix.colunas);
+
+    if (classe == NULL)
+    {
+        freeComplexMatrix(matrix);
+        return;
+    }
+
+    *(void **)matrix.bloco = classe->livres;
+    classe->livres = matrix.bloco;
+}
+
+/************************************* TESTS ***************************************/
+
+/**
+ * @brief Checks the matrix pool: a returned block is handed out again for its shape, matrices in use never
+ * share a block, other shapes and views do not touch the free list, and a pool with all of its
+ * MATRIX_POOL_CLASSES classes in use still serves (and frees) the matrices of a new shape.
+ *
+ * @return The number of failed checks.
+ */
+int teste_memoria(void)
+{
+    matrixPool pool;
+    int falhas = 0;
+
+    printf("\n  ============ Teste do pool de matrizes ============ \n\n");
+
+    poolInit(&pool);
+
+    //! Get, return and get again: the second matrix must reuse the block of the first
+    {
+        complexMatrix a = poolObtem(&pool, 4, 3);
+        void *bloco = a.bloco;
+
+        testePreenche(a, 1);
+        poolDevolve(&pool, a);
+
+        complexMatrix b = poolObtem(&pool, 4, 3);
+        falhas += testeConfere("poolObtem  reusa o bloco devolvido", b.bloco == bloco && b.linhas == 4 && b.colunas == 3, NULL);
+
+        //! The layout is rebuilt over the block, so the matrix is fully usable
+        testePreenche(b, 2);
+        complexMatrix c = allocateComplexMatrix(4, 3);
+        testePreenche(c, 2);
+        falhas += testeConfere("poolObtem  matriz reusada utilizavel", testeDiferenca(b, c) == 0.0f && b.mtx[3] == &MATRIX_ELEM(b, 3, 0), NULL);
+        freeComplexMatrix(c);
+
+        //! With b in use, the pool is empty for the shape: the next matrix gets a block of its own
+        complexMatrix d = poolObtem(&pool, 4, 3);
+        falhas += testeConfere("poolObtem  matrizes em uso distintas", d.bloco != NULL && d.bloco != b.bloco, NULL);
+
+        //! Another shape and a view do not take the blocks of the 4 x 3 class
+        complexMatrix e = poolObtem(&pool, 3, 4);
+        poolDevolve(&pool, matrixView(b, 0, 0, 2, 2));
+        poolDevolve(&pool, d);
+        poolDevolve(&pool, b);
+        complexMatrix f = poolObtem(&pool, 4, 3);
+        complexMatrix g = poolObtem(&pool, 4, 3);
+        falhas += testeConfere("poolDevolve  LIFO por formato, view ignorada", f.bloco == bloco && g.bloco == d.bloco && e.bloco != bloco, NULL);
+
+        poolDevolve(&pool, e);
+        poolDevolve(&pool, f);
+        poolDevolve(&pool, g);
+    }
+
+    //! Exhaustion: once every class is in use, a new shape is allocated and freed instead of pooled
+    poolFree(&pool);
+    {
+        complexMatrix formas[MATRIX_POOL_CLASSES];
+        int ok = 1;
+
+        for (int i = 0; i < MATRIX_POOL_CLASSES; i++)
+        {
+            formas[i] = poolObtem(&pool, 1, i + 1);
+        }
+        for (int i = 0; i < MATRIX_POOL_CLASSES; i++)
+        {
+            poolDevolve(&pool, formas[i]);
+        }
+        ok = ok && (pool.numClasses == MATRIX_POOL_CLASSES);
+
+        complexMatrix extra = poolObtem(&pool, 9, 9);
+        ok = ok && (extra.bloco != NULL) && (pool.numClasses == MATRIX_POOL_CLASSES);
+        testePreenche(extra, 3);
+        poolDevolve(&pool, extra);
+        ok = ok && (pool.numClasses == MATRIX_POOL_CLASSES);
+
+        //! The existing classes keep working
+        complexMatrix de_novo = poolObtem(&pool, 1, MATRIX_POOL_CLASSES);
+        ok = ok && (de_novo.bloco == formas[MATRIX_POOL_CLASSES - 1].bloco);
+        poolDevolve(&pool, de_novo);
+
+        falhas += testeConfere("pool cheio  formato novo alocado e liberado", ok, "%d classes", pool.numClasses);
+    }
+
+    //! poolFree releases every block and leaves an empty pool that can be used again
+    poolFree(&pool);
+    {
+        complexMatrix a = poolObtem(&pool, 2, 2);
+        falhas += testeConfere("poolFree  pool vazio reutilizavel", pool.numClasses == 1 && a.bloco != NULL, NULL);
+        poolDevolve(&pool, a);
+    }
+    poolFree(&pool);
+
+    return falhas;
+}
@@ -0,0 +1,171 @@
+/**
+ * @file memoria.h
+ * @brief Header file for the frame arena and the matrix pool used by the temporaries of the processing chain.
+ */
+
+#ifndef MEMORIA_H
+#define MEMORIA_H
+#include <stddef.h>
+#include "matrizes.h"
+
+/*!
+* @brief Frame-scoped arena: a single block from which temporaries are carved by bumping an offset.
+*
+* Everything carved from the arena is released at once by arenaReset (O(1)), or back to a mark
+* taken with arenaMarca, which suits the strictly nested lifetimes of the temporaries of a frame.
+*/
+typedef struct
+{
+    char *base;        /*!< Start of the 64-byte aligned block */
+    size_t capacidade; /*!< Size of the block, in bytes */
+    size_t topo;       /*!< Offset of the first free byte */
+} matrixArena;
+
+/*!
+* @brief Maximum number of different shapes kept by a matrixPool.
+*/
+#define MATRIX_POOL_CLASSES 16
+
+/*!
+* @brief Size class of a matrixPool: the free blocks of one matrix shape.
+*/
+typedef struct
+{
+    int linhas, colunas; /*!< Shape served by the class */
+    void *livres;        /*!< Singly linked list of free blocks (the link lives in the first bytes of each block) */
+} matrixPoolClasse;
+
+/*!
+* @brief Pool of matrices for the recurring shapes (for example the Nr x Nt channels).
+*
+* Matrices returned to the pool are kept in a free list per shape and handed out again by
+* poolObtem, so a long run reaches a steady state without calling malloc/free.
+*/
+typedef struct
+{
+    matrixPoolClasse classes[MATRIX_POOL_CLASSES]; /*!< Size classes in use */
+    int numClasses;                                /*!< Number of classes in use */
+} matrixPool;
+
+///****************************************** ARENA ****************************************************/
+
+/**
+ * @brief Creates an arena with the given capacity.
+ *
+ * @param arena The arena to be initialized.
+ * @param capacidade Size of the arena, in bytes.
+ * @return 0 on success, -1 if the block could not be allocated.
+ */
+int arenaInit(matrixArena *arena, size_t capacidade);
+
+/**
+ * @brief Releases the block of the arena. Everything carved from it becomes invalid.
+ *
+ * @param arena The arena to be released.
+ */
+void arenaFree(matrixArena *arena);
+
+/**
+ * @brief Carves a 64-byte aligned block from the arena.
+ *
+ * @param arena The arena.
+ * @param bytes Number of bytes requested.
+ * @return Pointer to the block, or NULL if the arena is exhausted.
+ */
+void *arenaAlloc(matrixArena *arena, size_t bytes);
+
+/**
+ * @brief Returns the current position of the arena, to be restored later with arenaLibera.
+ *
+ * @param arena The arena.
+ * @return The mark.
+ */
+size_t arenaMarca(const matrixArena *arena);
+
+/**
+ * @brief Releases everything carved from the arena after the given mark.
+ *
+ * @param arena The arena.
+ * @param marca A mark returned by arenaMarca.
+ */
+void arenaLibera(matrixArena *arena, size_t marca);
+
+/**
+ * @brief Releases everything carved from the arena, in O(1). Used at the end of each frame.
+ *
+ * @param arena The arena.
+ */
+void arenaReset(matrixArena *arena);
+
+/**
+ * @brief Carves a complex matrix from the arena.
+ *
+ * The matrix has the same layout as one returned by allocateComplexMatrix, but it does not own its
+ * block: freeComplexMatrix ignores it and it is released together with the arena.
+ * If the arena is exhausted, an error message is printed and the program terminates.
+ *
+ * @param arena The arena.
+ * @param linhas Number of rows.
+ * @param colunas Number of columns.
+ * @return The complexMatrix.
+ */
+complexMatrix arenaComplexMatrix(matrixArena *arena, int linhas, int colunas);
+
+/**
+ * @brief Carves a vector of complex numbers from the arena.
+ *
+ * If the arena is exhausted, an error message is printed and the program terminates.
+ *
+ * @param arena The arena.
+ * @param tamanho Number of complex elements.
+ * @return Pointer to the vector.
+ */
+complex *arenaComplexVector(matrixArena *arena, long int tamanho);
+
+///****************************************** POOL ****************************************************/
+
+/**
+ * @brief Initializes an empty pool.
+ *
+ * @param pool The pool to be initialized.
+ */
+void poolInit(matrixPool *pool);
+
+/**
+ * @brief Releases every block kept by the pool.
+ *
+ * @param pool The pool to be released.
+ */
+void poolFree(matrixPool *pool);
+
+/**
+ * @brief Gets a matrix of the given shape, reusing a returned one when available.
+ *
+ * The contents of the matrix are undefined.
+ *
+ * @param pool The pool.
+ * @param linhas Number of rows.
+ * @param colunas Number of columns.
+ * @return The complexMatrix; it must go back with poolDevolve (or be freed with freeComplexMatrix).
+ */
+complexMatrix poolObtem(matrixPool *pool, int linhas, int colunas);
+
+/**
+ * @brief Gives a matrix obtained from poolObtem (or allocateComplexMatrix) back to the pool.
+ *
+ * @param pool The pool.
+ * @param matrix The matrix; it must not be used afterwards.
+ */
+void poolDevolve(matrixPool *pool, complexMatrix matrix);
+
+///****************************************** TESTS ****************************************************/
+
+/**
+ * @brief Checks the matrix pool: reuse of returned blocks, distinct blocks for the matrices in use, views
+ * ignored, a full pool and poolFree.
+ *
+ * @return The number of failed checks.
+ */
+int teste_memoria(void);
+
+#endif
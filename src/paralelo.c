@@ -0,0 +1,1032 @@
+/**
+ * @file paralelo.c
+ * @brief Implementation file for the persistent thread pool and the parallel matrix operations.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <math.h>
+
+/// including the files where the structures are contained
+#include "paralelo.h"
+#include "matrizes.h"
+#include "matrizes_lote.h"
+#include "teste.h"
+
+/*
+ * Ranges queued per thread on each call. A few ranges per thread leave room for stealing when one
+ * thread is slowed down, without cutting the work into pieces too small to pay for themselves.
+ */
+#define PARALELO_TAREFAS_POR_THREAD 4
+
+/*!
+* @brief Range [inicio, fim) of a parallel loop, with the function that runs it.
+*/
+typedef struct
+{
+    long inicio, fim;
+    paraleloFuncao funcao;
+    void *contexto;
+} paraleloTarefa;
+
+/*!
+* @brief Deque of one thread: the owner takes the newest range (topo), the thieves the oldest one (base).
+*/
+typedef struct
+{
+    pthread_mutex_t trava;
+    int base, topo;
+    paraleloTarefa tarefas[PARALELO_TAREFAS_POR_THREAD];
+} paraleloDeque;
+
+/*!
+* @brief State of the pool. Thread 0 is whoever calls paraleloPara; threads 1 .. numThreads - 1 are the workers.
+*/
+static struct
+{
+    int numThreads;                //!< 0 while the pool has not been started
+    pthread_t *threads;
+    paraleloDeque *deques;
+    pthread_mutex_t trava;         //!< Protects geracao and encerrar
+    pthread_cond_t sinal;          //!< Wakes the workers when geracao changes
+    unsigned long geracao;         //!< Incremented on every call that uses the pool
+    int encerrar;
+    atomic_long pendentes;         //!< Ranges of the current call not finished yet
+} pool = {0, NULL, NULL, PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, 0, 0, 0};
+
+//! Serializes the calls to the pool and its start and stop
+static pthread_mutex_t travaChamada = PTHREAD_MUTEX_INITIALIZER;
+
+//! Set while a thread runs a range, so that nested parallel calls run serially
+static _Thread_local int emTarefa = 0;
+
+/************************************* DEQUES ***************************************/
+
+/**
+ * @brief Takes the newest range of the thread's own deque.
+ *
+ * @return 1 if a range was taken, 0 if the deque is empty.
+ */
+static int paraleloRetira(paraleloDeque *deque, paraleloTarefa *tarefa)
+{
+    int achou = 0;
+
+    pthread_mutex_lock(&deque->trava);
+    if (deque->topo > deque->base)
+    {
+        *tarefa = deque->tarefas[--deque->topo];
+        achou = 1;
+    }
+    pthread_mutex_unlock(&deque->trava);
+
+    return achou;
+}
+
+/**
+ * @brief Steals the oldest range of another thread's deque.
+ *
+ * @return 1 if a range was taken, 0 if the deque is empty.
+ */
+static int paraleloRouba(paraleloDeque *deque, paraleloTarefa *tarefa)
+{
+    int achou = 0;
+
+    pthread_mutex_lock(&deque->trava);
+    if (deque->topo > deque->base)
+    {
+        *tarefa = deque->tarefas[deque->base++];
+        achou = 1;
+    }
+    pthread_mutex_unlock(&deque->trava);
+
+    return achou;
+}
+
+/**
+ * @param[in] id Index of the thread
+ *
+ * @brief Runs ranges of the current call until none is left: first the thread's own, then stolen ones.
+ */
+static void paraleloExecuta(int id)
+{
+    paraleloTarefa tarefa;
+
+    for (;;)
+    {
+        int achou = paraleloRetira(&pool.deques[id], &tarefa);
+
+        for (int v = 1; !achou && v < pool.numThreads; v++)
+        {
+            achou = paraleloRouba(&pool.deques[(id + v) % pool.numThreads], &tarefa);
+        }
+
+        if (!achou)
+        {
+            return;
+        }
+
+        emTarefa = 1;
+        tarefa.funcao(tarefa.contexto, tarefa.inicio, tarefa.fim);
+        emTarefa = 0;
+
+        atomic_fetch_sub(&pool.pendentes, 1);
+    }
+}
+
+/**
+ * @brief Body of a worker: sleeps until a new call (or the stop) and then helps with its ranges.
+ */
+static void *paraleloTrabalhador(void *argumento)
+{
+    const int id = (int)(intptr_t)argumento;
+    unsigned long vista = 0;
+
+    pthread_mutex_lock(&pool.trava);
+    for (;;)
+    {
+        while (!pool.encerrar && pool.geracao == vista)
+        {
+            pthread_cond_wait(&pool.sinal, &pool.trava);
+        }
+
+        if (pool.encerrar)
+        {
+            break;
+        }
+
+        vista = pool.geracao;
+        pthread_mutex_unlock(&pool.trava);
+
+        paraleloExecuta(id);
+
+        pthread_mutex_lock(&pool.trava);
+    }
+    pthread_mutex_unlock(&pool.trava);
+
+    return NULL;
+}
+
+/************************************* THREAD POOL ***************************************/
+
+/**
+ * @brief Stops the workers; travaChamada must be held.
+ */
+static void paraleloEncerra(void)
+{
+    if (pool.numThreads == 0)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&pool.trava);
+    pool.encerrar = 1;
+    pthread_cond_broadcast(&pool.sinal);
+    pthread_mutex_unlock(&pool.trava);
+
+    for (int t = 1; t < pool.numThreads; t++)
+    {
+        pthread_join(pool.threads[t], NULL);
+    }
+
+    for (int t = 0; t < pool.numThreads; t++)
+    {
+        pthread_mutex_destroy(&pool.deques[t].trava);
+    }
+
+    free(pool.threads);
+    free(pool.deques);
+    pool.threads = NULL;
+    pool.deques = NULL;
+    pool.numThreads = 0;
+    pool.encerrar = 0;
+    pool.geracao = 0;
+}
+
+/**
+ * @brief Starts the pool; travaChamada must be held.
+ */
+static int paraleloInicia(int numThreads)
+{
+    if (pool.numThreads != 0)
+    {
+        return 0;
+    }
+
+    if (numThreads <= 0)
+    {
+#ifdef _SC_NPROCESSORS_ONLN
+        numThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+        if (numThreads <= 0)
+        {
+            numThreads = 1;
+        }
+    }
+
+    pool.threads = (pthread_t *)malloc((size_t)numThreads * sizeof(pthread_t));
+    pool.deques = (paraleloDeque *)malloc((size_t)numThreads * sizeof(paraleloDeque));
+
+    if (pool.threads == NULL || pool.deques == NULL)
+    {
+        printf("Falha na alocacao de memoria\n");
+        exit(1);
+    }
+
+    for (int t = 0; t < numThreads; t++)
+    {
+        pthread_mutex_init(&pool.deques[t].trava, NULL);
+        pool.deques[t].base = 0;
+        pool.deques[t].topo = 0;
+    }
+
+    pool.numThreads = numThreads;
+
+    for (int t = 1; t < numThreads; t++)
+    {
+        if (pthread_create(&pool.threads[t], NULL, paraleloTrabalhador, (void *)(intptr_t)t) != 0)
+        {
+            //! Keeping the threads that were created would leave deques nobody empties: stop them all
+            pool.numThreads = t;
+            paraleloEncerra();
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @param[in] numThreads Number of threads, or 0 for one per online core
+ *
+ * @brief Starts the pool. Does nothing if it is already running.
+ *
+ * @return 0 on success, -1 if the threads could not be created.
+ */
+int paraleloInit(int numThreads)
+{
+    pthread_mutex_lock(&travaChamada);
+    const int status = paraleloInicia(numThreads);
+    pthread_mutex_unlock(&travaChamada);
+
+    return status;
+}
+
+/**
+ * @brief Stops and joins the threads of the pool; the next parallel call starts it again.
+ */
+void paraleloFree(void)
+{
+    pthread_mutex_lock(&travaChamada);
+    paraleloEncerra();
+    pthread_mutex_unlock(&travaChamada);
+}
+
+/**
+ * @brief Returns the number of threads of the pool (1 before it is started).
+ */
+int paraleloNumThreads(void)
+{
+    //! Inside a range the caller of the pool holds travaChamada, and the pool cannot change anyway
+    if (emTarefa)
+    {
+        return pool.numThreads;
+    }
+
+    pthread_mutex_lock(&travaChamada);
+    const int numThreads = (pool.numThreads == 0) ? 1 : pool.numThreads;
+    pthread_mutex_unlock(&travaChamada);
+
+    return numThreads;
+}
+
+/**
+ * @param[in] numItens Number of items
+ * @param[in] custoPorItem Estimated work of one item
+ * @param[in] funcao The function run over each range
+ * @param[in] contexto Argument passed to funcao
+ *
+ * @brief Splits [0, numItens) into ranges, deals them out to the deques and runs them with the pool.
+ *
+ * The calling thread works as thread 0 and then waits for the ranges stolen by the others, so the
+ * results are complete when the function returns.
+ */
+void paraleloPara(long numItens, long custoPorItem, paraleloFuncao funcao, void *contexto)
+{
+    if (numItens <= 0)
+    {
+        return;
+    }
+
+    const long trabalho = numItens * (custoPorItem > 0 ? custoPorItem : 1);
+
+    //! Small work, and parallel calls made from inside a range, are not worth the pool
+    if (emTarefa || trabalho < 2 * PARALELO_TRABALHO_MINIMO)
+    {
+        funcao(contexto, 0, numItens);
+        return;
+    }
+
+    pthread_mutex_lock(&travaChamada);
+
+    if (pool.numThreads == 0)
+    {
+        paraleloInicia(0);
+    }
+
+    long partes = (long)pool.numThreads * PARALELO_TAREFAS_POR_THREAD;
+    if (partes > trabalho / PARALELO_TRABALHO_MINIMO)
+    {
+        partes = trabalho / PARALELO_TRABALHO_MINIMO;
+    }
+    if (partes > numItens)
+    {
+        partes = numItens;
+    }
+
+    if (pool.numThreads <= 1 || partes < 2)
+    {
+        pthread_mutex_unlock(&travaChamada);
+        funcao(contexto, 0, numItens);
+        return;
+    }
+
+    //! Contiguous ranges of nearly equal size, dealt out round-robin
+    atomic_store(&pool.pendentes, partes);
+
+    for (long p = 0; p < partes; p++)
+    {
+        paraleloDeque *deque = &pool.deques[p % pool.numThreads];
+        paraleloTarefa tarefa = {numItens * p / partes, numItens * (p + 1) / partes, funcao, contexto};
+
+        pthread_mutex_lock(&deque->trava);
+        if (p < pool.numThreads)
+        {
+            deque->base = 0;
+            deque->topo = 0;
+        }
+        deque->tarefas[deque->topo++] = tarefa;
+        pthread_mutex_unlock(&deque->trava);
+    }
+
+    pthread_mutex_lock(&pool.trava);
+    pool.geracao++;
+    pthread_cond_broadcast(&pool.sinal);
+    pthread_mutex_unlock(&pool.trava);
+
+    paraleloExecuta(0);
+
+    //! The last ranges may still be running on other threads
+    while (atomic_load(&pool.pendentes) > 0)
+    {
+        sched_yield();
+    }
+
+    pthread_mutex_unlock(&travaChamada);
+}
+
+/************************************* PARALLEL MATRIX OPERATIONS ***************************************/
+
+/*!
+* @brief Operands of a parallel matrix operation and the serial function run on each slice.
+*/
+typedef struct
+{
+    complexMatrix destino, matrix1, matrix2;
+    float escalar;
+    int (*binaria)(complexMatrix, complexMatrix, complexMatrix);
+    int (*unaria)(complexMatrix, complexMatrix);
+} paraleloMatrizes;
+
+/**
+ * @brief Element-wise operations on the rows [inicio, fim).
+ */
+static void paraleloElementosLinhas(void *contexto, long inicio, long fim)
+{
+    const paraleloMatrizes *c = (const paraleloMatrizes *)contexto;
+    const int i0 = (int)inicio, linhas = (int)(fim - inicio);
+
+    complexMatrix destino = matrixView(c->destino, i0, 0, linhas, c->destino.colunas);
+    complexMatrix matrix1 = matrixView(c->matrix1, i0, 0, linhas, c->matrix1.colunas);
+
+    if (c->binaria != NULL)
+    {
+        c->binaria(destino, matrix1, matrixView(c->matrix2, i0, 0, linhas, c->matrix2.colunas));
+    }
+    else if (c->unaria != NULL)
+    {
+        c->unaria(destino, matrix1);
+    }
+    else
+    {
+        matrix_produtoEscalarEm(destino, matrix1, c->escalar);
+    }
+}
+
+/**
+ * @brief Runs an element-wise operation over row slices, after checking the shapes.
+ */
+static int paraleloElementos(paraleloMatrizes contexto, int binaria)
+{
+    if (contexto.destino.linhas != contexto.matrix1.linhas || contexto.destino.colunas != contexto.matrix1.colunas ||
+        (binaria && (contexto.matrix2.linhas != contexto.matrix1.linhas || contexto.matrix2.colunas != contexto.matrix1.colunas)))
+    {
+        return -1;
+    }
+
+    paraleloPara(contexto.destino.linhas, contexto.destino.colunas, paraleloElementosLinhas, &contexto);
+
+    return 0;
+}
+
+/**
+ * @brief Parallel matrixSomaEm (destino may be an operand).
+ *
+ * @return 0 on success, -1 if the shapes do not agree.
+ */
+int matrixSomaParaleloEm(complexMatrix destino, complexMatrix matrix1, complexMatrix matrix2)
+{
+    paraleloMatrizes contexto = {destino, matrix1, matrix2, 0.0f, matrixSomaEm, NULL};
+
+    return paraleloElementos(contexto, 1);
+}
+
+/**
+ * @brief Parallel matrixSubtracaoEm (destino may be an operand).
+ *
+ * @return 0 on success, -1 if the shapes do not agree.
+ */
+int matrixSubtracaoParaleloEm(complexMatrix destino, complexMatrix matrix1, complexMatrix matrix2)
+{
+    paraleloMatrizes contexto = {destino, matrix1, matrix2, 0.0f, matrixSubtracaoEm, NULL};
+
+    return paraleloElementos(contexto, 1);
+}
+
+/**
+ * @brief Parallel matrix_produtoEscalarEm (destino may be matrix).
+ *
+ * @return 0 on success, -1 if the shapes do not agree.
+ */
+int matrix_produtoEscalarParaleloEm(complexMatrix destino, complexMatrix matrix, float num)
+{
+    paraleloMatrizes contexto = {destino, matrix, matrix, num, NULL, NULL};
+
+    return paraleloElementos(contexto, 0);
+}
+
+/**
+ * @brief Parallel matrixConjugadaEm (destino may be matrix).
+ *
+ * @return 0 on success, -1 if the shapes do not agree.
+ */
+int matrixConjugadaParaleloEm(complexMatrix destino, complexMatrix matrix)
+{
+    paraleloMatrizes contexto = {destino, matrix, matrix, 0.0f, NULL, matrixConjugadaEm};
+
+    return paraleloElementos(contexto, 0);
+}
+
+/**
+ * @brief Transposition of the rows [inicio, fim) of the source into the same columns of destino.
+ */
+static void paraleloTranspostaLinhas(void *contexto, long inicio, long fim)
+{
+    const paraleloMatrizes *c = (const paraleloMatrizes *)contexto;
+    const int i0 = (int)inicio, linhas = (int)(fim - inicio);
+
+    c->unaria(matrixView(c->destino, 0, i0, c->destino.linhas, linhas),
+              matrixView(c->matrix1, i0, 0, linhas, c->matrix1.colunas));
+}
+
+/**
+ * @brief Runs a transposition over row slices of the source, after checking the shapes.
+ */
+static int paraleloTransposicao(complexMatrix destino, complexMatrix matrix, int (*unaria)(complexMatrix, complexMatrix))
+{
+    if (destino.linhas != matrix.colunas || destino.colunas != matrix.linhas)
+    {
+        return -1;
+    }
+
+    paraleloMatrizes contexto = {destino, matrix, matrix, 0.0f, NULL, unaria};
+    paraleloPara(matrix.linhas, matrix.colunas, paraleloTranspostaLinhas, &contexto);
+
+    return 0;
+}
+
+/**
+ * @brief Parallel matrixTranspostaEm (destino must not overlap matrix).
+ *
+ * @return 0 on success, -1 if the shapes do not agree.
+ */
+int matrixTranspostaParaleloEm(complexMatrix destino, complexMatrix matrix)
+{
+    return paraleloTransposicao(destino, matrix, matrixTranspostaEm);
+}
+
+/**
+ * @brief Parallel matrixHermitianaEm (destino must not overlap matrix).
+ *
+ * @return 0 on success, -1 if the shapes do not agree.
+ */
+int matrixHermitianaParaleloEm(complexMatrix destino, complexMatrix matrix)
+{
+    return paraleloTransposicao(destino, matrix, matrixHermitianaEm);
+}
+
+/**
+ * @brief Product restricted to the rows [inicio, fim) of matrix1 and destino.
+ */
+static void paraleloProdutoLinhas(void *contexto, long inicio, long fim)
+{
+    const paraleloMatrizes *c = (const paraleloMatrizes *)contexto;
+    const int i0 = (int)inicio, linhas = (int)(fim - inicio);
+
+    matrixProdutoEm(matrixView(c->destino, i0, 0, linhas, c->destino.colunas),
+                    matrixView(c->matrix1, i0, 0, linhas, c->matrix1.colunas), c->matrix2);
+}
+
+/**
+ * @brief Product restricted to the columns [inicio, fim) of matrix2 and destino.
+ */
+static void paraleloProdutoColunas(void *contexto, long inicio, long fim)
+{
+    const paraleloMatrizes *c = (const paraleloMatrizes *)contexto;
+    const int j0 = (int)inicio, colunas = (int)(fim - inicio);
+
+    matrixProdutoEm(matrixView(c->destino, 0, j0, c->destino.linhas, colunas), c->matrix1,
+                    matrixView(c->matrix2, 0, j0, c->matrix2.linhas, colunas));
+}
+
+/**
+ * @brief Parallel matrixProdutoEm: the longer side of the product is split, the other operand is shared.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixProdutoParaleloEm(complexMatrix destino, complexMatrix matrix1, complexMatrix matrix2)
+{
+    if (matrix1.colunas != matrix2.linhas || destino.linhas != matrix1.linhas || destino.colunas != matrix2.colunas)
+    {
+        return -1;
+    }
+
+    paraleloMatrizes contexto = {destino, matrix1, matrix2, 0.0f, NULL, NULL};
+
+    if (destino.linhas >= destino.colunas)
+    {
+        paraleloPara(destino.linhas, (long)matrix1.colunas * destino.colunas, paraleloProdutoLinhas, &contexto);
+    }
+    else
+    {
+        paraleloPara(destino.colunas, (long)matrix1.colunas * destino.linhas, paraleloProdutoColunas, &contexto);
+    }
+
+    return 0;
+}
+
+/************************************* PARALLEL BATCHED OPERATIONS ***************************************/
+
+/*!
+* @brief Operands of a parallel batched operation; the items are groups of MATRIX_LOTE_LANES matrices.
+*/
+typedef struct
+{
+    complexMatrixLote destino, matrix1, matrix2;
+    float *S;
+    int (*binaria)(complexMatrixLote, complexMatrixLote, complexMatrixLote);
+    int (*unaria)(complexMatrixLote, complexMatrixLote);
+} paraleloLotes;
+
+/**
+ * @brief View of the lane groups [inicio, fim) of a batch.
+ */
+static complexMatrixLote paraleloFatiaLote(complexMatrixLote matrix, long inicio, long fim)
+{
+    const int b0 = (int)inicio * MATRIX_LOTE_LANES;
+    const int b1 = ((int)fim * MATRIX_LOTE_LANES < matrix.lote) ? (int)fim * MATRIX_LOTE_LANES : matrix.lote;
+
+    return loteView(matrix, b0, b1 - b0);
+}
+
+/**
+ * @brief Batched operation on the lane groups [inicio, fim).
+ */
+static void paraleloLotesGrupos(void *contexto, long inicio, long fim)
+{
+    const paraleloLotes *c = (const paraleloLotes *)contexto;
+    complexMatrixLote destino = paraleloFatiaLote(c->destino, inicio, fim);
+    complexMatrixLote matrix1 = paraleloFatiaLote(c->matrix1, inicio, fim);
+
+    if (c->S != NULL)
+    {
+        //! SVD: destino is U, matrix2 is Vh and S moves with the first lane of the slice
+        loteSVDEm(destino, c->S + inicio * MATRIX_LOTE_LANES, paraleloFatiaLote(c->matrix2, inicio, fim), matrix1);
+    }
+    else if (c->binaria != NULL)
+    {
+        c->binaria(destino, matrix1, paraleloFatiaLote(c->matrix2, inicio, fim));
+    }
+    else
+    {
+        c->unaria(destino, matrix1);
+    }
+}
+
+/**
+ * @brief Runs a batched operation over slices of lane groups.
+ *
+ * The serial function is first called on empty views: it checks the shapes and batch sizes
+ * without touching any matrix, so the parallel version returns exactly what the serial one would.
+ */
+static int paraleloLotesExecuta(paraleloLotes contexto, long custoPorMatriz)
+{
+    const int lote = contexto.matrix1.lote;
+    paraleloLotes vazio = contexto;
+
+    vazio.destino.lote = (contexto.destino.lote == lote) ? 0 : -1;
+    vazio.matrix1.lote = 0;
+    vazio.matrix2.lote = (contexto.matrix2.lote == lote) ? 0 : -1;
+
+    int status;
+    if (contexto.S != NULL)
+    {
+        status = loteSVDEm(vazio.destino, contexto.S, vazio.matrix2, vazio.matrix1);
+    }
+    else if (contexto.binaria != NULL)
+    {
+        status = contexto.binaria(vazio.destino, vazio.matrix1, vazio.matrix2);
+    }
+    else
+    {
+        status = contexto.unaria(vazio.destino, vazio.matrix1);
+    }
+
+    if (status != 0)
+    {
+        return status;
+    }
+
+    const long grupos = (lote + MATRIX_LOTE_LANES - 1) / MATRIX_LOTE_LANES;
+    paraleloPara(grupos, custoPorMatriz * MATRIX_LOTE_LANES, paraleloLotesGrupos, &contexto);
+
+    return 0;
+}
+
+/**
+ * @brief Parallel loteSomaEm.
+ *
+ * @return 0 on success, -1 if the shapes or batch sizes do not agree.
+ */
+int loteSomaParaleloEm(complexMatrixLote destino, complexMatrixLote matrix1, complexMatrixLote matrix2)
+{
+    paraleloLotes contexto = {destino, matrix1, matrix2, NULL, loteSomaEm, NULL};
+
+    return paraleloLotesExecuta(contexto, (long)destino.linhas * destino.colunas);
+}
+
+/**
+ * @brief Parallel loteProdutoEm.
+ *
+ * @return 0 on success, -1 if the shapes or batch sizes do not agree.
+ */
+int loteProdutoParaleloEm(complexMatrixLote destino, complexMatrixLote matrix1, complexMatrixLote matrix2)
+{
+    paraleloLotes contexto = {destino, matrix1, matrix2, NULL, loteProdutoEm, NULL};
+
+    return paraleloLotesExecuta(contexto, (long)destino.linhas * destino.colunas * matrix1.colunas);
+}
+
+/**
+ * @brief Parallel loteHermitianaEm.
+ *
+ * @return 0 on success, -1 if the shapes or batch sizes do not agree.
+ */
+int loteHermitianaParaleloEm(complexMatrixLote destino, complexMatrixLote matrix)
+{
+    paraleloLotes contexto = {destino, matrix, matrix, NULL, NULL, loteHermitianaEm};
+
+    return paraleloLotesExecuta(contexto, (long)matrix.linhas * matrix.colunas);
+}
+
+/**
+ * @brief Parallel loteGramEm.
+ *
+ * @return 0 on success, -1 if the shapes or batch sizes do not agree.
+ */
+int loteGramParaleloEm(complexMatrixLote destino, complexMatrixLote matrix)
+{
+    paraleloLotes contexto = {destino, matrix, matrix, NULL, NULL, loteGramEm};
+
+    return paraleloLotesExecuta(contexto, (long)matrix.colunas * matrix.colunas * matrix.linhas);
+}
+
+/**
+ * @brief Parallel loteInversaEm.
+ *
+ * @return 0 on success, -1 if the shapes or batch sizes do not agree.
+ */
+int loteInversaParaleloEm(complexMatrixLote destino, complexMatrixLote matrix)
+{
+    paraleloLotes contexto = {destino, matrix, matrix, NULL, NULL, loteInversaEm};
+
+    return paraleloLotesExecuta(contexto, 2L * matrix.linhas * matrix.linhas * matrix.linhas);
+}
+
+/**
+ * @brief Parallel loteSVDEm.
+ *
+ * @return 0 on success, -1 if the shapes or batch sizes do not agree.
+ */
+int loteSVDParaleloEm(complexMatrixLote U, float *S, complexMatrixLote Vh, complexMatrixLote matrix)
+{
+    paraleloLotes contexto = {U, matrix, Vh, S, NULL, NULL};
+    const long k = (matrix.linhas < matrix.colunas) ? matrix.linhas : matrix.colunas;
+
+    //! A few Jacobi sweeps, each one rotating every pair of the k rows of length max(m, n)
+    return paraleloLotesExecuta(contexto, 8L * k * k * (matrix.linhas + matrix.colunas));
+}
+
+/************************************* TESTS ***************************************/
+
+/**
+ * @brief Largest difference between the lanes [0, lote) of two batches (the padding lanes are not compared).
+ */
+static float testeParaleloDiferencaLote(complexMatrixLote a, complexMatrixLote b)
+{
+    float maxima = 0.0f;
+
+    for (long e = 0; e < (long)a.linhas * a.colunas; e++)
+    {
+        for (int l = 0; l < a.lote; l++)
+        {
+            maxima = fmaxf(maxima, fabsf(a.Re[e * a.passo + l] - b.Re[e * b.passo + l]));
+            maxima = fmaxf(maxima, fabsf(a.Im[e * a.passo + l] - b.Im[e * b.passo + l]));
+        }
+    }
+
+    return maxima;
+}
+
+//! Products computed by the nested-call check, one per item of the outer loop
+typedef struct
+{
+    complexMatrix a, b;
+    complexMatrix *destinos;
+} testeParaleloAninhado;
+
+/**
+ * @brief Item of the outer loop of the nested-call check: a parallel product called from inside a range.
+ */
+static void testeParaleloAninhadoItens(void *contexto, long inicio, long fim)
+{
+    const testeParaleloAninhado *c = (const testeParaleloAninhado *)contexto;
+
+    for (long i = inicio; i < fim; i++)
+    {
+        matrixProdutoParaleloEm(c->destinos[i], c->a, c->b);
+    }
+}
+
+/**
+ * @brief Checks every parallel operation against its serial version on a forced 4-thread pool.
+ *
+ * The shapes are large enough for every call to go through the pool, and the operations are run
+ * several times in a row, so the per-call reset of the deques is exercised too. The last checks call
+ * a parallel product from inside a range of the pool, which must run serially instead of waiting for
+ * the pool it is running on, and restart the pool.
+ *
+ * @return The number of failed checks.
+ */
+int teste_paralelo(void)
+{
+    const int linhas = 600, colunas = 520, interna = 96;
+    const int lote = 4096;
+    const int aninhados = 8;
+    int falhas = 0;
+
+    printf("\n  ============ Teste do pool de threads (4 threads) ============ \n\n");
+
+    paraleloFree();
+    if (paraleloInit(4) != 0 || paraleloNumThreads() != 4)
+    {
+        printf("Falha ao iniciar o pool de threads\n");
+        return 1;
+    }
+
+    complexMatrix A = allocateComplexMatrix(linhas, colunas);
+    complexMatrix B = allocateComplexMatrix(linhas, colunas);
+    complexMatrix serial = allocateComplexMatrix(linhas, colunas);
+    complexMatrix paralelo = allocateComplexMatrix(linhas, colunas);
+    complexMatrix serialT = allocateComplexMatrix(colunas, linhas);
+    complexMatrix paraleloT = allocateComplexMatrix(colunas, linhas);
+    complexMatrix P = allocateComplexMatrix(colunas, interna);
+    complexMatrix serialP = allocateComplexMatrix(linhas, interna);
+    complexMatrix paraleloP = allocateComplexMatrix(linhas, interna);
+
+    testePreenche(A, 1);
+    testePreenche(B, 2);
+    testePreenche(P, 3);
+
+    for (int repeticao = 0; repeticao < 3; repeticao++)
+    {
+        int status;
+        float diferenca;
+
+        matrixSomaEm(serial, A, B);
+        status = matrixSomaParaleloEm(paralelo, A, B);
+        diferenca = testeDiferenca(serial, paralelo);
+        falhas += testeConfere("matrixSomaParaleloEm", status == 0 && diferenca <= 0.0f, "diferenca %.2e", diferenca);
+
+        matrixSubtracaoEm(serial, A, B);
+        status = matrixSubtracaoParaleloEm(paralelo, A, B);
+        diferenca = testeDiferenca(serial, paralelo);
+        falhas += testeConfere("matrixSubtracaoParaleloEm", status == 0 && diferenca <= 0.0f, "diferenca %.2e", diferenca);
+
+        matrix_produtoEscalarEm(serial, A, 2.5f);
+        status = matrix_produtoEscalarParaleloEm(paralelo, A, 2.5f);
+        diferenca = testeDiferenca(serial, paralelo);
+        falhas += testeConfere("matrix_produtoEscalarParaleloEm", status == 0 && diferenca <= 0.0f, "diferenca %.2e", diferenca);
+
+        matrixConjugadaEm(serial, A);
+        status = matrixConjugadaParaleloEm(paralelo, A);
+        diferenca = testeDiferenca(serial, paralelo);
+        falhas += testeConfere("matrixConjugadaParaleloEm", status == 0 && diferenca <= 0.0f, "diferenca %.2e", diferenca);
+
+        matrixTranspostaEm(serialT, A);
+        status = matrixTranspostaParaleloEm(paraleloT, A);
+        diferenca = testeDiferenca(serialT, paraleloT);
+        falhas += testeConfere("matrixTranspostaParaleloEm", status == 0 && diferenca <= 0.0f, "diferenca %.2e", diferenca);
+
+        matrixHermitianaEm(serialT, A);
+        status = matrixHermitianaParaleloEm(paraleloT, A);
+        diferenca = testeDiferenca(serialT, paraleloT);
+        falhas += testeConfere("matrixHermitianaParaleloEm", status == 0 && diferenca <= 0.0f, "diferenca %.2e", diferenca);
+
+        matrixProdutoEm(serialP, A, P);
+        status = matrixProdutoParaleloEm(paraleloP, A, P);
+        diferenca = testeDiferenca(serialP, paraleloP);
+        falhas += testeConfere("matrixProdutoParaleloEm", status == 0 && diferenca <= 1e-4f, "diferenca %.2e", diferenca);
+    }
+
+    //! Batches of 4x3 channels: every batched operation against its serial version
+    complexMatrixLote H = allocateComplexMatrixLote(lote, 4, 3);
+    complexMatrixLote G = allocateComplexMatrixLote(lote, 3, 4);
+    complexMatrixLote Q = allocateComplexMatrixLote(lote, 4, 4);
+    complexMatrixLote serialL = allocateComplexMatrixLote(lote, 4, 3);
+    complexMatrixLote paraleloL = allocateComplexMatrixLote(lote, 4, 3);
+    complexMatrixLote serialQ = allocateComplexMatrixLote(lote, 4, 4);
+    complexMatrixLote paraleloQ = allocateComplexMatrixLote(lote, 4, 4);
+    complexMatrixLote serialH = allocateComplexMatrixLote(lote, 3, 4);
+    complexMatrixLote paraleloH = allocateComplexMatrixLote(lote, 3, 4);
+    complexMatrixLote serialG = allocateComplexMatrixLote(lote, 3, 3);
+    complexMatrixLote paraleloG = allocateComplexMatrixLote(lote, 3, 3);
+    complexMatrixLote serialV = allocateComplexMatrixLote(lote, 3, 3);
+    complexMatrixLote paraleloV = allocateComplexMatrixLote(lote, 3, 3);
+    float *serialS = (float *)calloc((size_t)3 * H.passo, sizeof(float));
+    float *paraleloS = (float *)calloc((size_t)3 * H.passo, sizeof(float));
+
+    if (serialS == NULL || paraleloS == NULL)
+    {
+        printf("Falha na alocacao de memoria\n");
+        exit(1);
+    }
+
+    {
+        complexMatrix h = allocateComplexMatrix(4, 3);
+        complexMatrix g = allocateComplexMatrix(3, 4);
+        complexMatrix q = allocateComplexMatrix(4, 4);
+
+        for (int b = 0; b < lote; b++)
+        {
+            testePreenche(h, 10 + 3 * (unsigned)b);
+            testePreenche(g, 11 + 3 * (unsigned)b);
+            testePreenche(q, 12 + 3 * (unsigned)b);
+            loteCarregaMatrix(H, b, h);
+            loteCarregaMatrix(G, b, g);
+            loteCarregaMatrix(Q, b, q);
+        }
+
+        freeComplexMatrix(h);
+        freeComplexMatrix(g);
+        freeComplexMatrix(q);
+    }
+
+    for (int repeticao = 0; repeticao < 2; repeticao++)
+    {
+        int status;
+        float diferenca;
+
+        loteSomaEm(serialL, H, H);
+        status = loteSomaParaleloEm(paraleloL, H, H);
+        diferenca = testeParaleloDiferencaLote(serialL, paraleloL);
+        falhas += testeConfere("loteSomaParaleloEm", status == 0 && diferenca <= 0.0f, "diferenca %.2e", diferenca);
+
+        loteProdutoEm(serialQ, H, G);
+        status = loteProdutoParaleloEm(paraleloQ, H, G);
+        diferenca = testeParaleloDiferencaLote(serialQ, paraleloQ);
+        falhas += testeConfere("loteProdutoParaleloEm", status == 0 && diferenca <= 0.0f, "diferenca %.2e", diferenca);
+
+        loteHermitianaEm(serialH, H);
+        status = loteHermitianaParaleloEm(paraleloH, H);
+        diferenca = testeParaleloDiferencaLote(serialH, paraleloH);
+        falhas += testeConfere("loteHermitianaParaleloEm", status == 0 && diferenca <= 0.0f, "diferenca %.2e", diferenca);
+
+        loteGramEm(serialG, H);
+        status = loteGramParaleloEm(paraleloG, H);
+        diferenca = testeParaleloDiferencaLote(serialG, paraleloG);
+        falhas += testeConfere("loteGramParaleloEm", status == 0 && diferenca <= 0.0f, "diferenca %.2e", diferenca);
+
+        loteInversaEm(serialQ, Q);
+        status = loteInversaParaleloEm(paraleloQ, Q);
+        diferenca = testeParaleloDiferencaLote(serialQ, paraleloQ);
+        falhas += testeConfere("loteInversaParaleloEm", status == 0 && diferenca <= 0.0f, "diferenca %.2e", diferenca);
+
+        loteSVDEm(serialL, serialS, serialV, H);
+        status = loteSVDParaleloEm(paraleloL, paraleloS, paraleloV, H);
+        {
+            diferenca = fmaxf(testeParaleloDiferencaLote(serialL, paraleloL), testeParaleloDiferencaLote(serialV, paraleloV));
+
+            for (int i = 0; i < 3; i++)
+            {
+                for (int l = 0; l < lote; l++)
+                {
+                    diferenca = fmaxf(diferenca, fabsf(serialS[i * H.passo + l] - paraleloS[i * H.passo + l]));
+                }
+            }
+            falhas += testeConfere("loteSVDParaleloEm", status == 0 && diferenca <= 0.0f, "diferenca %.2e", diferenca);
+        }
+    }
+
+    //! A parallel product called from inside a range must run serially on that thread
+    {
+        const int n = 72;
+        testeParaleloAninhado contexto;
+        complexMatrix esperado = allocateComplexMatrix(n, n);
+        complexMatrix destinos[8];
+        float diferenca = 0.0f;
+
+        contexto.a = matrixView(A, 0, 0, n, n);
+        contexto.b = matrixView(B, 0, 0, n, n);
+        contexto.destinos = destinos;
+        for (int i = 0; i < aninhados; i++)
+        {
+            destinos[i] = allocateComplexMatrix(n, n);
+        }
+
+        matrixProdutoEm(esperado, contexto.a, contexto.b);
+        paraleloPara(aninhados, (long)n * n * n, testeParaleloAninhadoItens, &contexto);
+
+        for (int i = 0; i < aninhados; i++)
+        {
+            diferenca = fmaxf(diferenca, testeDiferenca(esperado, destinos[i]));
+            freeComplexMatrix(destinos[i]);
+        }
+        freeComplexMatrix(esperado);
+
+        falhas += testeConfere("chamada aninhada", diferenca <= 1e-4f, "diferenca %.2e", diferenca);
+    }
+
+    //! Restarting the pool gives the same results
+    paraleloFree();
+    paraleloInit(4);
+    matrixProdutoEm(serialP, A, P);
+    {
+        const int status = matrixProdutoParaleloEm(paraleloP, A, P);
+        const float diferenca = testeDiferenca(serialP, paraleloP);
+
+        falhas += testeConfere("reinicio do pool", status == 0 && diferenca <= 1e-4f, "diferenca %.2e", diferenca);
+    }
+    paraleloFree();
+
+    free(serialS);
+    free(paraleloS);
+    freeComplexMatrixLote(H);
+    freeComplexMatrixLote(G);
+    freeComplexMatrixLote(Q);
+    freeComplexMatrixLote(serialL);
+    freeComplexMatrixLote(paraleloL);
+    freeComplexMatrixLote(serialQ);
+    freeComplexMatrixLote(paraleloQ);
+    freeComplexMatrixLote(serialH);
+    freeComplexMatrixLote(paraleloH);
+    freeComplexMatrixLote(serialG);
+    freeComplexMatrixLote(paraleloG);
+    freeComplexMatrixLote(serialV);
+    freeComplexMatrixLote(paraleloV);
+    freeComplexMatrix(A);
+    freeComplexMatrix(B);
+    freeComplexMatrix(serial);
+    freeComplexMatrix(paralelo);
+    freeComplexMatrix(serialT);
+    freeComplexMatrix(paraleloT);
+    freeComplexMatrix(P);
+    freeComplexMatrix(serialP);
+    freeComplexMatrix(paraleloP);
+
+    return falhas;
+}
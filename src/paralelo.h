@@ -0,0 +1,142 @@
+/**
+ * @file paralelo.h
+ * @brief Header file for the persistent thread pool and the parallel matrix operations.
+ */
+
+#ifndef PARALELO_H
+#define PARALELO_H
+#include "matrizes.h"
+#include "matrizes_lote.h"
+
+/*!
+* @brief Minimum estimated work (in multiply-adds or element moves) of a task.
+*
+* Work below twice this value runs serially on the calling thread, so small matrices (a 4x3
+* channel, an 8x8 product) never pay for waking the pool.
+*/
+#define PARALELO_TRABALHO_MINIMO (1L << 17)
+
+/*!
+* @brief Function run by the pool over the items [inicio, fim) of a parallel loop.
+*/
+typedef void (*paraleloFuncao)(void *contexto, long inicio, long fim);
+
+///****************************************** THREAD POOL ****************************************************/
+
+/**
+ * @brief Starts the pool with the given number of threads (the calling thread counts as one).
+ *
+ * Calling it is optional: the first parallel operation starts the pool with one thread per core.
+ *
+ * @param numThreads Number of threads, or 0 for one per online core.
+ * @return 0 on success (or if the pool is already running), -1 if the threads could not be created.
+ */
+int paraleloInit(int numThreads);
+
+/**
+ * @brief Stops and joins the threads of the pool.
+ */
+void paraleloFree(void);
+
+/**
+ * @brief Returns the number of threads of the pool (1 before it is started).
+ */
+int paraleloNumThreads(void);
+
+/**
+ * @brief Runs funcao over the items [0, numItens) on the pool and returns when all of them are done.
+ *
+ * The items are split into contiguous ranges that are spread over per-thread deques; idle threads
+ * steal ranges from the others. Work below 2 * PARALELO_TRABALHO_MINIMO, and calls made from inside
+ * a task, run serially on the calling thread.
+ *
+ * @param numItens Number of items.
+ * @param custoPorItem Estimated work of one item, used for the grain size.
+ * @param funcao The function run over each range.
+ * @param contexto Argument passed to funcao.
+ */
+void paraleloPara(long numItens, long custoPorItem, paraleloFuncao funcao, void *contexto);
+
+///****************************************** PARALLEL OPERATIONS ****************************************************/
+///
+///-----> Same contracts and return codes as the serial *Em functions they split (matrizes.h and matrizes_lote.h).
+///-----> Matrices are split into row or column views, batches into views of whole lane groups.
+///
+
+/**
+ * @brief Parallel matrixProdutoEm.
+ */
+int matrixProdutoParaleloEm(complexMatrix destino, complexMatrix matrix1, complexMatrix matrix2);
+
+/**
+ * @brief Parallel matrixSomaEm.
+ */
+int matrixSomaParaleloEm(complexMatrix destino, complexMatrix matrix1, complexMatrix matrix2);
+
+/**
+ * @brief Parallel matrixSubtracaoEm.
+ */
+int matrixSubtracaoParaleloEm(complexMatrix destino, complexMatrix matrix1, complexMatrix matrix2);
+
+/**
+ * @brief Parallel matrix_produtoEscalarEm.
+ */
+int matrix_produtoEscalarParaleloEm(complexMatrix destino, complexMatrix matrix, float num);
+
+/**
+ * @brief Parallel matrixConjugadaEm.
+ */
+int matrixConjugadaParaleloEm(complexMatrix destino, complexMatrix matrix);
+
+/**
+ * @brief Parallel matrixTranspostaEm.
+ */
+int matrixTranspostaParaleloEm(complexMatrix destino, complexMatrix matrix);
+
+/**
+ * @brief Parallel matrixHermitianaEm.
+ */
+int matrixHermitianaParaleloEm(complexMatrix destino, complexMatrix matrix);
+
+/**
+ * @brief Parallel loteSomaEm.
+ */
+int loteSomaParaleloEm(complexMatrixLote destino, complexMatrixLote matrix1, complexMatrixLote matrix2);
+
+/**
+ * @brief Parallel loteProdutoEm.
+ */
+int loteProdutoParaleloEm(complexMatrixLote destino, complexMatrixLote matrix1, complexMatrixLote matrix2);
+
+/**
+ * @brief Parallel loteHermitianaEm.
+ */
+int loteHermitianaParaleloEm(complexMatrixLote destino, complexMatrixLote matrix);
+
+/**
+ * @brief Parallel loteGramEm.
+ */
+int loteGramParaleloEm(complexMatrixLote destino, complexMatrixLote matrix);
+
+/**
+ * @brief Parallel loteInversaEm.
+ */
+int loteInversaParaleloEm(complexMatrixLote destino, complexMatrixLote matrix);
+
+/**
+ * @brief Parallel loteSVDEm.
+ */
+int loteSVDParaleloEm(complexMatrixLote U, float *S, complexMatrixLote Vh, complexMatrixLote matrix);
+
+///****************************************** TESTS ****************************************************/
+
+/**
+ * @brief Checks every parallel operation against its serial version on a forced 4-thread pool.
+ *
+ * Prints one OK/FALHOU line per check and stops the pool before returning.
+ *
+ * @return The number of failed checks.
+ */
+int teste_paralelo(void);
+
+#endif
@@ -1,144 +1,437 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <time.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <errno.h>
+#include <float.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 #include "pds_telecom.h"
 #include "matrizes.h"
+#include "memoria.h"
+#include "ponto_fixo.h"
+#include "teste.h"
 
 
+/**
+ * @brief Aloca um vetor de símbolos de 2 bits empacotados
+ * 
+ * Os bytes são zerados, então símbolos além dos escritos valem 0. Além dos num_simbolos, a capacidade
+ * reserva TX_RESERVA_PADDING símbolos, então o padding de tx_data_padding não precisa realocar.
+ * 
+ * @param [in] num_simbolos Número de símbolos
+ * @return O vetor; em caso de falha na alocação, bytes é NULL
+*/
+tx_simbolos tx_simbolos_alloc(long int num_simbolos) {
+    tx_simbolos simbolos;
+
+    simbolos.num_simbolos = num_simbolos;
+    simbolos.capacidade = num_simbolos + TX_RESERVA_PADDING;
+    simbolos.bytes = (unsigned char *)calloc((size_t)TX_SIMBOLOS_BYTES(simbolos.capacidade), 1);
+
+    if (simbolos.bytes == NULL) {
+        printf("Erro na alocação de memória\n");
+    }
+
+    return simbolos;
+}
+
+/**
+ * @brief Libera um vetor de símbolos empacotados
+ * 
+ * @param simbolos O vetor a ser liberado
+*/
+void tx_simbolos_free(tx_simbolos simbolos) {
+    free(simbolos.bytes);
+}
+
+/**
+ * @brief Prepara a leitura em blocos de um arquivo
+ * 
+ * O leitor não guarda buffer próprio: cada bloco é lido com uma única chamada a fread direto no vetor
+ * de símbolos do chamador, já no formato empacotado. A memória usada não depende do tamanho do arquivo.
+ * 
+ * @param [out] leitor O leitor a ser inicializado
+ * @param [in] file O arquivo aberto para leitura binária (continua sendo do chamador)
+ * @param [in] simbolos_por_bloco Número de símbolos de 2 bits por bloco (arredondado para cima para um múltiplo de 4)
+ * @return 0 em caso de sucesso, -1 se o tamanho do bloco for inválido
+*/
+int tx_leitor_init(tx_leitor *leitor, FILE *file, long int simbolos_por_bloco) {
+    leitor->arquivo = file;
+    leitor->bytes_por_bloco = TX_SIMBOLOS_BYTES(simbolos_por_bloco);
+
+    return (simbolos_por_bloco > 0) ? 0 : -1;
+}
+
+/**
+ * @brief Lê o próximo bloco do arquivo como símbolos de 2 bits empacotados
+ * 
+ * Nunca são lidos mais bytes do que cabem em bloco->capacidade símbolos, então um vetor menor que
+ * um bloco (por exemplo o fim do vetor de tx_data_read) recebe só o que cabe nele.
+ * 
+ * Um bloco incompleto só é devolvido no fim do arquivo: leituras curtas no meio dele (pipes, leituras
+ * interrompidas por sinais) são repetidas até completar o bloco.
+ * 
+ * @param leitor O leitor inicializado por tx_leitor_init
+ * @param [out] bloco Vetor de destino; num_simbolos recebe o número de símbolos lidos
+ * @return O número de símbolos lidos: 4 * bytes_por_bloco (ou a capacidade do bloco, se for menor),
+ * menos no último bloco, 0 no fim do arquivo e -1 se houver um erro de leitura
+*/
+long int tx_leitor_proximo_bloco(tx_leitor *leitor, tx_simbolos *bloco) {
+    long int bytes = leitor->bytes_por_bloco;
+
+    if (bloco->capacidade / 4 < bytes) {
+        bytes = bloco->capacidade / 4; // Só o que cabe no vetor de destino
+    }
+
+    size_t lidos = 0;
+
+    while (lidos < (size_t)bytes) {
+        size_t n = fread(bloco->bytes + lidos, 1, (size_t)bytes - lidos, leitor->arquivo);
+        lidos += n;
+
+        if (ferror(leitor->arquivo)) {
+            if (errno != EINTR) {
+                bloco->num_simbolos = (long int)lidos * 4;
+                return -1;
+            }
+            clearerr(leitor->arquivo); // Interrompida por um sinal: tenta de novo
+        } else if (n == 0 || feof(leitor->arquivo)) {
+            break; // Fim do arquivo
+        }
+    }
+
+    bloco->num_simbolos = (long int)lidos * 4;
+
+    return bloco->num_simbolos;
+}
+
 /**
  * @brief Ler a mensagem e um arquivo e converte para um vetor
  * 
  * O objetivo da função em questão é abrir um arquivo de texto para ler seu conteúdo em binário para então converter os dados binários
- * em um vetor de inteiros, onde cada caracter inteiro equivale a 2 bits.
+ * em um vetor de símbolos de 2 bits. Os símbolos ficam empacotados, 4 por byte, no mesmo formato do
+ * arquivo, então a leitura é só uma cópia feita em blocos de TX_BLOCO_LEITURA bytes; para arquivos
+ * grandes, use o tx_leitor diretamente e processe um bloco por vez.
  * 
  * @param file o ponteiro do arquivo será lido
  * @param sequencia_bytes é o número total de bytes do arquivo
- * @param [out] vetor_inteiro O retorno da função é o ponteiro do vetor convertido em questão 
+ * @return O vetor com 4 * sequencia_bytes símbolos; em caso de erro, bytes é NULL
  * 
 */
 
-int *tx_data_read(FILE *file, long int sequencia_bytes) {
+tx_simbolos tx_data_read(FILE *file, long int sequencia_bytes) {
     
-    int *vetor_inteiro = (int *)malloc(sequencia_bytes * 4 * sizeof(int)); // Aloca memória para o array de inteiros
+    tx_simbolos simbolos = tx_simbolos_alloc(sequencia_bytes * 4); // Aloca memória para os símbolos
 
-    if (vetor_inteiro == NULL) { // Verifica se houve falha na alocação de memória
-        printf("Erro na alocação de memória\n");
+    if (simbolos.bytes == NULL) { // Verifica se houve falha na alocação de memória
         fclose(file); // Fecha o arquivo
-        return NULL; // Retorna NULL em caso de erro
+        return simbolos; // Retorna bytes NULL em caso de erro
     }
-    
-    // Lê os bytes do arquivo e converte em inteiros de 2 bits
-    int index = 0; // Variável para rastrear a posição atual no array 's'
-    for (int i = 0; i < sequencia_bytes; i++) {
-        
-        char byte;
-        fread(&byte, sizeof(byte), 1, file); // Lê um byte do arquivo
-        
-        for (int j = 0; j <= 6; j += 2) { // Loop para processar os bits do byte
-            int bit = (byte >> j) & 0x03; // Extrai o bit correspondente do byte usando deslocamento à direita e uma máscara
-            vetor_inteiro[index++] = bit; // Atribui o bit à posição correta no array 's' e incrementa o índice
+
+    tx_leitor leitor;
+    tx_leitor_init(&leitor, file, 4 * TX_BLOCO_LEITURA);
+
+    // Lê o arquivo bloco a bloco, direto na posição de cada bloco no vetor; a capacidade da view
+    // é o espaço que resta, então o último bloco nunca passa do fim do vetor
+    long int index = 0; // Posição atual, em bytes
+    while (index < sequencia_bytes) {
+        tx_simbolos bloco = {simbolos.bytes + index, 0, 4 * (sequencia_bytes - index)};
+
+        long int lidos = tx_leitor_proximo_bloco(&leitor, &bloco);
+
+        if (lidos < 0) { // Erro de leitura: o vetor incompleto não é devolvido
+            printf("Erro na leitura do arquivo\n");
+            tx_simbolos_free(simbolos);
+            simbolos.bytes = NULL;
+            fclose(file);
+            return simbolos;
+        }
+        if (lidos == 0) {
+            break;
         }
+
+        index += bloco.num_simbolos / 4;
     }
 
-    return vetor_inteiro; // Retorna o array de inteiros
+    return simbolos; // Retorna o vetor de símbolos
 }
 
 /**
- * @brief A função preenche o vetor de inteiros com zeros.
+ * @brief A função preenche o vetor de símbolos com zeros.
  * 
- * O objetivo desse preenchimento, ou padding, é garantir que o vetor de inteiros
+ * O objetivo desse preenchimento, ou padding, é garantir que o vetor de símbolos
  * sempre seja do tamanho de um múltiplo inteiro de um determinado número de streams.
- * Se o número de bytes já cumprir essa condição, a função é retornada sem alteração. Caso
- * contrário,a função cria um novo vetor com o tamanho ajustado para acomodar os zeros adicionais.
+ * O padding é escrito no próprio vetor, dentro da capacidade reservada por tx_simbolos_alloc, então
+ * custa O(padding): só os símbolos novos são zerados. Se a reserva não bastar, o vetor cresce com
+ * realloc (que libera o original).
  * 
- * @param padding O número de zeros que devem ser adicionados
- * @param vetor_inteiro O ponteiro para o vetor de inteiros
- * @param num_streams O número de streams
- * @param sequencia_bytes O número total de bytes do arquivo
- * @param [out] novo_tamanho_vetor Um ponteiro com a tamanho ajustado para o vetor de inteiros
+ * @param padding O número de símbolos zero que devem ser adicionados
+ * @param simbolos O vetor de símbolos empacotados; depois da chamada, use apenas o vetor retornado
+ * @return O vetor com o padding; em caso de falha na alocação, bytes é NULL e o vetor original continua válido
 */
 
-int *tx_data_padding(int padding, int *vetor_inteiro, long int sequencia_bytes) {
+tx_simbolos tx_data_padding(int padding, tx_simbolos simbolos) {
     // Verifica se o número de bytes já é um múltiplo do número de streams.
     if (padding == 0) {
 
-        return vetor_inteiro; // Retorna o array original sem alterações.
+        return simbolos; // Retorna o vetor original sem alterações.
     
-    } else {
+    }
 
-        // Calcula o novo tamanho do array de inteiros, levando em conta o padding.
-        long int novo_tamanho = sequencia_bytes * 4 + padding;
+    long int novo_tamanho = simbolos.num_simbolos + padding;
 
-        // Aloca memória para o novo array de inteiros.
-        int *novo_tamanho_vetor = (int *)malloc(novo_tamanho * sizeof(int));
-        if (novo_tamanho_vetor == NULL) {
-            return NULL; // Retorna NULL em caso de erro na alocação de memória.
-        }
+    if (novo_tamanho > simbolos.capacidade) {
+        // Sem reserva suficiente: cresce o vetor, já com uma nova reserva
+        long int capacidade = novo_tamanho + TX_RESERVA_PADDING;
+        unsigned char *bytes = (unsigned char *)realloc(simbolos.bytes, (size_t)TX_SIMBOLOS_BYTES(capacidade));
 
-        // Copia os elementos do array original para o novo array de tamanho ajustado.
-        for (long int i = 0; i < sequencia_bytes * 4; i++) {
-            novo_tamanho_vetor[i] = vetor_inteiro[i];
+        if (bytes == NULL) {
+            printf("Erro na alocação de memória\n");
+            tx_simbolos falha = {NULL, 0, 0};
+            return falha; // Retorna bytes NULL em caso de erro na alocação de memória.
         }
 
-        // Preenche o espaço adicional com zeros (representados pelo inteiro 0).
-        for (long int i = sequencia_bytes * 4; i < novo_tamanho; i++) {
-            novo_tamanho_vetor[i] = 0;
+        simbolos.bytes = bytes;
+        simbolos.capacidade = capacidade;
+    }
+
+    // Zera só o padding: os bits livres do último byte ocupado e os bytes seguintes.
+    long int ocupados = TX_SIMBOLOS_BYTES(simbolos.num_simbolos);
+    if (simbolos.num_simbolos % 4 != 0) {
+        simbolos.bytes[ocupados - 1] &= (unsigned char)((1u << (2 * (simbolos.num_simbolos % 4))) - 1);
+    }
+    memset(simbolos.bytes + ocupados, 0, (size_t)(TX_SIMBOLOS_BYTES(novo_tamanho) - ocupados));
+
+    simbolos.num_simbolos = novo_tamanho;
+
+    return simbolos; // Retorna o vetor com o padding realizado.
+}
+
+/**
+ * @brief Número de bits por ponto de uma constelação QAM suportada
+ * 
+ * @param qam Ordem da constelação
+ * @return 2, 4, 6 ou 8 para 4, 16, 64 ou 256-QAM; 0 para qualquer outra ordem
+*/
+static int tx_qam_bits(long int qam) {
+    switch (qam) {
+        case 4: return 2;
+        case 16: return 4;
+        case 64: return 6;
+        case 256: return 8;
+        default: return 0;
+    }
+}
+
+/**
+ * @brief Monta as tabelas dos eixos de uma constelação QAM com mapeamento de Gray
+ * 
+ * Com k = bits / 2, os k bits altos de um ponto escolhem a parte real e os k bits baixos a parte
+ * imaginária, cada eixo em Gray: vizinhos no eixo diferem em um só bit. A escala 1/sqrt(2(M-1)/3)
+ * dá potência média unitária. Para 4-QAM isso é a constelação original (bit alto 0 -> Re -1,
+ * bit baixo 0 -> Im +1), dividida por sqrt(2).
+ * 
+ * @param [in] bits Bits por ponto (2, 4, 6 ou 8)
+ * @param [out] eixo_re Tabela com 2^(bits/2) posições, indexada pelos bits altos
+ * @param [out] eixo_im Tabela com 2^(bits/2) posições, indexada pelos bits baixos
+*/
+static void tx_qam_eixos(int bits, float *eixo_re, float *eixo_im) {
+    int niveis = 1 << (bits / 2);
+    long int qam = 1L << bits;
+    float escala = 1.0f / sqrtf(2.0f * (float)(qam - 1) / 3.0f);
+
+    for (int g = 0; g < niveis; g++) {
+        // Decodifica o Gray: posição do nível no eixo
+        int nivel = g;
+        for (int deslocado = g >> 1; deslocado != 0; deslocado >>= 1) {
+            nivel ^= deslocado;
         }
 
-        return novo_tamanho_vetor; // Retorna o novo array com o padding realizado.
+        eixo_re[g] = (float)(2 * nivel - (niveis - 1)) * escala;
+        eixo_im[g] = (float)((niveis - 1) - 2 * nivel) * escala;
+    }
+}
+
+/**
+ * @brief Escreve os pontos de uma constelação QAM de Gray com potência unitária
+ * 
+ * O ponto de índice v (os bits de um símbolo QAM, lidos do fluxo a partir do menos significativo)
+ * vai para pontos[v]. É a tabela usada pelos mapeadores e pelos demapeadores.
+ * 
+ * @param [in] qam Ordem da constelação (4, 16, 64 ou 256)
+ * @param [out] pontos Vetor com qam posições
+ * @return 0 em caso de sucesso, -1 se a ordem não for suportada
+*/
+int tx_qam_constelacao(long int qam, complex *pontos) {
+    int bits = tx_qam_bits(qam);
+    float eixo_re[16], eixo_im[16];
+
+    if (bits == 0) {
+        return -1;
+    }
+
+    tx_qam_eixos(bits, eixo_re, eixo_im);
+
+    for (long int v = 0; v < qam; v++) {
+        pontos[v].Re = eixo_re[v >> (bits / 2)];
+        pontos[v].Im = eixo_im[v & ((1 << (bits / 2)) - 1)];
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Número de pontos QAM formados por um vetor de símbolos de 2 bits
+ * 
+ * Bits que não completam um ponto no fim do vetor são ignorados (o padding deve completá-los).
+ * 
+ * @param [in] num_simbolos Número de símbolos de 2 bits
+ * @param [in] qam Ordem da constelação (4, 16, 64 ou 256)
+ * @return O número de pontos, ou -1 se a ordem não for suportada
+*/
+long int tx_qam_pontos(long int num_simbolos, long int qam) {
+    int bits = tx_qam_bits(qam);
+
+    return (bits == 0) ? -1 : 2 * num_simbolos / bits;
+}
+
+/**
+ * @brief Lê os bits do ponto QAM de índice p
+ * 
+ * Lê o segundo byte só quando o ponto o atravessa (64-QAM), então nunca passa do fim do vetor.
+ */
+static inline int tx_qam_indice(tx_simbolos simbolos, long int p, int bits) {
+    long int posicao = p * bits;
+    unsigned int valor = simbolos.bytes[posicao >> 3];
+
+    if ((posicao & 7) + bits > 8) {
+        valor |= (unsigned int)simbolos.bytes[(posicao >> 3) + 1] << 8;
     }
+
+    return (int)((valor >> (posicao & 7)) & ((1u << bits) - 1));
 }
 
 /**
  * @brief A função faz o mapeamento dos valores binários em QAM
  * 
  * Primeiro a função se preocupa em alocar dinamicamente a memória para um vetor
- * complex e em seguida percorre cada elemento do vetor de inteiros e realiza o
- * mapeamento correspondente para o vetor complex
+ * complex e em seguida mapeia os símbolos com tx_qam_mapper_em
  * 
- * @param [in] vetor_inteiro O ponteiro para o vetor de inteiros
- * @param [in] tam_vetor_qam tamanho do vetor qam em bytes
+ * @param [in] simbolos Os símbolos de 2 bits empacotados
+ * @param [in] qam Ordem da constelação (4, 16, 64 ou 256)
  * @param [out] simbolo Um ponteiro para o array que armazena os simbolos qam após o mapeamento
+ * (tx_qam_pontos(simbolos.num_simbolos, qam) posições); NULL se a ordem não for suportada
  * 
 */
 
 // Função para mapear os índices para números complexs QAM
-complex *tx_qam_mapper(int *vetor_inteiro, long int tam_vetor_qam) {
-    
-    complex *simbolo = (complex *)malloc(tam_vetor_qam * sizeof(complex)); // Aloca memória para o vetor de complexs
+complex *tx_qam_mapper(tx_simbolos simbolos, long int qam) {
+    long int num_pontos = tx_qam_pontos(simbolos.num_simbolos, qam);
+
+    if (num_pontos < 0) { // Verifica se a ordem da constelação é suportada
+        printf("Ordem de QAM não suportada: %ld\n", qam);
+        return NULL;
+    }
+
+    complex *simbolo = (complex *)malloc(num_pontos * sizeof(complex)); // Aloca memória para o vetor de complexs
 
     if (simbolo == NULL) { // Verifica se houve falha na alocação de memória
         printf("Erro na alocação de memória\n");
         return NULL; // Retorna NULL em caso de erro
     }
 
-    // Mapeia os índices para os números complexs da constelação QAM
-    for (int i = 0; i < tam_vetor_qam; i++) {
-        switch (vetor_inteiro[i]) {
-            case 0:
-                simbolo[i].Re = -1;
-                simbolo[i].Im = 1;
-                break;
-            case 1:
-                simbolo[i].Re = -1;
-                simbolo[i].Im = -1;
-                break;
-            case 2:
-                simbolo[i].Re = 1;
-                simbolo[i].Im = 1;
-                break;
-            case 3:
-                simbolo[i].Re = 1;
-                simbolo[i].Im = -1;
-                break;
-            default:
-                simbolo[i].Re = 0;
-                simbolo[i].Im = 0;
-                break;
+    tx_qam_mapper_em(simbolos, qam, simbolo);
+
+    return simbolo; // Retorna o vetor de complexs
+}
+
+/**
+ * @brief Faz o mapeamento QAM escrevendo em um vetor fornecido pelo chamador
+ * 
+ * Versão sem alocação de tx_qam_mapper: o vetor de saída pode vir, por exemplo, da arena do quadro.
+ * Cada ponto usa os próximos log2(qam) bits do fluxo e sai das tabelas dos eixos da constelação.
+ * Com AVX2, 8 pontos são tratados por iteração sem desvios: os 8 * bits bits são lidos de uma vez,
+ * separados em índices por deslocamentos variáveis, e as coordenadas saem das tabelas por vpermps
+ * (duas tabelas e um blend para os 16 níveis de 256-QAM).
+ * 
+ * @param [in] simbolos Os símbolos de 2 bits empacotados
+ * @param [in] qam Ordem da constelação (4, 16, 64 ou 256)
+ * @param [out] simbolo Vetor com pelo menos tx_qam_pontos(simbolos.num_simbolos, qam) posições
+ * @return 0 em caso de sucesso, -1 se a ordem não for suportada
+*/
+int tx_qam_mapper_em(tx_simbolos simbolos, long int qam, complex *simbolo) {
+    int bits = tx_qam_bits(qam);
+
+    if (bits == 0) {
+        return -1;
+    }
+
+    // Tabelas dos eixos indexadas pelos bits altos (Re) e baixos (Im) do ponto
+    int meio = bits / 2;
+    float eixo_re[16], eixo_im[16];
+    tx_qam_eixos(bits, eixo_re, eixo_im);
+
+    long int num_pontos = tx_qam_pontos(simbolos.num_simbolos, qam);
+    long int num_bytes = TX_SIMBOLOS_BYTES(simbolos.num_simbolos);
+    long int p = 0;
+
+#if defined(__AVX2__)
+    // Os 8 pontos ocupam 'bits' bytes: os pontos 0..3 nos 4 * bits bits baixos, 4..7 nos altos
+    const __m256i deslocamentos = _mm256_setr_epi32(0, bits, 2 * bits, 3 * bits, 0, bits, 2 * bits, 3 * bits);
+    const __m256i mascara = _mm256_set1_epi32((1 << meio) - 1);
+    const __m256i desloca_meio = _mm256_set1_epi32(meio);
+    const __m256 re_baixo = _mm256_loadu_ps(eixo_re), im_baixo = _mm256_loadu_ps(eixo_im);
+    const __m256 re_alto = _mm256_loadu_ps(eixo_re + 8), im_alto = _mm256_loadu_ps(eixo_im + 8);
+    const uint64_t mascara_metade = (1ULL << (4 * bits)) - 1;
+
+    for (; p + 8 <= num_pontos && p / 8 * bits + 8 <= num_bytes; p += 8) {
+        uint64_t palavra;
+        memcpy(&palavra, simbolos.bytes + p / 8 * bits, sizeof(palavra));
+
+        __m256i metades = _mm256_set_m128i(_mm_set1_epi32((int)(uint32_t)((palavra >> (4 * bits)) & mascara_metade)),
+                                           _mm_set1_epi32((int)(uint32_t)(palavra & mascara_metade)));
+
+        // Bits do ponto p + k na posição k, separados nos índices dos dois eixos
+        __m256i indice = _mm256_srlv_epi32(metades, deslocamentos);
+        __m256i indice_im = _mm256_and_si256(indice, mascara);
+        __m256i indice_re = _mm256_and_si256(_mm256_srlv_epi32(indice, desloca_meio), mascara);
+
+        __m256 re = _mm256_permutevar8x32_ps(re_baixo, indice_re);
+        __m256 im = _mm256_permutevar8x32_ps(im_baixo, indice_im);
+
+        if (bits == 8) {
+            // Níveis 8..15: o bit 3 do índice, levado ao bit de sinal, escolhe a segunda tabela
+            re = _mm256_blendv_ps(re, _mm256_permutevar8x32_ps(re_alto, indice_re),
+                                  _mm256_castsi256_ps(_mm256_slli_epi32(indice_re, 28)));
+            im = _mm256_blendv_ps(im, _mm256_permutevar8x32_ps(im_alto, indice_im),
+                                  _mm256_castsi256_ps(_mm256_slli_epi32(indice_im, 28)));
         }
+
+        // Intercala as partes reais e imaginárias no formato de complex
+        __m256 baixo = _mm256_unpacklo_ps(re, im);
+        __m256 alto = _mm256_unpackhi_ps(re, im);
+        _mm256_storeu_ps((float *)(simbolo + p), _mm256_permute2f128_ps(baixo, alto, 0x20));
+        _mm256_storeu_ps((float *)(simbolo + p + 4), _mm256_permute2f128_ps(baixo, alto, 0x31));
     }
+#endif
 
-    return simbolo; // Retorna o vetor de complexs
+    for (; p < num_pontos; p++) {
+        int indice = tx_qam_indice(simbolos, p, bits);
+        simbolo[p].Re = eixo_re[indice >> meio];
+        simbolo[p].Im = eixo_im[indice & ((1 << meio) - 1)];
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Número de colunas das camadas: um símbolo por stream em cada coluna, a última completada com zeros
+ */
+static long int tx_layer_colunas(long int num_simbolo, int num_stream) {
+    return (num_simbolo + num_stream - 1) / num_stream;
 }
 
 /**
@@ -146,16 +439,20 @@ complex *tx_qam_mapper(int *vetor_inteiro, long int tam_vetor_qam) {
  * 
  * Essa função realiza o mapeamento dos dados de um vetor complex em uma matriz complexa, 
  * com o objetivo de dividir os dados em diferentes camadas (streams) para transmissão 
- * ou processamento posterior, retornando um ponteiro para a matriz complexa mapeada
+ * ou processamento posterior, retornando um ponteiro para a matriz complexa mapeada.
+ * Se num_simbolo não for múltiplo de num_stream, a última coluna é completada com zeros.
  * 
  * @param vetor_complex Ponteiro para o vetor complex
  * @param num_stream Número de streams, indicando quantas linhas a matriz resultante terá
  * @param num_simbolo Número de simbolos, indicando quantos elementos serão mapeados na 
  * matriz resultante
- * @param [out] mtx_resultante matriz de complexs resultante devidamente mapeada
+ * @param [out] mtx_resultante matriz de complexs resultante devidamente mapeada, com
+ * ceil(num_simbolo / num_stream) colunas
 */
 
 complex **tx_layer_mapper(complex *vetor_complex, int num_stream, long int num_simbolo) {
+    long int num_colunas = tx_layer_colunas(num_simbolo, num_stream);
+
     // Aloca memória para a matriz de complexs
     complex **mtx_resultante = (complex **)malloc(num_stream * sizeof(complex *));
     
@@ -166,7 +463,7 @@ complex **tx_layer_mapper(complex *vetor_complex, int num_stream, long int num_s
     }
     // Aloca memória para cada linha da matriz de complexs
     for (int i = 0; i < num_stream; i++) {
-        mtx_resultante[i] = (complex *)malloc((num_simbolo / num_stream) * sizeof(complex));
+        mtx_resultante[i] = (complex *)malloc(num_colunas * sizeof(complex));
 
         // Verifica se houve falha na alocação de memória
         if (mtx_resultante[i] == NULL) {
@@ -181,175 +478,1209 @@ complex **tx_layer_mapper(complex *vetor_complex, int num_stream, long int num_s
         }
     }
 
-    // Mapeia os dados do vetor para a matriz de complexs
-    for (int i = 0; i < num_simbolo; i++) {
-        int streamIndex = i % num_stream; // Índice da linha da matriz
-        int symbolIndex = i / num_stream; // Índice da coluna da matriz
-        mtx_resultante[streamIndex][symbolIndex] = vetor_complex[i];
+    // Mapeia os dados do vetor para a matriz de complexs, coluna a coluna, sem divisões
+    long int i = 0;
+    for (long int j = 0; j < num_colunas; j++) {
+        for (int s = 0; s < num_stream; s++, i++) {
+            if (i < num_simbolo) {
+                mtx_resultante[s][j] = vetor_complex[i];
+            } else {
+                mtx_resultante[s][j].Re = 0;
+                mtx_resultante[s][j].Im = 0;
+            }
+        }
     }
 
     return mtx_resultante; // Retorna a matriz de complexs
 }
 
-//Funcao para gerar um numero aleatorio entre -1 e 1
-float gerar_float_aleatorio() {
-    return -1.0 + ((float)rand() / (float)RAND_MAX) * 2.0;
-}
+/**
+ * @brief Visão das camadas sobre o próprio vetor de símbolos, sem cópia
+ * 
+ * O símbolo i vai para a stream i % num_stream, então a stream s é a coluna s de uma matriz
+ * num_simbolo / num_stream x num_stream guardada linha a linha no próprio vetor: cada linha é um
+ * instante de transmissão e a stream é lida com passo num_stream. O mapeamento em camadas não custa
+ * nada; a matriz uma linha por stream de tx_layer_mapper_em é a transposta desta visão.
+ * 
+ * @param vetor_complex Ponteiro para o vetor complex
+ * @param num_stream Número de streams
+ * @param num_simbolo Número de símbolos (múltiplo de num_stream: use o padding antes)
+ * @param [out] camadas A visão, num_simbolo / num_stream x num_stream, que não é dona de nada
+ * @return 0 em caso de sucesso, -1 se num_simbolo não for múltiplo de num_stream
+*/
+int tx_layer_view(complex *vetor_complex, int num_stream, long int num_simbolo, complexMatrix *camadas) {
+    if (num_stream <= 0 || num_simbolo % num_stream != 0) {
+        return -1;
+    }
 
-// Função para escrever os dados no arquivo
-void rx_data_write(int *s, long int sequencia_bytes, char *filename) {
-    FILE *out = fopen(filename, "wb"); // Abre o arquivo para escrita binária
+    *camadas = matrixViewBuffer(vetor_complex, (int)(num_simbolo / num_stream), num_stream, num_stream);
 
-    if (out == NULL) { // Verifica se houve falha na abertura do arquivo
-        printf("Erro ao abrir o arquivo %s.\n", filename);
-        return;
-    } else {
-        printf("\nArquivo %s criado.\n\n", filename);
-    }
+    return 0;
+}
 
-    // Converte os inteiros de 2 bits em bytes e escreve no arquivo
-    for (int i = 0; i < sequencia_bytes; i++) {
-        unsigned char byte = 0;
-        for (int j = 0; j < 4; j++) {
-            unsigned int bit = s[(i * 4) + j];
-            byte |= (bit << (2 * j));
-        }
-        fwrite(&byte, sizeof(byte), 1, out);
-    }
+#if defined(__AVX2__)
+/**
+ * @brief Transpõe 4 x 4 complexs: a, b, c e d são 4 instantes consecutivos de 4 streams
+ * 
+ * Cada complex ocupa 64 bits, então a transposição é a de uma matriz 4 x 4 de doubles.
+ */
+static inline void tx_transpoe_4x4(__m256d a, __m256d b, __m256d c, __m256d d, complex *s0, complex *s1, complex *s2, complex *s3) {
+    __m256d t0 = _mm256_unpacklo_pd(a, b); // a0 b0 | a2 b2
+    __m256d t1 = _mm256_unpackhi_pd(a, b); // a1 b1 | a3 b3
+    __m256d t2 = _mm256_unpacklo_pd(c, d); // c0 d0 | c2 d2
+    __m256d t3 = _mm256_unpackhi_pd(c, d); // c1 d1 | c3 d3
 
-    fclose(out); // Fecha o arquivo
+    _mm256_storeu_pd((double *)s0, _mm256_permute2f128_pd(t0, t2, 0x20));
+    _mm256_storeu_pd((double *)s1, _mm256_permute2f128_pd(t1, t3, 0x20));
+    _mm256_storeu_pd((double *)s2, _mm256_permute2f128_pd(t0, t2, 0x31));
+    _mm256_storeu_pd((double *)s3, _mm256_permute2f128_pd(t1, t3, 0x31));
 }
+#endif
 
-//Funcao para gerar uma matriz que representa um canal aleatorio H
-float** channel_gen(int Nr, int Nt) {
-    
-    float** H = (float**)malloc(Nr * sizeof(float*)); //Aloca memoria para as linhas da matrix
+/**
+ * @brief Faz o mapeamento em camadas escrevendo em uma matriz fornecida pelo chamador
+ * 
+ * Versão sem alocação de tx_layer_mapper: a matriz de destino (uma linha por stream) pode vir
+ * da arena do quadro ou de um pool. Quando a cópia não é necessária, tx_layer_view dá as camadas
+ * sem copiar nada. Para 2, 4 e 8 streams a separação usa AVX2 (4 instantes por iteração, transpostos
+ * como doubles); as outras contagens percorrem o vetor uma vez, sem divisões. Se num_simbolo não for
+ * múltiplo do número de streams, a última coluna é completada com zeros.
+ * 
+ * @param vetor_complex Ponteiro para o vetor complex
+ * @param num_simbolo Número de simbolos a mapear
+ * @param [out] destino Matriz com uma linha por stream e ceil(num_simbolo / linhas) colunas
+ * @return 0 em caso de sucesso, -1 se as dimensões de destino não concordarem
+*/
+int tx_layer_mapper_em(complex *vetor_complex, long int num_simbolo, complexMatrix destino) {
+    int num_stream = destino.linhas;
 
-    if(H == NULL) { //Verifica se a alocacao foi bem sucedida
-        printf("Erro de alocacao de memoria\n");
-        return NULL;
+    if (num_stream <= 0 || destino.colunas != tx_layer_colunas(num_simbolo, num_stream)) {
+        return -1;
     }
 
-    for (int i = 0; i < Nr; i++) { 
-        H[i] = (float*)malloc(Nt * sizeof(float)); //Aloca memoria para as colunas da matriz
+    long int completas = num_simbolo / num_stream; // Colunas sem padding
+    long int j = 0;
 
-        if (H[i] == NULL) {
-            printf("Erro na alocacao de memoria nas colunas\n");
+#if defined(__AVX2__)
+    const double *v = (const double *)vetor_complex;
 
-            //Liberando a memoria em caso de erro
-            for (int j = 0; j < i; j++) {
-                free(H[j]);
+    if (num_stream == 2) {
+        for (; j + 4 <= completas; j += 4) {
+            __m256d a = _mm256_loadu_pd(v + 2 * j);     // instantes j, j + 1
+            __m256d b = _mm256_loadu_pd(v + 2 * j + 4); // instantes j + 2, j + 3
+            _mm256_storeu_pd((double *)(matrixLinha(destino, 0) + j), _mm256_permute4x64_pd(_mm256_unpacklo_pd(a, b), 0xD8));
+            _mm256_storeu_pd((double *)(matrixLinha(destino, 1) + j), _mm256_permute4x64_pd(_mm256_unpackhi_pd(a, b), 0xD8));
+        }
+    } else if (num_stream == 4) {
+        for (; j + 4 <= completas; j += 4) {
+            const double *x = v + 4 * j;
+            tx_transpoe_4x4(_mm256_loadu_pd(x), _mm256_loadu_pd(x + 4), _mm256_loadu_pd(x + 8), _mm256_loadu_pd(x + 12),
+                            matrixLinha(destino, 0) + j, matrixLinha(destino, 1) + j,
+                            matrixLinha(destino, 2) + j, matrixLinha(destino, 3) + j);
+        }
+    } else if (num_stream == 8) {
+        for (; j + 4 <= completas; j += 4) {
+            const double *x = v + 8 * j;
+            // Streams 0..3 na primeira metade de cada instante, 4..7 na segunda
+            tx_transpoe_4x4(_mm256_loadu_pd(x), _mm256_loadu_pd(x + 8), _mm256_loadu_pd(x + 16), _mm256_loadu_pd(x + 24),
+                            matrixLinha(destino, 0) + j, matrixLinha(destino, 1) + j,
+                            matrixLinha(destino, 2) + j, matrixLinha(destino, 3) + j);
+            tx_transpoe_4x4(_mm256_loadu_pd(x + 4), _mm256_loadu_pd(x + 12), _mm256_loadu_pd(x + 20), _mm256_loadu_pd(x + 28),
+                            matrixLinha(destino, 4) + j, matrixLinha(destino, 5) + j,
+                            matrixLinha(destino, 6) + j, matrixLinha(destino, 7) + j);
+        }
+    }
+#endif
+
+    // Colunas restantes, percorrendo o vetor em ordem
+    long int i = j * num_stream;
+    for (; j < destino.colunas; j++) {
+        for (int s = 0; s < num_stream; s++, i++) {
+            if (i < num_simbolo) {
+                MATRIX_ELEM(destino, s, j) = vetor_complex[i];
+            } else {
+                MATRIX_ELEM(destino, s, j).Re = 0;
+                MATRIX_ELEM(destino, s, j).Im = 0;
             }
+        }
+    }
 
-            free(H);
-            return NULL;
+    return 0;
+}
 
-        }
+/**
+ * @brief Prepara o transmissor em blocos: leitura, mapeamento QAM e em camadas em uma só passagem
+ * 
+ * Cada bloco vai dos bytes do arquivo às camadas sem passar por vetores do tamanho do arquivo: os
+ * bytes são lidos direto no buffer empacotado do bloco, mapeados para o buffer de pontos do bloco e
+ * entregues como a visão de tx_layer_view sobre esse buffer. Com o tamanho padrão os dois buffers
+ * somam cerca de 20 KiB e ficam na cache durante todo o bloco.
+ * 
+ * @param [out] tx O transmissor a ser inicializado
+ * @param [in] file O arquivo de entrada, aberto para leitura binária (continua sendo do chamador)
+ * @param [in] qam Ordem da constelação (4, 16, 64 ou 256)
+ * @param [in] num_stream Número de streams
+ * @param [in] colunas_por_bloco Instantes (colunas das camadas) por bloco, arredondado para cima para
+ * um múltiplo de 8 para que todo bloco comece em um byte; 0 escolhe cerca de TX_PIPELINE_PONTOS pontos
+ * @return 0 em caso de sucesso, -1 se os parâmetros forem inválidos ou a alocação falhar
+*/
+int tx_pipeline_init(tx_pipeline *tx, FILE *file, long int qam, int num_stream, long int colunas_por_bloco) {
+    int bits = tx_qam_bits(qam);
 
-        for (int j = 0; j<Nt; j++) {
-            H[i][j] = gerar_float_aleatorio(); //Preenche a matriz com valores aleatorios  
-        }
+    tx->bloco.bytes = NULL;
+    tx->pontos = NULL;
 
+    if (bits == 0 || num_stream <= 0 || colunas_por_bloco < 0) {
+        return -1;
     }
 
-    return H;
-}
+    if (colunas_por_bloco == 0) {
+        colunas_por_bloco = TX_PIPELINE_PONTOS / num_stream;
+    }
 
-int main() {
+    tx->qam = qam;
+    tx->bits = bits;
+    tx->num_stream = num_stream;
+    tx->colunas_por_bloco = (colunas_por_bloco + 7) / 8 * 8;
 
-    char *filename = "in";
-    char *filename_saida = "out";
+    // Um bloco completo tem colunas_por_bloco * num_stream pontos de 'bits' bits, um número inteiro de bytes
+    long int pontos_por_bloco = tx->colunas_por_bloco * num_stream;
+    tx_leitor_init(&tx->leitor, file, pontos_por_bloco * bits / 2);
 
-    FILE *file = fopen(filename, "rb"); // Abre o arquivo binário para leitura
+    tx->bloco = tx_simbolos_alloc(pontos_por_bloco * bits / 2);
+    tx->pontos = (complex *)malloc((size_t)pontos_por_bloco * sizeof(complex));
 
-    if (file == NULL) { // Verifica se houve falha na abertura do arquivo
-        printf("Erro ao abrir o arquivo %s\n", filename);
-        return 1;
-    } else {
-        printf("O arquivo foi aberto\n\n");
+    if (tx->bloco.bytes == NULL || tx->pontos == NULL) {
+        printf("Erro na alocação de memória\n");
+        tx_pipeline_free(tx);
+        return -1;
     }
 
-    fseek(file, 0, SEEK_END);
-    long int file_size = ftell(file);
-    fseek(file, 0, SEEK_SET);
+    return 0;
+}
 
-    int *resultado = tx_data_read(file, file_size); // Lê os dados do arquivo
+/**
+ * @brief Processa o próximo bloco do arquivo
+ * 
+ * Só o último bloco recebe padding: os bits que faltam para completar o último ponto e o último
+ * instante são zeros, como em tx_data_padding.
+ * 
+ * @param tx O transmissor inicializado por tx_pipeline_init
+ * @param [out] camadas Visão das camadas do bloco (instantes x streams, ver tx_layer_view), válida até
+ * a próxima chamada; para uma linha por stream, use tx_layer_mapper_em
+ * @return O número de instantes do bloco, 0 no fim do arquivo, ou -1 se houver um erro de leitura
+*/
+long int tx_pipeline_proximo_bloco(tx_pipeline *tx, complexMatrix *camadas) {
+    long int lidos = tx_leitor_proximo_bloco(&tx->leitor, &tx->bloco);
 
-    if (resultado != NULL) {
-        // Imprime o vetor resultante
-        for (int i = 0; i < file_size * 4; i++) {
-            printf("%d, ", resultado[i]);
-        }
-        printf("\n");
+    if (lidos <= 0) {
+        return lidos; // Fim do arquivo ou erro: um bloco lido pela metade não vira o último bloco
+    }
 
-        rx_data_write(resultado, file_size, filename_saida); // Escreve a sequência de dígitos no arquivo binário
+    long int pontos_por_bloco = tx->colunas_por_bloco * tx->num_stream;
+    long int num_pontos = pontos_por_bloco;
 
-        complex *map = tx_qam_mapper(resultado, file_size * 4); // Mapeia os índices para números complexs QAM
+    if (lidos < pontos_por_bloco * tx->bits / 2) {
+        // Último bloco: completa o último ponto e o último instante com bits zero
+        long int bits_lidos = 2 * lidos;
+        num_pontos = (bits_lidos + tx->bits - 1) / tx->bits;
+        num_pontos = (num_pontos + tx->num_stream - 1) / tx->num_stream * tx->num_stream;
 
-        if (map != NULL) {
-            // Imprime os números complexs
-            for (int i = 0; i < file_size * 4; i++) {
-                printf("Índice %d: %.2f%+.2fj\n ", i, map[i].Re, map[i].Im);
-            }
-            printf("\n");
+        memset(tx->bloco.bytes + lidos / 4, 0, (size_t)(tx->leitor.bytes_por_bloco - lidos / 4));
+        tx->bloco.num_simbolos = num_pontos * tx->bits / 2;
+    }
 
-            int num_streams = 4;
-            complex **mapped_symbols = tx_layer_mapper(map, num_streams, file_size * 4); // Mapeia os símbolos QAM para cada fluxo
+    tx_qam_mapper_em(tx->bloco, tx->qam, tx->pontos);
+    tx_layer_view(tx->pontos, tx->num_stream, num_pontos, camadas);
 
-            if (mapped_symbols != NULL) {
-                // Imprime os símbolos mapeados para cada fluxo
-                for (int i = 0; i < num_streams; i++) {
-                    for (int j = 0; j < file_size * 4 / num_streams; j++) {
-                        printf("Fluxo %d: %.2f%+.2fj\n", i, mapped_symbols[i][j].Re, mapped_symbols[i][j].Im);
-                    }
-                }
+    return num_pontos / tx->num_stream;
+}
 
-                // // Executa o demapeamento dos símbolos para obter o vetor de complexs original
-                // complex *demapped_symbols = rx_layer_demapper(mapped_symbols, num_streams, file_size * 4);
+/**
+ * @brief Libera os buffers do transmissor (o arquivo não é fechado)
+ * 
+ * @param tx O transmissor a ser liberado
+*/
+void tx_pipeline_free(tx_pipeline *tx) {
+    tx_simbolos_free(tx->bloco);
+    free(tx->pontos);
+    tx->bloco.bytes = NULL;
+    tx->pontos = NULL;
+}
 
-                // if (demapped_symbols != NULL) {
-                //     // Imprime os símbolos demapeados
-                //     for (int i = 0; i < file_size * 4; i++) {
-                //         printf("Índice %d: %.2f%+.2fj\n", i, demapped_symbols[i].Re, demapped_symbols[i].Im);
-                //     }
+/**
+ * @brief Fator aplicado às constelações de potência unitária antes de quantizar para Q15
+ * 
+ * Os pontos de canto de 64 e 256-QAM passam de 1 (1.08 e 1.15), que não existe em Q15, então essas
+ * ordens são quantizadas pela metade. É o 'escala' de matrixParaQ15/q15ParaMatrix.
+ * 
+ * @param qam Ordem da constelação
+ * @return 1 para 4 e 16-QAM, 0.5 para 64 e 256-QAM
+*/
+float tx_qam_escala_q15(long int qam) {
+    return (qam > 16) ? 0.5f : 1.0f;
+}
 
-                //     // Libera a memória alocada para o vetor de complexs demapeado
-                //     free(demapped_symbols);
-                // }
+/**
+ * @brief Faz o mapeamento QAM em ponto fixo Q15
+ * 
+ * Mesmas constelações de tx_qam_mapper_em multiplicadas por tx_qam_escala_q15(qam) e quantizadas
+ * para Q15: para 4-QAM cada coordenada vira ±Q15_RAIZ_MEIO.
+ * 
+ * @param [in] simbolos Os símbolos de 2 bits empacotados
+ * @param [in] qam Ordem da constelação (4, 16, 64 ou 256)
+ * @param [out] simbolo Vetor com pelo menos tx_qam_pontos(simbolos.num_simbolos, qam) posições
+ * @return 0 em caso de sucesso, -1 se a ordem não for suportada
+*/
+int tx_qam_mapper_q15_em(tx_simbolos simbolos, long int qam, complexQ15 *simbolo) {
+    int bits = tx_qam_bits(qam);
 
-                // Libera a memória alocada para a matriz de símbolos mapeados
-                for (int i = 0; i < num_streams; i++) {
-                    free(mapped_symbols[i]);
-                }
-                free(mapped_symbols);
-            }
-        }
+    if (bits == 0) {
+        return -1;
     }
 
-    fclose(file); // Fecha o arquivo
+    // Tabela da constelação indexada pelos bits do ponto
+    complex pontos[256];
+    complexQ15 constelacao[256];
+    float escala = tx_qam_escala_q15(qam) * 32768.0f;
+    tx_qam_constelacao(qam, pontos);
 
-    int Nr = 4; // Número de antenas receptoras
-    int Nt = 3; // Número de antenas transmissoras
+    for (long int v = 0; v < qam; v++) {
+        constelacao[v].Re = q15Satura((int32_t)lrintf(pontos[v].Re * escala));
+        constelacao[v].Im = q15Satura((int32_t)lrintf(pontos[v].Im * escala));
+    }
 
-    srand(time(NULL)); // Inicializa a semente do gerador de números aleatórios com base no tempo
+    long int num_pontos = tx_qam_pontos(simbolos.num_simbolos, qam);
 
-    float **H = channel_gen(Nr, Nt); // Gera a matriz do canal aleatório
+    for (long int p = 0; p < num_pontos; p++) {
+        simbolo[p] = constelacao[tx_qam_indice(simbolos, p, bits)];
+    }
 
-    if (H != NULL) {
-        // Imprime a matriz do canal
-        for (int i = 0; i < Nr; i++) {
-            for (int j = 0; j < Nt; j++) {
-                printf("%.2f\t", H[i][j]);
-            }
-            printf("\n");
-        }
+    return 0;
+}
 
-        // Libera a memória alocada para a matriz do canal
-        for (int i = 0; i < Nr; i++) {
-            free(H[i]);
+/**
+ * @brief Faz o mapeamento em camadas dos símbolos em Q15
+ * 
+ * Mesma distribuição de tx_layer_mapper_em (o símbolo i vai para a stream i % linhas, a última
+ * coluna completada com zeros), com metade da memória por símbolo.
+ * 
+ * @param vetor_q15 Ponteiro para o vetor de símbolos em Q15
+ * @param num_simbolo Número de simbolos a mapear
+ * @param [out] destino Matriz Q15 com uma linha por stream e ceil(num_simbolo / linhas) colunas
+ * @return 0 em caso de sucesso, -1 se as dimensões de destino não concordarem
+*/
+int tx_layer_mapper_q15_em(complexQ15 *vetor_q15, long int num_simbolo, complexMatrixQ15 destino) {
+    int num_stream = destino.linhas;
+
+    if (num_stream <= 0 || destino.colunas != tx_layer_colunas(num_simbolo, num_stream)) {
+        return -1;
+    }
+
+    static const complexQ15 zero = {0, 0};
+    long int i = 0;
+
+    for (long int j = 0; j < destino.colunas; j++) {
+        for (int s = 0; s < num_stream; s++, i++) {
+            Q15_ELEM(destino, s, j) = (i < num_simbolo) ? vetor_q15[i] : zero;
         }
-        free(H);
     }
 
     return 0;
+}
+
+/**
+ * @brief Camadas recebidas como vetor de símbolos, sem cópia
+ * 
+ * Inverso de tx_layer_view: quando as camadas são uma matriz instantes x streams guardada sem folga
+ * entre as linhas (como a visão de tx_layer_view ou do transmissor em blocos), os símbolos já estão
+ * na ordem do vetor.
+ * 
+ * @param camadas As camadas, uma linha por instante e uma coluna por stream
+ * @return Ponteiro para o vetor de linhas * colunas símbolos, ou NULL se as linhas tiverem folga
+ * (nesse caso, use rx_layer_demapper_em)
+*/
+complex *rx_layer_view(complexMatrix camadas) {
+    return (camadas.ld == camadas.colunas || camadas.linhas <= 1) ? camadas.dados : NULL;
+}
+
+/**
+ * @brief Desfaz o mapeamento em camadas de tx_layer_mapper
+ * 
+ * @param camadas A matriz de tx_layer_mapper, uma linha por stream
+ * @param num_stream Número de streams
+ * @param num_simbolo Número de símbolos a recuperar (o padding da última coluna é descartado)
+ * @return O vetor de símbolos, na ordem original, ou NULL em caso de erro
+*/
+complex *rx_layer_demapper(complex **camadas, int num_stream, long int num_simbolo) {
+    complex *vetor_complex = (complex *)malloc(num_simbolo * sizeof(complex));
+
+    if (vetor_complex == NULL) {
+        printf("Erro na alocação de memória\n");
+        return NULL;
+    }
+
+    long int i = 0;
+    for (long int j = 0; i < num_simbolo; j++) {
+        for (int s = 0; s < num_stream && i < num_simbolo; s++, i++) {
+            vetor_complex[i] = camadas[s][j];
+        }
+    }
+
+    return vetor_complex;
+}
+
+/**
+ * @brief Desfaz o mapeamento em camadas de tx_layer_mapper_em em um vetor fornecido pelo chamador
+ * 
+ * Para 2, 4 e 8 streams as camadas são intercaladas com AVX2 (a mesma transposição 4 x 4 de
+ * tx_layer_mapper_em, que é a sua própria inversa); as outras contagens percorrem a saída uma vez,
+ * sem divisões.
+ * 
+ * @param camadas A matriz com uma linha por stream e ceil(num_simbolo / linhas) colunas
+ * @param num_simbolo Número de símbolos a recuperar (o padding da última coluna é descartado)
+ * @param [out] destino Vetor com pelo menos num_simbolo posições
+ * @return 0 em caso de sucesso, -1 se as dimensões das camadas não concordarem
+*/
+int rx_layer_demapper_em(complexMatrix camadas, long int num_simbolo, complex *destino) {
+    int num_stream = camadas.linhas;
+
+    if (num_stream <= 0 || camadas.colunas != tx_layer_colunas(num_simbolo, num_stream)) {
+        return -1;
+    }
+
+    long int completas = num_simbolo / num_stream;
+    long int j = 0;
+
+#if defined(__AVX2__)
+    if (num_stream == 2) {
+        for (; j + 4 <= completas; j += 4) {
+            __m256d a = _mm256_loadu_pd((const double *)(matrixLinha(camadas, 0) + j));
+            __m256d b = _mm256_loadu_pd((const double *)(matrixLinha(camadas, 1) + j));
+            __m256d baixo = _mm256_unpacklo_pd(a, b); // a0 b0 | a2 b2
+            __m256d alto = _mm256_unpackhi_pd(a, b);  // a1 b1 | a3 b3
+            _mm256_storeu_pd((double *)(destino + 2 * j), _mm256_permute2f128_pd(baixo, alto, 0x20));
+            _mm256_storeu_pd((double *)(destino + 2 * j + 4), _mm256_permute2f128_pd(baixo, alto, 0x31));
+        }
+    } else if (num_stream == 4) {
+        for (; j + 4 <= completas; j += 4) {
+            complex *x = destino + 4 * j;
+            tx_transpoe_4x4(_mm256_loadu_pd((const double *)(matrixLinha(camadas, 0) + j)),
+                            _mm256_loadu_pd((const double *)(matrixLinha(camadas, 1) + j)),
+                            _mm256_loadu_pd((const double *)(matrixLinha(camadas, 2) + j)),
+                            _mm256_loadu_pd((const double *)(matrixLinha(camadas, 3) + j)),
+                            x, x + 4, x + 8, x + 12);
+        }
+    } else if (num_stream == 8) {
+        for (; j + 4 <= completas; j += 4) {
+            complex *x = destino + 8 * j;
+            // Streams 0..3 na primeira metade de cada instante, 4..7 na segunda
+            tx_transpoe_4x4(_mm256_loadu_pd((const double *)(matrixLinha(camadas, 0) + j)),
+                            _mm256_loadu_pd((const double *)(matrixLinha(camadas, 1) + j)),
+                            _mm256_loadu_pd((const double *)(matrixLinha(camadas, 2) + j)),
+                            _mm256_loadu_pd((const double *)(matrixLinha(camadas, 3) + j)),
+                            x, x + 8, x + 16, x + 24);
+            tx_transpoe_4x4(_mm256_loadu_pd((const double *)(matrixLinha(camadas, 4) + j)),
+                            _mm256_loadu_pd((const double *)(matrixLinha(camadas, 5) + j)),
+                            _mm256_loadu_pd((const double *)(matrixLinha(camadas, 6) + j)),
+                            _mm256_loadu_pd((const double *)(matrixLinha(camadas, 7) + j)),
+                            x + 4, x + 12, x + 20, x + 28);
+        }
+    }
+#endif
+
+    // Colunas restantes, escrevendo a saída em ordem
+    long int i = j * num_stream;
+    for (; i < num_simbolo; j++) {
+        for (int s = 0; s < num_stream && i < num_simbolo; s++, i++) {
+            destino[i] = MATRIX_ELEM(camadas, s, j);
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Escreve os bits do ponto QAM de índice p (inverso de tx_qam_indice)
+ * 
+ * Só os bits do ponto são alterados; o segundo byte só é tocado quando o ponto o atravessa.
+ */
+static inline void rx_qam_escreve_indice(unsigned char *bytes, long int p, int bits, unsigned int valor) {
+    long int posicao = p * bits;
+    unsigned int deslocamento = (unsigned int)(posicao & 7);
+    unsigned int mascara = ((1u << bits) - 1) << deslocamento;
+    valor <<= deslocamento;
+
+    bytes[posicao >> 3] = (unsigned char)((bytes[posicao >> 3] & ~mascara) | (valor & mascara));
+
+    if (deslocamento + bits > 8) {
+        bytes[(posicao >> 3) + 1] = (unsigned char)((bytes[(posicao >> 3) + 1] & ~(mascara >> 8)) | ((valor & mascara) >> 8));
+    }
+}
+
+/**
+ * @brief Decisão abrupta em um eixo: o rótulo de Gray do nível mais próximo de t
+ * 
+ * @param t A coordenada já levada à escala dos níveis: (L - 1 + x / escala) / 2 para a parte real
+ */
+static inline unsigned int rx_qam_rotulo(float t, int niveis) {
+    // Limita t às bordas antes de converter, na ordem do max/min do AVX2: fmaxf descarta NaN, e lrintf
+    // nunca recebe ±inf ou valores fora de long (para os quais o resultado não é definido)
+    long int nivel = lrintf(fminf(fmaxf(t, 0.0f), (float)(niveis - 1)));
+
+    return (unsigned int)(nivel ^ (nivel >> 1));
+}
+
+/**
+ * @brief Faz a decisão abrupta dos pontos QAM recebidos, devolvendo os bits empacotados
+ * 
+ * Como as constelações de tx_qam_mapper_em são separáveis, o ponto mais próximo é decidido em cada
+ * eixo: o nível mais próximo sai de um arredondamento, limitado às bordas, e vira o rótulo de Gray.
+ * Com AVX2, 8 pontos por iteração: as coordenadas são separadas, decididas e os 8 * bits bits são
+ * juntados por deslocamentos variáveis e escritos de uma vez.
+ * 
+ * @param [in] pontos Os pontos recebidos (por exemplo, de rx_layer_view)
+ * @param [in] num_pontos Número de pontos
+ * @param [in] qam Ordem da constelação (4, 16, 64 ou 256)
+ * @param [out] saida Vetor com capacidade para num_pontos * log2(qam) / 2 símbolos de 2 bits;
+ * num_simbolos recebe esse número
+ * @return 0 em caso de sucesso, -1 se a ordem não for suportada ou a capacidade não bastar
+*/
+int rx_qam_demapper_em(const complex *pontos, long int num_pontos, long int qam, tx_simbolos *saida) {
+    int bits = tx_qam_bits(qam);
+
+    if (bits == 0 || num_pontos * bits / 2 > saida->capacidade) {
+        return -1;
+    }
+
+    int meio = bits / 2;
+    int niveis = 1 << meio;
+    float eixo_re[16], eixo_im[16];
+    tx_qam_eixos(bits, eixo_re, eixo_im);
+
+    // O nível n do eixo real vale (2n - (L - 1)) * escala, e o rótulo 0 é o nível 0: n = x / (2 escala) + (L - 1) / 2
+    float escala = -eixo_re[0] / (float)(niveis - 1);
+    float inverso = 0.5f / escala;
+    float centro = 0.5f * (float)(niveis - 1);
+    long int p = 0;
+
+#if defined(__AVX2__) && defined(__FMA__)
+    const __m256 v_inverso = _mm256_set1_ps(inverso);
+    const __m256 v_centro = _mm256_set1_ps(centro);
+    const __m256 v_zero = _mm256_setzero_ps();
+    const __m256 v_maximo = _mm256_set1_ps((float)(niveis - 1));
+    const __m256i deslocamentos = _mm256_setr_epi32(0, bits, 2 * bits, 3 * bits, 0, bits, 2 * bits, 3 * bits);
+
+    for (; p + 8 <= num_pontos; p += 8) {
+        __m256 a = _mm256_loadu_ps((const float *)(pontos + p));
+        __m256 b = _mm256_loadu_ps((const float *)(pontos + p + 4));
+
+        // Separa as coordenadas: re0 re1 re4 re5 | re2 re3 re6 re7, reordenadas por 64 bits
+        __m256 re = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, 0x88)), 0xD8));
+        __m256 im = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, 0xDD)), 0xD8));
+
+        // Níveis mais próximos, limitados às bordas (max/min com o limite como segundo operando descartam NaN)
+        __m256 t_re = _mm256_min_ps(_mm256_max_ps(_mm256_fmadd_ps(re, v_inverso, v_centro), v_zero), v_maximo);
+        __m256 t_im = _mm256_min_ps(_mm256_max_ps(_mm256_fnmadd_ps(im, v_inverso, v_centro), v_zero), v_maximo);
+        __m256i n_re = _mm256_cvtps_epi32(t_re);
+        __m256i n_im = _mm256_cvtps_epi32(t_im);
+
+        // Rótulos de Gray, juntados no índice do ponto: Re nos bits altos, Im nos baixos
+        __m256i g_re = _mm256_xor_si256(n_re, _mm256_srli_epi32(n_re, 1));
+        __m256i g_im = _mm256_xor_si256(n_im, _mm256_srli_epi32(n_im, 1));
+        __m256i indice = _mm256_or_si256(_mm256_slli_epi32(g_re, meio), g_im);
+
+        // Os pontos 0..3 formam os 4 * bits bits baixos e 4..7 os altos; os bits não se sobrepõem
+        __m256i posicionado = _mm256_sllv_epi32(indice, deslocamentos);
+        __m128i baixo = _mm256_castsi256_si128(posicionado);
+        __m128i alto = _mm256_extracti128_si256(posicionado, 1);
+        baixo = _mm_or_si128(baixo, _mm_shuffle_epi32(baixo, 0x4E));
+        baixo = _mm_or_si128(baixo, _mm_shuffle_epi32(baixo, 0xB1));
+        alto = _mm_or_si128(alto, _mm_shuffle_epi32(alto, 0x4E));
+        alto = _mm_or_si128(alto, _mm_shuffle_epi32(alto, 0xB1));
+
+        uint64_t palavra = (uint32_t)_mm_cvtsi128_si32(baixo) | ((uint64_t)(uint32_t)_mm_cvtsi128_si32(alto) << (4 * bits));
+        memcpy(saida->bytes + p / 8 * bits, &palavra, (size_t)bits);
+    }
+#endif
+
+    for (; p < num_pontos; p++) {
+        unsigned int g_re = rx_qam_rotulo(pontos[p].Re * inverso + centro, niveis);
+        unsigned int g_im = rx_qam_rotulo(centro - pontos[p].Im * inverso, niveis);
+        rx_qam_escreve_indice(saida->bytes, p, bits, (g_re << meio) | g_im);
+    }
+
+    saida->num_simbolos = num_pontos * bits / 2;
+
+    return 0;
+}
+
+/**
+ * @brief LLRs max-log dos bits de um eixo, para 8 coordenadas
+ * 
+ * Para cada bit do rótulo, a menor distância ao quadrado aos níveis com o bit 0 e com o bit 1; as
+ * distâncias no outro eixo são as mesmas nos dois casos e se cancelam.
+ */
+#if defined(__AVX2__) && defined(__FMA__)
+static inline void rx_qam_llr_eixo_v(__m256 x, const float *eixo, int meio, __m256 escala, __m256 *llr) {
+    __m256 menor0[4], menor1[4];
+    const __m256 infinito = _mm256_set1_ps(INFINITY);
+
+    for (int i = 0; i < meio; i++) {
+        menor0[i] = infinito;
+        menor1[i] = infinito;
+    }
+
+    for (int g = 0; g < (1 << meio); g++) {
+        __m256 d = _mm256_sub_ps(x, _mm256_set1_ps(eixo[g]));
+        d = _mm256_mul_ps(d, d);
+
+        for (int i = 0; i < meio; i++) {
+            if ((g >> i) & 1) {
+                menor1[i] = _mm256_min_ps(menor1[i], d);
+            } else {
+                menor0[i] = _mm256_min_ps(menor0[i], d);
+            }
+        }
+    }
+
+    for (int i = 0; i < meio; i++) {
+        llr[i] = _mm256_mul_ps(_mm256_sub_ps(menor1[i], menor0[i]), escala);
+    }
+}
+#endif
+
+/**
+ * @brief Mesmo cálculo de rx_qam_llr_eixo_v para uma coordenada
+ */
+static inline void rx_qam_llr_eixo(float x, const float *eixo, int meio, float escala, float *llr) {
+    float menor0[4] = {INFINITY, INFINITY, INFINITY, INFINITY};
+    float menor1[4] = {INFINITY, INFINITY, INFINITY, INFINITY};
+
+    for (int g = 0; g < (1 << meio); g++) {
+        float d = (x - eixo[g]) * (x - eixo[g]);
+
+        for (int i = 0; i < meio; i++) {
+            if ((g >> i) & 1) {
+                menor1[i] = (d < menor1[i]) ? d : menor1[i];
+            } else {
+                menor0[i] = (d < menor0[i]) ? d : menor0[i];
+            }
+        }
+    }
+
+    for (int i = 0; i < meio; i++) {
+        llr[i] = (menor1[i] - menor0[i]) * escala;
+    }
+}
+
+/**
+ * @brief Calcula as LLRs max-log dos bits dos pontos QAM recebidos
+ * 
+ * LLR = log P(bit = 0) / P(bit = 1) ~ (min |y - s|² com o bit 1 - min |y - s|² com o bit 0) / sigma2,
+ * positiva quando o bit 0 é mais provável. As constelações são separáveis, então cada bit depende de
+ * um só eixo e o mínimo é tomado sobre os níveis desse eixo, o que dá o max-log exato. Com AVX2,
+ * 8 pontos por iteração.
+ * 
+ * @param [in] pontos Os pontos recebidos
+ * @param [in] num_pontos Número de pontos
+ * @param [in] qam Ordem da constelação (4, 16, 64 ou 256)
+ * @param [in] sigma2 Variância do ruído complexo por ponto (deve ser positiva)
+ * @param [out] llr Vetor com num_pontos * log2(qam) posições: as LLRs do ponto p começam em
+ * p * log2(qam), na ordem dos bits no fluxo (primeiro os da parte imaginária, depois os da real)
+ * @return 0 em caso de sucesso, -1 se a ordem não for suportada ou se sigma2 não for positiva
+ * (zero, negativa ou NaN), caso em que llr não é escrito
+*/
+int rx_qam_llr_em(const complex *pontos, long int num_pontos, long int qam, float sigma2, float *llr) {
+    int bits = tx_qam_bits(qam);
+
+    // A comparação negada também rejeita NaN: 1 / sigma2 daria LLRs infinitas ou NaN
+    if (bits == 0 || !(sigma2 > 0.0f)) {
+        return -1;
+    }
+
+    int meio = bits / 2;
+    float eixo_re[16], eixo_im[16];
+    tx_qam_eixos(bits, eixo_re, eixo_im);
+
+    float escala = 1.0f / sigma2;
+    long int p = 0;
+
+#if defined(__AVX2__) && defined(__FMA__)
+    const __m256 v_escala = _mm256_set1_ps(escala);
+
+    for (; p + 8 <= num_pontos; p += 8) {
+        __m256 a = _mm256_loadu_ps((const float *)(pontos + p));
+        __m256 b = _mm256_loadu_ps((const float *)(pontos + p + 4));
+        __m256 re = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, 0x88)), 0xD8));
+        __m256 im = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, 0xDD)), 0xD8));
+
+        __m256 llr_v[8];
+        rx_qam_llr_eixo_v(im, eixo_im, meio, v_escala, llr_v);
+        rx_qam_llr_eixo_v(re, eixo_re, meio, v_escala, llr_v + meio);
+
+        // Cada vetor tem um bit de 8 pontos; a saída é ponto a ponto
+        float bloco[8][8];
+        for (int i = 0; i < bits; i++) {
+            _mm256_storeu_ps(bloco[i], llr_v[i]);
+        }
+        for (int k = 0; k < 8; k++) {
+            for (int i = 0; i < bits; i++) {
+                llr[(p + k) * bits + i] = bloco[i][k];
+            }
+        }
+    }
+#endif
+
+    for (; p < num_pontos; p++) {
+        rx_qam_llr_eixo(pontos[p].Im, eixo_im, meio, escala, llr + p * bits);
+        rx_qam_llr_eixo(pontos[p].Re, eixo_re, meio, escala, llr + p * bits + meio);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Soma a * los a cada elemento de H (componente de visada direta do canal de Rice)
+ */
+static void canal_soma_los(complexMatrix H, complexMatrix los, float a) {
+    for (int i = 0; i < H.linhas; i++) {
+        for (int j = 0; j < H.colunas; j++) {
+            MATRIX_ELEM(H, i, j).Re += a * MATRIX_ELEM(los, i, j).Re;
+            MATRIX_ELEM(H, i, j).Im += a * MATRIX_ELEM(los, i, j).Im;
+        }
+    }
+}
+
+/**
+ * @brief Gera um canal MIMO de Rayleigh: elementos CN(0,1) independentes
+ * 
+ * As partes real e imaginária de cada elemento são gaussianas de variância 1/2, tiradas do
+ * subfluxo do gerador pelo Box-Muller vetorizado de aleatorioGaussianoEm.
+ * 
+ * @param gerador O subfluxo de onde vêm as amostras (por exemplo, um por quadro da simulação)
+ * @param [out] H O canal Nr x Nt (pode ser uma view)
+ * @return 0 em caso de sucesso
+*/
+int canal_rayleigh_em(aleatorioGerador *gerador, complexMatrix H) {
+    return canal_rician_em(gerador, 0.0f, H, H);
+}
+
+/**
+ * @brief Gera um canal MIMO de Rice com fator K
+ * 
+ * H = sqrt(K / (K + 1)) * los + sqrt(1 / (K + 1)) * G, com G de Rayleigh: cada elemento tem potência
+ * média 1 se os elementos de los têm módulo 1. K = 0 dá o canal de Rayleigh (los não é lido).
+ * As amostras vêm de uma só chamada ao gerador, também quando H é uma view (elas são geradas em um
+ * vetor contínuo e copiadas linha a linha), então o mesmo subfluxo dá o mesmo canal nos dois casos.
+ * 
+ * @param gerador O subfluxo de onde vêm as amostras
+ * @param K O fator de Rice (potência da visada direta / potência espalhada)
+ * @param [in] los A componente de visada direta, Nr x Nt (por exemplo a_r * a_t^H de um arranjo linear)
+ * @param [out] H O canal Nr x Nt (pode ser uma view)
+ * @return 0 em caso de sucesso, -1 se K for negativo, as dimensões não baterem ou a alocação do
+ * vetor temporário de uma view falhar
+*/
+int canal_rician_em(aleatorioGerador *gerador, float K, complexMatrix los, complexMatrix H) {
+    if (K < 0.0f || (K > 0.0f && (los.linhas != H.linhas || los.colunas != H.colunas))) {
+        return -1;
+    }
+
+    float desvio = sqrtf(0.5f / (K + 1.0f));
+
+    if (H.ld == H.colunas) {
+        // Matriz contínua: uma só chamada preenche todas as partes reais e imaginárias
+        aleatorioGaussianoEm(gerador, (float *)H.dados, 2L * H.linhas * H.colunas, desvio);
+    } else {
+        // View: as amostras vão para um vetor contínuo e depois para as linhas de H
+        complex *amostras = (complex *)malloc((size_t)H.linhas * H.colunas * sizeof(complex));
+
+        if (amostras == NULL) {
+            printf("Erro na alocação de memória\n");
+            return -1;
+        }
+
+        aleatorioGaussianoEm(gerador, (float *)amostras, 2L * H.linhas * H.colunas, desvio);
+
+        for (int i = 0; i < H.linhas; i++) {
+            memcpy(&MATRIX_ELEM(H, i, 0), amostras + (size_t)i * H.colunas, (size_t)H.colunas * sizeof(complex));
+        }
+
+        free(amostras);
+    }
+
+    if (K > 0.0f) {
+        canal_soma_los(H, los, sqrtf(K / (K + 1.0f)));
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Gera um lote de canais de Rayleigh independentes (por exemplo, as realizações de uma simulação de Monte Carlo)
+ * 
+ * @param gerador O subfluxo de onde vêm as amostras
+ * @param [out] H O lote de canais Nr x Nt (pode ser uma view de loteView)
+ * @return 0 em caso de sucesso
+*/
+int canal_rayleigh_lote_em(aleatorioGerador *gerador, complexMatrixLote H) {
+    return canal_rician_lote_em(gerador, 0.0f, (complexMatrix){0}, H);
+}
+
+/**
+ * @brief Gera um lote de canais de Rice com fator K e a mesma visada direta
+ * 
+ * Cada plano (Re e Im) de linhas * colunas * H.passo floats é preenchido por uma só chamada ao gerador,
+ * e a visada direta é somada depois. Em um lote alocado o plano inteiro é do lote e as amostras vão
+ * direto para ele (as posições de padding recebem amostras que não são usadas); em uma view de loteView
+ * elas vão para um plano temporário e só as matrizes da view são copiadas, para que as outras matrizes
+ * do lote fiquem intactas. O mesmo subfluxo dá então os mesmos canais nos dois casos.
+ * 
+ * @param gerador O subfluxo de onde vêm as amostras
+ * @param K O fator de Rice
+ * @param [in] los A componente de visada direta, Nr x Nt (não é lida se K = 0)
+ * @param [out] H O lote de canais Nr x Nt
+ * @return 0 em caso de sucesso, -1 se K for negativo, as dimensões não baterem ou a alocação do
+ * plano temporário de uma view falhar
+*/
+int canal_rician_lote_em(aleatorioGerador *gerador, float K, complexMatrix los, complexMatrixLote H) {
+    if (K < 0.0f || (K > 0.0f && (los.linhas != H.linhas || los.colunas != H.colunas))) {
+        return -1;
+    }
+
+    float desvio = sqrtf(0.5f / (K + 1.0f));
+    float a = sqrtf(K / (K + 1.0f));
+    int elementos = H.linhas * H.colunas;
+    long int plano = (long int)elementos * H.passo;
+
+    if (H.bloco != NULL || H.lote == H.passo) {
+        aleatorioGaussianoEm(gerador, H.Re, plano, desvio);
+        aleatorioGaussianoEm(gerador, H.Im, plano, desvio);
+    } else {
+        float *amostras = (float *)malloc((size_t)plano * sizeof(float));
+
+        if (amostras == NULL) {
+            printf("Erro na alocação de memória\n");
+            return -1;
+        }
+
+        float *planos[2] = {H.Re, H.Im};
+
+        for (int c = 0; c < 2; c++) {
+            aleatorioGaussianoEm(gerador, amostras, plano, desvio);
+
+            for (int e = 0; e < elementos; e++) {
+                memcpy(planos[c] + (size_t)e * H.passo, amostras + (size_t)e * H.passo, (size_t)H.lote * sizeof(float));
+            }
+        }
+
+        free(amostras);
+    }
+
+    if (K > 0.0f) {
+        for (int i = 0; i < H.linhas; i++) {
+            for (int j = 0; j < H.colunas; j++) {
+                size_t e = ((size_t)i * H.colunas + j) * H.passo;
+                float los_re = a * MATRIX_ELEM(los, i, j).Re;
+                float los_im = a * MATRIX_ELEM(los, i, j).Im;
+
+                for (int b = 0; b < H.lote; b++) {
+                    H.Re[e + b] += los_re;
+                    H.Im[e + b] += los_im;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Aloca e gera um canal MIMO de Rayleigh Nr x Nt
+ * 
+ * @param Nr Número de antenas receptoras
+ * @param Nt Número de antenas transmissoras
+ * @param gerador O subfluxo de onde vêm as amostras
+ * @return O canal (a ser liberado com freeComplexMatrix)
+*/
+complexMatrix channel_gen(int Nr, int Nt, aleatorioGerador *gerador) {
+    complexMatrix H = allocateComplexMatrix(Nr, Nt);
+
+    canal_rayleigh_em(gerador, H);
+
+    return H;
+}
+
+/**
+ * @brief Prepara a escrita em blocos dos símbolos recebidos
+ * 
+ * Os símbolos são juntados em um buffer de RX_BLOCO_ESCRITA bytes e vão para o arquivo com uma
+ * chamada a fwrite por buffer cheio. Blocos de qualquer tamanho podem ser escritos um depois do outro:
+ * se um bloco termina no meio de um byte, os seguintes são deslocados 64 bits (32 símbolos) por vez.
+ * 
+ * @param [out] escritor O escritor a ser inicializado
+ * @param [in] file O arquivo aberto para escrita binária (continua sendo do chamador)
+ * @param [in] num_simbolos Número de símbolos a escrever; os que passarem disso (o padding) são descartados
+ * @return 0 em caso de sucesso, -1 se a alocação falhar
+*/
+int rx_escritor_init(rx_escritor *escritor, FILE *file, long int num_simbolos) {
+    escritor->arquivo = file;
+    escritor->usados = 0;
+    escritor->palavra = 0;
+    escritor->pendentes = 0;
+    escritor->restantes = num_simbolos;
+    escritor->buffer = (unsigned char *)malloc(RX_BLOCO_ESCRITA);
+
+    if (escritor->buffer == NULL) {
+        printf("Erro na alocação de memória\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Esvazia o buffer do escritor no arquivo
+ */
+static void rx_escritor_esvazia(rx_escritor *escritor) {
+    fwrite(escritor->buffer, 1, escritor->usados, escritor->arquivo);
+    escritor->usados = 0;
+}
+
+/**
+ * @brief Acrescenta ao buffer os 64 bits de uma palavra completa
+ */
+static inline void rx_escritor_palavra(rx_escritor *escritor, uint64_t palavra) {
+    if (escritor->usados + sizeof(palavra) > RX_BLOCO_ESCRITA) {
+        rx_escritor_esvazia(escritor);
+    }
+
+    memcpy(escritor->buffer + escritor->usados, &palavra, sizeof(palavra));
+    escritor->usados += sizeof(palavra);
+}
+
+/**
+ * @brief Escreve um bloco de símbolos recebidos
+ * 
+ * @param escritor O escritor inicializado por rx_escritor_init
+ * @param [in] bloco Os símbolos do bloco, empacotados (por exemplo, a saída de rx_qam_demapper_em)
+*/
+void rx_escritor_escreve(rx_escritor *escritor, tx_simbolos bloco) {
+    long int num_simbolos = (bloco.num_simbolos < escritor->restantes) ? bloco.num_simbolos : escritor->restantes;
+    long int i = 0;
+
+    escritor->restantes -= num_simbolos;
+
+    if (escritor->pendentes == 0) {
+        // Alinhado em bytes: os bytes completos do bloco são copiados como estão
+        long int bytes = num_simbolos / 4;
+
+        while (i < 4 * bytes) {
+            size_t parte = RX_BLOCO_ESCRITA - escritor->usados;
+            if ((long int)parte > bytes - i / 4) {
+                parte = (size_t)(bytes - i / 4);
+            }
+
+            memcpy(escritor->buffer + escritor->usados, bloco.bytes + i / 4, parte);
+            escritor->usados += parte;
+            i += 4 * (long int)parte;
+
+            if (escritor->usados == RX_BLOCO_ESCRITA) {
+                rx_escritor_esvazia(escritor);
+            }
+        }
+    } else {
+        // Desalinhado: 32 símbolos por vez, deslocados para depois dos pendentes
+        int deslocamento = 2 * escritor->pendentes;
+
+        for (; i + 32 <= num_simbolos; i += 32) {
+            uint64_t entrada;
+            memcpy(&entrada, bloco.bytes + i / 4, sizeof(entrada));
+
+            rx_escritor_palavra(escritor, escritor->palavra | (entrada << deslocamento));
+            escritor->palavra = entrada >> (64 - deslocamento);
+        }
+    }
+
+    // Símbolos que não completam uma palavra ficam pendentes
+    for (; i < num_simbolos; i++) {
+        escritor->palavra |= (uint64_t)tx_simbolo(bloco, i) << (2 * escritor->pendentes);
+
+        if (++escritor->pendentes == 32) {
+            rx_escritor_palavra(escritor, escritor->palavra);
+            escritor->palavra = 0;
+            escritor->pendentes = 0;
+        }
+    }
+}
+
+/**
+ * @brief Escreve os símbolos pendentes e libera o buffer do escritor (o arquivo não é fechado)
+ * 
+ * Um último byte incompleto é escrito com os bits que faltam em zero.
+ * 
+ * @param escritor O escritor a ser finalizado
+ * @return 0 em caso de sucesso, -1 se houve erro de escrita
+*/
+int rx_escritor_fim(rx_escritor *escritor) {
+    if (escritor->pendentes > 0) {
+        size_t bytes = (size_t)TX_SIMBOLOS_BYTES(escritor->pendentes);
+
+        if (escritor->usados + bytes > RX_BLOCO_ESCRITA) {
+            rx_escritor_esvazia(escritor);
+        }
+
+        memcpy(escritor->buffer + escritor->usados, &escritor->palavra, bytes);
+        escritor->usados += bytes;
+        escritor->pendentes = 0;
+    }
+
+    rx_escritor_esvazia(escritor);
+    free(escritor->buffer);
+    escritor->buffer = NULL;
+
+    return ferror(escritor->arquivo) ? -1 : 0;
+}
+
+/**
+ * @brief Escreve os símbolos recebidos em um arquivo
+ * 
+ * Os símbolos já estão empacotados no formato do arquivo e passam por um rx_escritor;
+ * símbolos além de sequencia_bytes * 4 (o padding) são descartados.
+ * 
+ * @param s Os símbolos de 2 bits empacotados
+ * @param sequencia_bytes Número de bytes a escrever
+ * @param filename Nome do arquivo de saída
+*/
+void rx_data_write(tx_simbolos s, long int sequencia_bytes, char *filename) {
+    FILE *out = fopen(filename, "wb"); // Abre o arquivo para escrita binária
+
+    if (out == NULL) { // Verifica se houve falha na abertura do arquivo
+        printf("Erro ao abrir o arquivo %s.\n", filename);
+        return;
+    } else {
+        printf("\nArquivo %s criado.\n\n", filename);
+    }
+
+    rx_escritor escritor;
+
+    if (rx_escritor_init(&escritor, out, sequencia_bytes * 4) == 0) {
+        rx_escritor_escreve(&escritor, s);
+
+        if (rx_escritor_fim(&escritor) != 0) {
+            printf("Erro ao escrever o arquivo %s.\n", filename);
+        }
+    }
+
+    fclose(out); // Fecha o arquivo
+}
+
+/************************************* TESTS ***************************************/
+
+/**
+ * @brief Confere a decisão abrupta de pontos saturados, infinitos e NaN
+ * 
+ * Depois de um ZF com canal quase singular os pontos podem ser enormes ou infinitos: todos devem ser
+ * decididos como o canto da constelação do lado em que estão, tanto nas 8 lanes do AVX2 quanto no
+ * laço escalar (17 pontos iguais: duas iterações vetoriais e um ponto na cauda). NaN vai para o nível 0.
+ * 
+ * @return O número de verificações com falha
+*/
+int teste_telecom(void) {
+    const long int ordens[] = {4, 16, 64, 256};
+    // Cada ponto extremo e um ponto finito fora da constelação, no mesmo canto
+    const complex extremos[][2] = {
+        {{INFINITY, -INFINITY}, {100.0f, -100.0f}},
+        {{-INFINITY, INFINITY}, {-100.0f, 100.0f}},
+        {{1e30f, -1e30f}, {100.0f, -100.0f}},
+        {{-FLT_MAX, FLT_MAX}, {-100.0f, 100.0f}},
+        {{INFINITY, 1e30f}, {100.0f, 100.0f}},
+        {{NAN, NAN}, {-100.0f, 100.0f}},
+    };
+    const int num_pontos = 17;
+    complex pontos[17];
+    int falhas = 0;
+
+    printf("\n  ============ Teste da decisão abrupta com pontos extremos ============ \n\n");
+
+    for (int o = 0; o < 4; o++) {
+        int bits = tx_qam_bits(ordens[o]);
+        tx_simbolos saida = tx_simbolos_alloc(num_pontos * bits / 2);
+
+        if (saida.bytes == NULL) {
+            return falhas + 1;
+        }
+
+        for (int e = 0; e < (int)(sizeof(extremos) / sizeof(extremos[0])); e++) {
+            int esperado, errados = 0;
+
+            rx_qam_demapper_em(&extremos[e][1], 1, ordens[o], &saida);
+            esperado = tx_qam_indice(saida, 0, bits);
+
+            for (int p = 0; p < num_pontos; p++) {
+                pontos[p] = extremos[e][0];
+            }
+            rx_qam_demapper_em(pontos, num_pontos, ordens[o], &saida);
+
+            for (int p = 0; p < num_pontos; p++) {
+                errados += tx_qam_indice(saida, p, bits) != esperado;
+            }
+
+            char nome[64];
+            snprintf(nome, sizeof(nome), "rx_qam_demapper_em %ld-QAM (%g, %g)", ordens[o], extremos[e][0].Re, extremos[e][0].Im);
+            falhas += testeConfere(nome, errados == 0, "rotulo %d, %d pontos errados", esperado, errados);
+        }
+
+        tx_simbolos_free(saida);
+    }
+
+    return falhas;
+}
+
+int main() {
+
+    char *filename = "in";
+    char *filename_saida = "out";
+
+    FILE *file = fopen(filename, "rb"); // Abre o arquivo binário para leitura
+
+    if (file == NULL) { // Verifica se houve falha na abertura do arquivo
+        printf("Erro ao abrir o arquivo %s\n", filename);
+        return 1;
+    } else {
+        printf("O arquivo foi aberto\n\n");
+    }
+
+    fseek(file, 0, SEEK_END);
+    long int file_size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    // O transmissor lê o arquivo uma só vez, em blocos, indo dos bytes às camadas em uma só passagem,
+    // e o receptor desfaz cada bloco: camadas -> pontos QAM -> bits. A memória usada é a de um bloco,
+    // qualquer que seja o tamanho do arquivo
+    int num_streams = 4;
+    long int qam = 4;
+    long int total_simbolos = file_size * 4; // Símbolos do arquivo, sem o padding do último bloco
+    tx_pipeline tx;
+    complexMatrix camadas;
+    long int instantes, primeiro = 0, impressos = 0;
+    tx_simbolos recebido = {NULL, 0, 0};
+    rx_escritor escritor;
+    FILE *out;
+
+    if (tx_pipeline_init(&tx, file, qam, num_streams, 0) != 0) {
+        fclose(file);
+        return 1;
+    }
+
+    // O receptor só guarda um bloco por vez: cada bloco demapeado vai direto para o escritor,
+    // que descarta o padding (só os símbolos do arquivo de entrada são escritos)
+    // As falhas de alocação já são informadas por tx_simbolos_alloc e rx_escritor_init
+    recebido = tx_simbolos_alloc(tx.colunas_por_bloco * num_streams * tx.bits / 2);
+
+    if (recebido.bytes == NULL) {
+        tx_pipeline_free(&tx);
+        fclose(file);
+        return 1;
+    }
+
+    out = fopen(filename_saida, "wb");
+
+    if (out == NULL) {
+        printf("Erro ao abrir o arquivo %s.\n", filename_saida);
+        tx_simbolos_free(recebido);
+        tx_pipeline_free(&tx);
+        fclose(file);
+        return 1;
+    }
+
+    if (rx_escritor_init(&escritor, out, total_simbolos) != 0) {
+        fclose(out);
+        tx_simbolos_free(recebido);
+        tx_pipeline_free(&tx);
+        fclose(file);
+        return 1;
+    }
+    printf("\nArquivo %s criado.\n\n", filename_saida);
+
+    while ((instantes = tx_pipeline_proximo_bloco(&tx, &camadas)) > 0) {
+        // Imprime os símbolos lidos no bloco (sem o padding)
+        for (long int i = 0; i < tx.bloco.num_simbolos && impressos < total_simbolos; i++, impressos++) {
+            printf("%d, ", tx_simbolo(tx.bloco, i));
+        }
+        printf("\n");
+
+        // Imprime os números complexs do bloco, na ordem do vetor
+        for (long int j = 0; j < instantes; j++) {
+            for (int s = 0; s < num_streams; s++) {
+                printf("Índice %ld: %.2f%+.2fj\n ", (primeiro + j) * num_streams + s, MATRIX_ELEM(camadas, j, s).Re, MATRIX_ELEM(camadas, j, s).Im);
+            }
+        }
+        printf("\n");
+
+        // Imprime os símbolos mapeados para cada fluxo: o fluxo i é a coluna i das camadas
+        for (int i = 0; i < num_streams; i++) {
+            for (long int j = 0; j < instantes; j++) {
+                printf("Fluxo %d: %.2f%+.2fj\n", i, MATRIX_ELEM(camadas, j, i).Re, MATRIX_ELEM(camadas, j, i).Im);
+            }
+        }
+
+        // Recepção do bloco: as camadas já estão na ordem do vetor, então o demapeamento em camadas
+        // não copia nada, e os bits do bloco seguem para o arquivo de saída
+        rx_qam_demapper_em(rx_layer_view(camadas), instantes * num_streams, qam, &recebido);
+        rx_escritor_escreve(&escritor, recebido);
+
+        primeiro += instantes;
+    }
+
+    if (instantes < 0) { // O arquivo de saída fica com os blocos recebidos antes do erro
+        printf("Erro ao ler o arquivo %s.\n", filename);
+    }
+    if (rx_escritor_fim(&escritor) != 0) { // Escreve o que resta dos bits recebidos no arquivo binário
+        printf("Erro ao escrever o arquivo %s.\n", filename_saida);
+    }
+    fclose(out);
+
+    tx_pipeline_free(&tx);
+    tx_simbolos_free(recebido);
+
+    fclose(file); // Fecha o arquivo
+
+    if (instantes < 0) {
+        return 1;
+    }
+
+    int Nr = 4; // Número de antenas receptoras
+    int Nt = 3; // Número de antenas transmissoras
+
+    // Um canal por quadro, cada um no subfluxo (0, quadro) da semente da simulação: a mesma semente gera
+    // os mesmos canais em toda execução. As matrizes Nr x Nt vêm do pool, então a partir do segundo
+    // quadro o canal reusa o bloco devolvido pelo quadro anterior, sem malloc nem free
+    int num_quadros = 4;
+    matrixPool pool;
+    poolInit(&pool);
+
+    for (int quadro = 0; quadro < num_quadros; quadro++) {
+        aleatorioGerador gerador;
+        aleatorioInit(&gerador, TX_SEMENTE, 0, (uint32_t)quadro);
+
+        complexMatrix H = poolObtem(&pool, Nr, Nt);
+        canal_rayleigh_em(&gerador, H); // Gera a matriz do canal aleatório
+
+        // Imprime a matriz do canal
+        printf("\nCanal do quadro %d:\n", quadro);
+        for (int i = 0; i < Nr; i++) {
+            for (int j = 0; j < Nt; j++) {
+                printf("%.2f%+.2fj\t", MATRIX_ELEM(H, i, j).Re, MATRIX_ELEM(H, i, j).Im);
+            }
+            printf("\n");
+        }
+
+        poolDevolve(&pool, H);
+    }
+
+    poolFree(&pool);
+
+    // O programa termina com erro se alguma verificação falhar
+    return teste_telecom() != 0;
 }
\ No newline at end of file
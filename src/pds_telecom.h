@@ -1,10 +1,104 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <gsl/gsl_linalg.h>
 #include "matrizes.h"
+#include "matrizes_lote.h"
+#include "ponto_fixo.h"
+#include "aleatorio.h"
 
-int * tx_data_read(FILE *file, long int sequencia_bytes);
-void rx_data_write(int *s, long int sequencia_bytes, char *filename);
-complex *tx_qam_mapper(int *s, long int qam);
+// Tamanho padrão, em bytes, de cada leitura do arquivo de entrada
+#define TX_BLOCO_LEITURA (1L << 20)
+
+// Semente das simulações: cada canal, usuário ou quadro usa um subfluxo (fluxo, quadro) dela
+#define TX_SEMENTE 0x5044535F54454CULL
+
+// Símbolos de 2 bits empacotados, 4 por byte, do par de bits menos significativo para o mais
+// significativo: o mesmo formato do arquivo, 16 vezes menor que um int por símbolo
+typedef struct {
+    unsigned char *bytes;  // Os símbolos empacotados
+    long int num_simbolos; // Número de símbolos de 2 bits
+    long int capacidade;   // Símbolos que cabem nos bytes alocados (num_simbolos mais a reserva)
+} tx_simbolos;
+
+// Símbolos reservados além do tamanho em cada alocação: o padding de até 64 streams em 256-QAM
+// (menos de 64 * 8 / 2 símbolos) cabe sem realocar
+#define TX_RESERVA_PADDING 256
+
+// Número de bytes ocupados por n símbolos de 2 bits
+#define TX_SIMBOLOS_BYTES(n) (((n) + 3) / 4)
+
+// Símbolo i (0..3) de um vetor de símbolos empacotados
+static inline int tx_simbolo(tx_simbolos simbolos, long int i) {
+    return (simbolos.bytes[i >> 2] >> (2 * (i & 3))) & 0x03;
+}
+
+// Leitor do arquivo de entrada em blocos de tamanho fixo: a memória usada não depende do tamanho do arquivo
+typedef struct {
+    FILE *arquivo;            // Arquivo de entrada (aberto e fechado pelo chamador)
+    long int bytes_por_bloco; // Bytes lidos por bloco (4 símbolos de 2 bits por byte)
+} tx_leitor;
+
+tx_simbolos tx_simbolos_alloc(long int num_simbolos);
+void tx_simbolos_free(tx_simbolos simbolos);
+int tx_leitor_init(tx_leitor *leitor, FILE *file, long int simbolos_por_bloco);
+long int tx_leitor_proximo_bloco(tx_leitor *leitor, tx_simbolos *bloco);
+
+// Pontos por bloco do transmissor em blocos, quando o chamador não escolhe: 16 KiB de complexs
+#define TX_PIPELINE_PONTOS 2048
+
+// Transmissor em blocos: leitura, mapeamento QAM e em camadas de um bloco por vez, com os
+// intermediários do tamanho de um bloco
+typedef struct {
+    tx_leitor leitor;           // Leitor do arquivo de entrada
+    long int qam;               // Ordem da constelação
+    int bits;                   // Bits por ponto QAM
+    int num_stream;             // Número de streams
+    long int colunas_por_bloco; // Instantes por bloco (múltiplo de 8)
+    tx_simbolos bloco;          // Bytes do bloco atual, empacotados
+    complex *pontos;            // Pontos QAM do bloco atual, na ordem do vetor
+} tx_pipeline;
+
+// Tamanho, em bytes, do buffer de escrita do arquivo de saída
+#define RX_BLOCO_ESCRITA ((size_t)1 << 20)
+
+// Escritor do arquivo de saída: junta blocos de símbolos em um buffer grande, 32 símbolos por palavra
+typedef struct {
+    FILE *arquivo;         // Arquivo de saída (aberto e fechado pelo chamador)
+    unsigned char *buffer; // Buffer de RX_BLOCO_ESCRITA bytes
+    size_t usados;         // Bytes ocupados no buffer
+    uint64_t palavra;      // Símbolos pendentes, que ainda não completam uma palavra
+    int pendentes;         // Número de símbolos pendentes (0..31)
+    long int restantes;    // Símbolos que ainda podem ser escritos
+} rx_escritor;
+
+tx_simbolos tx_data_read(FILE *file, long int sequencia_bytes);
+tx_simbolos tx_data_padding(int padding, tx_simbolos simbolos);
+int rx_escritor_init(rx_escritor *escritor, FILE *file, long int num_simbolos);
+void rx_escritor_escreve(rx_escritor *escritor, tx_simbolos bloco);
+int rx_escritor_fim(rx_escritor *escritor);
+void rx_data_write(tx_simbolos s, long int sequencia_bytes, char *filename);
+int tx_qam_constelacao(long int qam, complex *pontos);
+long int tx_qam_pontos(long int num_simbolos, long int qam);
+complex *tx_qam_mapper(tx_simbolos simbolos, long int qam);
+int tx_qam_mapper_em(tx_simbolos simbolos, long int qam, complex *simbolo);
+int tx_pipeline_init(tx_pipeline *tx, FILE *file, long int qam, int num_stream, long int colunas_por_bloco);
+long int tx_pipeline_proximo_bloco(tx_pipeline *tx, complexMatrix *camadas);
+void tx_pipeline_free(tx_pipeline *tx);
 complex **tx_layer_mapper(complex *v, int Nstream, long int Nsymbol);
-float gerar_float_aleatorio();
\ No newline at end of file
+int tx_layer_view(complex *v, int Nstream, long int Nsymbol, complexMatrix *camadas);
+int tx_layer_mapper_em(complex *v, long int Nsymbol, complexMatrix destino);
+float tx_qam_escala_q15(long int qam);
+int tx_qam_mapper_q15_em(tx_simbolos simbolos, long int qam, complexQ15 *simbolo);
+int tx_layer_mapper_q15_em(complexQ15 *v, long int Nsymbol, complexMatrixQ15 destino);
+complex *rx_layer_view(complexMatrix camadas);
+complex *rx_layer_demapper(complex **camadas, int num_stream, long int num_simbolo);
+int rx_layer_demapper_em(complexMatrix camadas, long int num_simbolo, complex *destino);
+int rx_qam_demapper_em(const complex *pontos, long int num_pontos, long int qam, tx_simbolos *saida);
+int rx_qam_llr_em(const complex *pontos, long int num_pontos, long int qam, float sigma2, float *llr);
+int canal_rayleigh_em(aleatorioGerador *gerador, complexMatrix H);
+int canal_rician_em(aleatorioGerador *gerador, float K, complexMatrix los, complexMatrix H);
+int canal_rayleigh_lote_em(aleatorioGerador *gerador, complexMatrixLote H);
+int canal_rician_lote_em(aleatorioGerador *gerador, float K, complexMatrix los, complexMatrixLote H);
+complexMatrix channel_gen(int Nr, int Nt, aleatorioGerador *gerador);
+int teste_telecom(void);
@@ -0,0 +1,633 @@
+/**
+ * @file ponto_fixo.c
+ * @brief Implementation file for the Q15 (int16 fixed-point) complex datapath.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+/// including the files where the structures are contained
+#include "ponto_fixo.h"
+#include "matrizes.h"
+#include "teste.h"
+
+/************************************* VECTOR KERNELS ***************************************/
+
+#if defined(__AVX2__) && defined(__FMA__)
+/**
+ * @brief Eight q15Mul at a time (sixteen lanes): pmulhrsw, with the (-1) * (-1) case saturated.
+ *
+ * pmulhrsw wraps that single case to -32768. It is the only product that rounds to 0x8000 while
+ * both factors have the same sign, which is what the correction looks for.
+ */
+static inline __m256i q15MulV(__m256i x, __m256i y)
+{
+    const __m256i r = _mm256_mulhrs_epi16(x, y);
+    const __m256i estouro = _mm256_cmpeq_epi16(r, _mm256_set1_epi16(INT16_MIN));
+    const __m256i mesmoSinal = _mm256_cmpgt_epi16(_mm256_xor_si256(x, y), _mm256_set1_epi16(-1));
+
+    //! 0x8000 ^ 0xFFFF = 0x7FFF
+    return _mm256_xor_si256(r, _mm256_and_si256(estouro, mesmoSinal));
+}
+
+/**
+ * @brief Eight q15Produto at a time on interleaved complex numbers.
+ */
+static inline __m256i q15ProdutoV(__m256i a, __m256i b)
+{
+    const __m256i repeteRe = _mm256_setr_epi8(0, 1, 0, 1, 4, 5, 4, 5, 8, 9, 8, 9, 12, 13, 12, 13,
+                                              0, 1, 0, 1, 4, 5, 4, 5, 8, 9, 8, 9, 12, 13, 12, 13);
+    const __m256i repeteIm = _mm256_setr_epi8(2, 3, 2, 3, 6, 7, 6, 7, 10, 11, 10, 11, 14, 15, 14, 15,
+                                              2, 3, 2, 3, 6, 7, 6, 7, 10, 11, 10, 11, 14, 15, 14, 15);
+    const __m256i troca = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+                                           2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+
+    //! p1 = (ar br, ai br), p2 = (ai bi, ar bi)
+    const __m256i p1 = q15MulV(a, _mm256_shuffle_epi8(b, repeteRe));
+    const __m256i p2 = q15MulV(_mm256_shuffle_epi8(a, troca), _mm256_shuffle_epi8(b, repeteIm));
+
+    //! Real parts (even lanes) from p1 - p2, imaginary parts (odd lanes) from p1 + p2
+    return _mm256_blend_epi16(_mm256_subs_epi16(p1, p2), _mm256_adds_epi16(p1, p2), 0xAA);
+}
+#endif
+
+/**
+ * @brief Same clamping and rounding as the vector path (min/max then cvtps), NaN included.
+ */
+static inline q15 q15Quantiza(float x, float fator)
+{
+    float v = x * fator;
+
+    v = (v < 32767.0f) ? v : 32767.0f;
+    v = (v > -32768.0f) ? v : -32768.0f;
+
+    return (q15)lrintf(v);
+}
+
+/**
+ * @brief Checks that two Q15 matrices have the same shape.
+ */
+static int q15MesmaForma(complexMatrixQ15 a, complexMatrixQ15 b)
+{
+    return a.linhas == b.linhas && a.colunas == b.colunas;
+}
+
+/************************************* ALLOCATION AND CONVERSION ***************************************/
+
+/**
+ * @param[in] linhas Number of rows
+ * @param[in] colunas Number of columns
+ *
+ * @brief Allocates the matrix in a single aligned block, with the leading dimension rounded up to 16 elements.
+ *
+ * @return The allocated complexMatrixQ15.
+ */
+complexMatrixQ15 allocateComplexMatrixQ15(int linhas, int colunas)
+{
+    complexMatrixQ15 matrix;
+    const int porLinha = MATRIX_ALINHAMENTO / (int)sizeof(complexQ15);
+
+    matrix.linhas = linhas;
+    matrix.colunas = colunas;
+    matrix.ld = (colunas + porLinha - 1) / porLinha * porLinha;
+    matrix.bloco = matrixAlignedAlloc((size_t)linhas * matrix.ld * sizeof(complexQ15));
+
+    if (matrix.bloco == NULL)
+    {
+        printf("Falha na alocacao de memoria\n");
+        exit(1);
+    }
+
+    matrix.dados = (complexQ15 *)matrix.bloco;
+
+    return matrix;
+}
+
+/**
+ * @brief Frees the block of a Q15 complex matrix.
+ */
+void freeComplexMatrixQ15(complexMatrixQ15 matrix)
+{
+    matrixAlignedFree(matrix.bloco);
+}
+
+/**
+ * @param[out] destino The Q15 matrix
+ * @param[in] origem The float matrix
+ * @param[in] escala Factor applied before quantization
+ *
+ * @brief Quantizes every part of origem; with AVX2, eight complex numbers at a time.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixParaQ15(complexMatrixQ15 destino, complexMatrix origem, float escala)
+{
+    if (destino.linhas != origem.linhas || destino.colunas != origem.colunas)
+    {
+        return -1;
+    }
+
+    const float fator = escala * 32768.0f;
+
+    for (int i = 0; i < origem.linhas; i++)
+    {
+        const complex *linha = matrixLinha(origem, i);
+        complexQ15 *q = destino.dados + (size_t)i * destino.ld;
+        int j = 0;
+
+#if defined(__AVX2__) && defined(__FMA__)
+        const __m256 f = _mm256_set1_ps(fator);
+        const __m256 maximo = _mm256_set1_ps(32767.0f), minimo = _mm256_set1_ps(-32768.0f);
+
+        for (; j + 8 <= origem.colunas; j += 8)
+        {
+            __m256 a = _mm256_mul_ps(_mm256_loadu_ps(&linha[j].Re), f);
+            __m256 b = _mm256_mul_ps(_mm256_loadu_ps(&linha[j + 4].Re), f);
+
+            a = _mm256_max_ps(_mm256_min_ps(a, maximo), minimo);
+            b = _mm256_max_ps(_mm256_min_ps(b, maximo), minimo);
+
+            //! packs works per 128-bit lane: c0 c1 | c4 c5 | c2 c3 | c6 c7, put back in order by the permutation
+            const __m256i p = _mm256_packs_epi32(_mm256_cvtps_epi32(a), _mm256_cvtps_epi32(b));
+            _mm256_storeu_si256((__m256i *)(q + j), _mm256_permute4x64_epi64(p, _MM_SHUFFLE(3, 1, 2, 0)));
+        }
+#endif
+        for (; j < origem.colunas; j++)
+        {
+            q[j].Re = q15Quantiza(linha[j].Re, fator);
+            q[j].Im = q15Quantiza(linha[j].Im, fator);
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @param[out] destino The float matrix
+ * @param[in] origem The Q15 matrix
+ * @param[in] escala The factor given to matrixParaQ15
+ *
+ * @brief Converts every part of origem back to float.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int q15ParaMatrix(complexMatrix destino, complexMatrixQ15 origem, float escala)
+{
+    if (destino.linhas != origem.linhas || destino.colunas != origem.colunas)
+    {
+        return -1;
+    }
+
+    const float inverso = 1.0f / (escala * 32768.0f);
+
+    for (int i = 0; i < origem.linhas; i++)
+    {
+        complex *linha = matrixLinha(destino, i);
+        const complexQ15 *q = origem.dados + (size_t)i * origem.ld;
+        int j = 0;
+
+#if defined(__AVX2__) && defined(__FMA__)
+        const __m256 f = _mm256_set1_ps(inverso);
+
+        for (; j + 8 <= origem.colunas; j += 8)
+        {
+            const __m256i p = _mm256_loadu_si256((const __m256i *)(q + j));
+            const __m256i baixo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(p));
+            const __m256i alto = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(p, 1));
+
+            _mm256_storeu_ps(&linha[j].Re, _mm256_mul_ps(_mm256_cvtepi32_ps(baixo), f));
+            _mm256_storeu_ps(&linha[j + 4].Re, _mm256_mul_ps(_mm256_cvtepi32_ps(alto), f));
+        }
+#endif
+        for (; j < origem.colunas; j++)
+        {
+            linha[j].Re = (float)q[j].Re * inverso;
+            linha[j].Im = (float)q[j].Im * inverso;
+        }
+    }
+
+    return 0;
+}
+
+/************************************* OPERATIONS ***************************************/
+
+/*!
+* @brief Element-wise operations shared by q15SomaEm, q15SubtracaoEm and q15ProdutoElementosEm.
+*/
+typedef enum
+{
+    Q15_SOMA,
+    Q15_SUBTRACAO,
+    Q15_PRODUTO
+} q15Operacao;
+
+/**
+ * @brief Applies an element-wise operation row by row, sixteen lanes at a time with AVX2.
+ */
+static int q15Elementos(complexMatrixQ15 destino, complexMatrixQ15 matrix1, complexMatrixQ15 matrix2, q15Operacao op)
+{
+    if (!q15MesmaForma(destino, matrix1) || !q15MesmaForma(matrix1, matrix2))
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < destino.linhas; i++)
+    {
+        complexQ15 *d = destino.dados + (size_t)i * destino.ld;
+        const complexQ15 *a = matrix1.dados + (size_t)i * matrix1.ld;
+        const complexQ15 *b = matrix2.dados + (size_t)i * matrix2.ld;
+        int j = 0;
+
+#if defined(__AVX2__) && defined(__FMA__)
+        for (; j + 8 <= destino.colunas; j += 8)
+        {
+            const __m256i x = _mm256_loadu_si256((const __m256i *)(a + j));
+            const __m256i y = _mm256_loadu_si256((const __m256i *)(b + j));
+            __m256i r;
+
+            switch (op)
+            {
+            case Q15_SOMA:
+                r = _mm256_adds_epi16(x, y);
+                break;
+            case Q15_SUBTRACAO:
+                r = _mm256_subs_epi16(x, y);
+                break;
+            default:
+                r = q15ProdutoV(x, y);
+                break;
+            }
+
+            _mm256_storeu_si256((__m256i *)(d + j), r);
+        }
+#endif
+        for (; j < destino.colunas; j++)
+        {
+            switch (op)
+            {
+            case Q15_SOMA:
+                d[j] = q15Soma(a[j], b[j]);
+                break;
+            case Q15_SUBTRACAO:
+                d[j] = q15Subtracao(a[j], b[j]);
+                break;
+            default:
+                d[j] = q15Produto(a[j], b[j]);
+                break;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @param[out] destino The sum
+ * @param[in] matrix1 The first matrix
+ * @param[in] matrix2 The second matrix
+ *
+ * @brief Saturating sum of two Q15 matrices.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int q15SomaEm(complexMatrixQ15 destino, complexMatrixQ15 matrix1, complexMatrixQ15 matrix2)
+{
+    return q15Elementos(destino, matrix1, matrix2, Q15_SOMA);
+}
+
+/**
+ * @param[out] destino The difference
+ * @param[in] matrix1 The first matrix
+ * @param[in] matrix2 The second matrix
+ *
+ * @brief Saturating difference of two Q15 matrices.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int q15SubtracaoEm(complexMatrixQ15 destino, complexMatrixQ15 matrix1, complexMatrixQ15 matrix2)
+{
+    return q15Elementos(destino, matrix1, matrix2, Q15_SUBTRACAO);
+}
+
+/**
+ * @param[out] destino The element-wise product
+ * @param[in] matrix1 The first matrix
+ * @param[in] matrix2 The second matrix
+ *
+ * @brief Element-wise complex product of two Q15 matrices (q15Produto on every pair).
+ *
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int q15ProdutoElementosEm(complexMatrixQ15 destino, complexMatrixQ15 matrix1, complexMatrixQ15 matrix2)
+{
+    return q15Elementos(destino, matrix1, matrix2, Q15_PRODUTO);
+}
+
+/**
+ * @param[out] destino The conjugate transpose
+ * @param[in] matrix The matrix
+ *
+ * @brief Writes conj(matrix(i, j)) into destino(j, i), saturating the negation of -32768.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int q15HermitianaEm(complexMatrixQ15 destino, complexMatrixQ15 matrix)
+{
+    if (destino.linhas != matrix.colunas || destino.colunas != matrix.linhas)
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < matrix.linhas; i++)
+    {
+        for (int j = 0; j < matrix.colunas; j++)
+        {
+            const complexQ15 a = Q15_ELEM(matrix, i, j);
+
+            Q15_ELEM(destino, j, i).Re = a.Re;
+            Q15_ELEM(destino, j, i).Im = q15Satura(-(int32_t)a.Im);
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @param[out] destino The product (m x n)
+ * @param[in] matrix1 The matrix A (m x k)
+ * @param[in] matrix2 The matrix B (k x n)
+ *
+ * @brief Q15 matrix product with 32-bit accumulation.
+ *
+ * Each element of A is broadcast against eight columns of a row of B; the Q15 products are widened
+ * to 32 bits and accumulated, and each block of eight results is saturated to Q15 once, when stored.
+ *
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int q15ProdutoEm(complexMatrixQ15 destino, complexMatrixQ15 matrix1, complexMatrixQ15 matrix2)
+{
+    if (matrix1.colunas != matrix2.linhas || destino.linhas != matrix1.linhas || destino.colunas != matrix2.colunas)
+    {
+        return -1;
+    }
+
+    const int k = matrix1.colunas, n = matrix2.colunas;
+
+    for (int i = 0; i < destino.linhas; i++)
+    {
+        const complexQ15 *a = matrix1.dados + (size_t)i * matrix1.ld;
+        complexQ15 *d = destino.dados + (size_t)i * destino.ld;
+        int j = 0;
+
+#if defined(__AVX2__) && defined(__FMA__)
+        for (; j + 8 <= n; j += 8)
+        {
+            __m256i baixo = _mm256_setzero_si256(), alto = _mm256_setzero_si256();
+
+            for (int p = 0; p < k; p++)
+            {
+                int32_t bits;
+                memcpy(&bits, &a[p], sizeof(bits));
+
+                const __m256i b = _mm256_loadu_si256((const __m256i *)(matrix2.dados + (size_t)p * matrix2.ld + j));
+                const __m256i termo = q15ProdutoV(_mm256_set1_epi32(bits), b);
+
+                baixo = _mm256_add_epi32(baixo, _mm256_cvtepi16_epi32(_mm256_castsi256_si128(termo)));
+                alto = _mm256_add_epi32(alto, _mm256_cvtepi16_epi32(_mm256_extracti128_si256(termo, 1)));
+            }
+
+            const __m256i r = _mm256_packs_epi32(baixo, alto);
+            _mm256_storeu_si256((__m256i *)(d + j), _mm256_permute4x64_epi64(r, _MM_SHUFFLE(3, 1, 2, 0)));
+        }
+#endif
+        for (; j < n; j++)
+        {
+            int32_t re = 0, im = 0;
+
+            for (int p = 0; p < k; p++)
+            {
+                const complexQ15 termo = q15Produto(a[p], Q15_ELEM(matrix2, p, j));
+
+                re += termo.Re;
+                im += termo.Im;
+            }
+
+            d[j].Re = q15Satura(re);
+            d[j].Im = q15Satura(im);
+        }
+    }
+
+    return 0;
+}
+
+/************************************* TESTS ***************************************/
+
+/**
+ * @brief Fills a Q15 matrix with deterministic values: a third of them at the extremes -32768 and
+ * 32767, the others anywhere in the Q15 range.
+ */
+static void testeQ15Preenche(complexMatrixQ15 matrix, unsigned semente)
+{
+    uint32_t estado = 2463534242u ^ (semente * 2654435761u);
+
+    for (int i = 0; i < matrix.linhas; i++)
+    {
+        for (int j = 0; j < matrix.colunas; j++)
+        {
+            q15 partes[2];
+
+            for (int p = 0; p < 2; p++)
+            {
+                const uint32_t valor = testeSorteia(&estado);
+
+                switch (valor % 6)
+                {
+                case 0:
+                    partes[p] = INT16_MIN;
+                    break;
+                case 1:
+                    partes[p] = INT16_MAX;
+                    break;
+                default:
+                    partes[p] = (q15)(valor >> 16);
+                    break;
+                }
+            }
+
+            Q15_ELEM(matrix, i, j).Re = partes[0];
+            Q15_ELEM(matrix, i, j).Im = partes[1];
+        }
+    }
+}
+
+/**
+ * @brief Fills a Q15 matrix with a single value.
+ */
+static void testeQ15Constante(complexMatrixQ15 matrix, q15 re, q15 im)
+{
+    for (int i = 0; i < matrix.linhas; i++)
+    {
+        for (int j = 0; j < matrix.colunas; j++)
+        {
+            Q15_ELEM(matrix, i, j).Re = re;
+            Q15_ELEM(matrix, i, j).Im = im;
+        }
+    }
+}
+
+/**
+ * @brief Counts the elements of two Q15 matrices of the same shape whose bits differ.
+ */
+static long testeQ15Diferencas(complexMatrixQ15 a, complexMatrixQ15 b)
+{
+    long diferentes = 0;
+
+    for (int i = 0; i < a.linhas; i++)
+    {
+        for (int j = 0; j < a.colunas; j++)
+        {
+            diferentes += (Q15_ELEM(a, i, j).Re != Q15_ELEM(b, i, j).Re) || (Q15_ELEM(a, i, j).Im != Q15_ELEM(b, i, j).Im);
+        }
+    }
+
+    return diferentes;
+}
+
+/**
+ * @brief Reference model of q15ProdutoEm: q15Produto on every term, 32-bit sum, one saturation at the end.
+ */
+static void testeQ15ProdutoModelo(complexMatrixQ15 destino, complexMatrixQ15 matrix1, complexMatrixQ15 matrix2)
+{
+    for (int i = 0; i < destino.linhas; i++)
+    {
+        for (int j = 0; j < destino.colunas; j++)
+        {
+            int32_t re = 0, im = 0;
+
+            for (int p = 0; p < matrix1.colunas; p++)
+            {
+                const complexQ15 termo = q15Produto(Q15_ELEM(matrix1, i, p), Q15_ELEM(matrix2, p, j));
+
+                re += termo.Re;
+                im += termo.Im;
+            }
+
+            Q15_ELEM(destino, i, j).Re = q15Satura(re);
+            Q15_ELEM(destino, i, j).Im = q15Satura(im);
+        }
+    }
+}
+
+/**
+ * @brief Checks that the vector kernels give exactly the bits of the scalar reference model.
+ *
+ * The inputs include -32768 and 32767 in every combination, so (-1) * (-1) and the saturation of the
+ * complex combination are exercised, and the column counts are both multiples and non-multiples of 8,
+ * so the vector loop and the scalar tail both run. The last product accumulates long runs of
+ * (-1) * (-1) to reach the final saturation.
+ *
+ * @return The number of failed checks.
+ */
+int teste_ponto_fixo(void)
+{
+    //! Shapes (m, k, n) of the products: n is a multiple of 8, not one, smaller than 8 and larger than 16
+    const int formas[][3] = {{5, 7, 16}, {4, 9, 13}, {3, 33, 8}, {2, 5, 3}, {6, 4, 29}};
+    const int numFormas = (int)(sizeof(formas) / sizeof(formas[0]));
+    int falhas = 0;
+
+    printf("\n  ============ Teste do datapath Q15 (vetorial x modelo escalar) ============ \n\n");
+
+    for (int f = 0; f < numFormas; f++)
+    {
+        const int m = formas[f][0], k = formas[f][1], n = formas[f][2];
+        complexMatrixQ15 A = allocateComplexMatrixQ15(m, k);
+        complexMatrixQ15 B = allocateComplexMatrixQ15(k, n);
+        complexMatrixQ15 X = allocateComplexMatrixQ15(m, n);
+        complexMatrixQ15 Y = allocateComplexMatrixQ15(m, n);
+        complexMatrixQ15 modelo = allocateComplexMatrixQ15(m, n);
+        complexMatrixQ15 resultado = allocateComplexMatrixQ15(m, n);
+        int status;
+        long diferentes;
+
+        testeQ15Preenche(A, 10 + (unsigned)f);
+        testeQ15Preenche(B, 20 + (unsigned)f);
+        testeQ15Preenche(X, 30 + (unsigned)f);
+        testeQ15Preenche(Y, 40 + (unsigned)f);
+
+        testeQ15ProdutoModelo(modelo, A, B);
+        status = q15ProdutoEm(resultado, A, B);
+        diferentes = testeQ15Diferencas(resultado, modelo);
+        falhas += testeConfere("q15ProdutoEm", status == 0 && diferentes == 0, "%d x %d, %ld elementos diferentes", m, n, diferentes);
+
+        for (int i = 0; i < m; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                Q15_ELEM(modelo, i, j) = q15Produto(Q15_ELEM(X, i, j), Q15_ELEM(Y, i, j));
+            }
+        }
+        status = q15ProdutoElementosEm(resultado, X, Y);
+        diferentes = testeQ15Diferencas(resultado, modelo);
+        falhas += testeConfere("q15ProdutoElementosEm", status == 0 && diferentes == 0, "%d x %d, %ld elementos diferentes", m, n, diferentes);
+
+        for (int i = 0; i < m; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                Q15_ELEM(modelo, i, j) = q15Soma(Q15_ELEM(X, i, j), Q15_ELEM(Y, i, j));
+            }
+        }
+        status = q15SomaEm(resultado, X, Y);
+        diferentes = testeQ15Diferencas(resultado, modelo);
+        falhas += testeConfere("q15SomaEm", status == 0 && diferentes == 0, "%d x %d, %ld elementos diferentes", m, n, diferentes);
+
+        for (int i = 0; i < m; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                Q15_ELEM(modelo, i, j) = q15Subtracao(Q15_ELEM(X, i, j), Q15_ELEM(Y, i, j));
+            }
+        }
+        status = q15SubtracaoEm(resultado, X, Y);
+        diferentes = testeQ15Diferencas(resultado, modelo);
+        falhas += testeConfere("q15SubtracaoEm", status == 0 && diferentes == 0, "%d x %d, %ld elementos diferentes", m, n, diferentes);
+
+        freeComplexMatrixQ15(A);
+        freeComplexMatrixQ15(B);
+        freeComplexMatrixQ15(X);
+        freeComplexMatrixQ15(Y);
+        freeComplexMatrixQ15(modelo);
+        freeComplexMatrixQ15(resultado);
+    }
+
+    //! (-1 - i) * (-1 - i) = 2i per term: the 32-bit sums overflow Q15 and must saturate once, at the end
+    {
+        const int m = 3, k = 40, n = 11;
+        complexMatrixQ15 A = allocateComplexMatrixQ15(m, k);
+        complexMatrixQ15 B = allocateComplexMatrixQ15(k, n);
+        complexMatrixQ15 modelo = allocateComplexMatrixQ15(m, n);
+        complexMatrixQ15 resultado = allocateComplexMatrixQ15(m, n);
+        int status;
+        long diferentes;
+
+        testeQ15Constante(A, INT16_MIN, INT16_MIN);
+        testeQ15Constante(B, INT16_MIN, INT16_MIN);
+        testeQ15ProdutoModelo(modelo, A, B);
+        status = q15ProdutoEm(resultado, A, B);
+        diferentes = testeQ15Diferencas(resultado, modelo);
+        falhas += testeConfere("q15ProdutoEm (-1 - i)^2", status == 0 && diferentes == 0, "%d x %d, %ld elementos diferentes", m, n, diferentes);
+
+        freeComplexMatrixQ15(A);
+        freeComplexMatrixQ15(B);
+        freeComplexMatrixQ15(modelo);
+        freeComplexMatrixQ15(resultado);
+    }
+
+    return falhas;
+}
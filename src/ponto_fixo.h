@@ -0,0 +1,190 @@
+/**
+ * @file ponto_fixo.h
+ * @brief Header file for the Q15 (int16 fixed-point) complex datapath.
+ */
+
+#ifndef PONTO_FIXO_H
+#define PONTO_FIXO_H
+#include <stdint.h>
+#include "matrizes.h"
+
+/*!
+* @brief Q15 number: int16 with 15 fractional bits, covering [-1, 1 - 2^-15].
+*/
+typedef int16_t q15;
+
+/*!
+* @brief Complex number in Q15, half the size of the float 'complex'.
+*/
+typedef struct
+{
+    q15 Re; /*!< Real part */
+    q15 Im; /*!< Imaginary part */
+} complexQ15;
+
+/*!
+* @brief Q15 complex matrix, interleaved like complexMatrix: element (i, j) is dados[i * ld + j].
+*
+* The leading dimension is rounded up to 16 elements (64 bytes), so every row starts on a cache line.
+*/
+typedef struct
+{
+    int linhas, colunas; /*!< Fields to store the number of rows and columns */
+    int ld;              /*!< Leading dimension, in elements */
+    complexQ15 *dados;   /*!< Elements, row after row */
+    void *bloco;         /*!< Block owned by the matrix (NULL for views) */
+} complexMatrixQ15;
+
+/*!
+* @brief Element (i, j) of a complexMatrixQ15.
+*/
+#define Q15_ELEM(matrix, i, j) ((matrix).dados[(size_t)(i) * (matrix).ld + (j)])
+
+/*!
+* @brief 1/sqrt(2) in Q15: the coordinate of the unit-power 4-QAM points.
+*/
+#define Q15_RAIZ_MEIO 23170
+
+///****************************************** SCALAR ARITHMETIC ****************************************************/
+///
+///-----> Every result saturates to [-32768, 32767] instead of wrapping. The vector kernels of ponto_fixo.c
+///-----> produce exactly the same bits as these functions, so they double as the reference model.
+///
+
+/**
+ * @brief Saturates a 32-bit value to Q15.
+ */
+static inline q15 q15Satura(int32_t x)
+{
+    return (q15)(x > INT16_MAX ? INT16_MAX : (x < INT16_MIN ? INT16_MIN : x));
+}
+
+/**
+ * @brief Rounded Q15 product (x * y + 2^14) >> 15, as pmulhrsw, but (-1) * (-1) saturates to 32767.
+ */
+static inline q15 q15Mul(q15 x, q15 y)
+{
+    return q15Satura(((int32_t)x * y + 0x4000) >> 15);
+}
+
+/**
+ * @brief Saturating complex sum.
+ */
+static inline complexQ15 q15Soma(complexQ15 a, complexQ15 b)
+{
+    complexQ15 c = {q15Satura((int32_t)a.Re + b.Re), q15Satura((int32_t)a.Im + b.Im)};
+    return c;
+}
+
+/**
+ * @brief Saturating complex difference.
+ */
+static inline complexQ15 q15Subtracao(complexQ15 a, complexQ15 b)
+{
+    complexQ15 c = {q15Satura((int32_t)a.Re - b.Re), q15Satura((int32_t)a.Im - b.Im)};
+    return c;
+}
+
+/**
+ * @brief Complex product: each partial product is rounded to Q15 and the two are combined with saturation.
+ */
+static inline complexQ15 q15Produto(complexQ15 a, complexQ15 b)
+{
+    complexQ15 c = {q15Satura((int32_t)q15Mul(a.Re, b.Re) - q15Mul(a.Im, b.Im)),
+                    q15Satura((int32_t)q15Mul(a.Im, b.Re) + q15Mul(a.Re, b.Im))};
+    return c;
+}
+
+///****************************************** ALLOCATION AND CONVERSION ****************************************************/
+
+/**
+ * @brief Allocates a Q15 complex matrix in a single aligned block.
+ *
+ * If the allocation fails, an error message is printed and the program terminates.
+ *
+ * @param linhas Number of rows.
+ * @param colunas Number of columns.
+ * @return The allocated complexMatrixQ15.
+ */
+complexMatrixQ15 allocateComplexMatrixQ15(int linhas, int colunas);
+
+/**
+ * @brief Frees the memory owned by a Q15 complex matrix.
+ *
+ * @param matrix The complexMatrixQ15 object to be freed.
+ */
+void freeComplexMatrixQ15(complexMatrixQ15 matrix);
+
+/**
+ * @brief Quantizes a float matrix: each part becomes round(x * escala * 32768), saturated.
+ *
+ * Rounding is to nearest, ties to even. 'escala' gives the headroom: for example 4-QAM points at
+ * +-1 need escala <= 1 / sqrt(2) to stay clear of saturation.
+ *
+ * @param destino The Q15 matrix that receives the elements (same shape as origem).
+ * @param origem The float complexMatrix.
+ * @param escala Factor applied before quantization.
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int matrixParaQ15(complexMatrixQ15 destino, complexMatrix origem, float escala);
+
+/**
+ * @brief Converts a Q15 matrix back to float, undoing the factor used by matrixParaQ15.
+ *
+ * @param destino The float complexMatrix that receives the elements (same shape as origem).
+ * @param origem The Q15 matrix.
+ * @param escala The factor given to matrixParaQ15.
+ * @return 0 on success, -1 if the dimensions do not agree.
+ */
+int q15ParaMatrix(complexMatrix destino, complexMatrixQ15 origem, float escala);
+
+///****************************************** OPERATIONS ****************************************************/
+///
+///-----> Same conventions as the *Em functions of matrizes.h: the result goes to 'destino',
+///-----> 0 is returned on success and -1 when the dimensions do not agree.
+///
+
+/**
+ * @brief Writes matrix1 + matrix2 into destino, with saturation (destino may be an operand).
+ */
+int q15SomaEm(complexMatrixQ15 destino, complexMatrixQ15 matrix1, complexMatrixQ15 matrix2);
+
+/**
+ * @brief Writes matrix1 - matrix2 into destino, with saturation (destino may be an operand).
+ */
+int q15SubtracaoEm(complexMatrixQ15 destino, complexMatrixQ15 matrix1, complexMatrixQ15 matrix2);
+
+/**
+ * @brief Writes the element-wise product of matrix1 and matrix2 into destino (destino may be an operand).
+ */
+int q15ProdutoElementosEm(complexMatrixQ15 destino, complexMatrixQ15 matrix1, complexMatrixQ15 matrix2);
+
+/**
+ * @brief Writes the conjugate transpose of matrix into destino; destino must not overlap matrix.
+ *
+ * Conjugating -32768 saturates to 32767.
+ */
+int q15HermitianaEm(complexMatrixQ15 destino, complexMatrixQ15 matrix);
+
+/**
+ * @brief Writes matrix1 * matrix2 into destino; destino must not overlap the operands.
+ *
+ * Each term is the Q15 product of q15Produto; the terms are accumulated in 32 bits (guard bits, as
+ * in a DSP accumulator) and the sum is saturated to Q15 once at the end.
+ */
+int q15ProdutoEm(complexMatrixQ15 destino, complexMatrixQ15 matrix1, complexMatrixQ15 matrix2);
+
+///****************************************** TESTS ****************************************************/
+
+/**
+ * @brief Checks q15ProdutoEm, q15ProdutoElementosEm, q15SomaEm and q15SubtracaoEm bit for bit against the
+ * scalar reference model above, on inputs that include -32768 and 32767 and on column counts that are
+ * and are not multiples of 8.
+ *
+ * Prints one OK/FALHOU line per check.
+ *
+ * @return The number of failed checks.
+ */
+int teste_ponto_fixo(void);
+
+#endif
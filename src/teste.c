@@ -0,0 +1,111 @@
+/**
+ * @file teste.c
+ * @brief Implementation file for the helpers shared by the self-tests of the modules.
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <math.h>
+
+/// including the files where the structures are contained
+#include "teste.h"
+#include "matrizes.h"
+
+/**
+ * @param[in,out] estado The xorshift32 state
+ *
+ * @brief One step of Marsaglia's xorshift32: cheap, deterministic and the same on every platform.
+ *
+ * @return The new state.
+ */
+uint32_t testeSorteia(uint32_t *estado)
+{
+    uint32_t x = *estado;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *estado = x;
+
+    return x;
+}
+
+/**
+ * @param[out] matrix The matrix to be filled
+ * @param[in] semente The seed
+ *
+ * @brief Fills the matrix row by row with uniform values in (-1, 1) taken from the top 24 bits of xorshift32.
+ */
+void testePreenche(complexMatrix matrix, unsigned semente)
+{
+    uint32_t estado = 2463534242u ^ (semente * 2654435761u);
+
+    for (int i = 0; i < matrix.linhas; i++)
+    {
+        for (int j = 0; j < matrix.colunas; j++)
+        {
+            MATRIX_ELEM(matrix, i, j).Re = (float)(testeSorteia(&estado) >> 8) / 8388608.0f - 1.0f;
+            MATRIX_ELEM(matrix, i, j).Im = (float)(testeSorteia(&estado) >> 8) / 8388608.0f - 1.0f;
+        }
+    }
+}
+
+/**
+ * @param[in] a The first matrix
+ * @param[in] b The second matrix, with the shape of a
+ *
+ * @brief Largest absolute difference between the real or imaginary parts of a and b.
+ *
+ * @return The difference (NaN propagates, so a NaN never passes a tolerance check).
+ */
+float testeDiferenca(complexMatrix a, complexMatrix b)
+{
+    float maxima = 0.0f;
+
+    for (int i = 0; i < a.linhas; i++)
+    {
+        for (int j = 0; j < a.colunas; j++)
+        {
+            const float re = fabsf(MATRIX_ELEM(a, i, j).Re - MATRIX_ELEM(b, i, j).Re);
+            const float im = fabsf(MATRIX_ELEM(a, i, j).Im - MATRIX_ELEM(b, i, j).Im);
+
+            if (isnan(re) || isnan(im))
+            {
+                return NAN;
+            }
+
+            maxima = fmaxf(maxima, fmaxf(re, im));
+        }
+    }
+
+    return maxima;
+}
+
+/**
+ * @param[in] nome Name of the check
+ * @param[in] ok Nonzero if the check passed
+ * @param[in] formato Format of the details, followed by its arguments (NULL for no details)
+ *
+ * @brief Prints one line of a self-test in the common layout of the teste_* functions.
+ *
+ * @return 1 if the check failed, 0 otherwise.
+ */
+int testeConfere(const char *nome, int ok, const char *formato, ...)
+{
+    if (formato == NULL)
+    {
+        printf("%-44s %s\n", nome, ok ? "OK" : "FALHOU");
+    }
+    else
+    {
+        va_list argumentos;
+
+        va_start(argumentos, formato);
+        printf("%-44s %-7s (", nome, ok ? "OK" : "FALHOU");
+        vprintf(formato, argumentos);
+        printf(")\n");
+        va_end(argumentos);
+    }
+
+    return !ok;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file teste.h
+ * @brief Header file for the helpers shared by the self-tests of the modules (teste_* functions).
+ */
+
+#ifndef TESTE_H
+#define TESTE_H
+#include <stdint.h>
+#include "matrizes.h"
+
+/**
+ * @brief Advances a xorshift32 state and returns its new value.
+ *
+ * @param estado The state (must not be zero).
+ * @return The next 32-bit value of the sequence.
+ */
+uint32_t testeSorteia(uint32_t *estado);
+
+/**
+ * @brief Fills a matrix (or a view) with deterministic values in (-1, 1) that depend only on 'semente'.
+ *
+ * @param matrix The matrix to be filled.
+ * @param semente Selects the sequence; different seeds give unrelated matrices.
+ */
+void testePreenche(complexMatrix matrix, unsigned semente);
+
+/**
+ * @brief Largest element-wise difference between the real or imaginary parts of two matrices of the same shape.
+ *
+ * @return The difference, or NaN if any of the compared values is NaN.
+ */
+float testeDiferenca(complexMatrix a, complexMatrix b);
+
+/**
+ * @brief Prints one check as "name OK|FALHOU (details)" and returns 1 if it failed.
+ *
+ * @param nome Name of the check.
+ * @param ok Nonzero if the check passed.
+ * @param formato printf format of the details printed between parentheses, or NULL for none.
+ * @return 0 if the check passed, 1 otherwise, so the results can be summed into a failure count.
+ */
+int testeConfere(const char *nome, int ok, const char *formato, ...);
+
+#endif